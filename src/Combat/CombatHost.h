@@ -0,0 +1,21 @@
+#ifndef COMBATHOST_H
+#define COMBATHOST_H
+
+//The interface a battle runner implements so CombatPlayer can reach the inventory.
+//Calls go straight to the host object, nothing is type-erased or heap allocated.
+class CombatHost{
+public:
+    virtual ~CombatHost()=default;
+    //consume the best healing item, returns the amount healed (0 if none)
+    virtual int useHealingItem()=0;
+    //consume one ammo for the equipped weapon, returns 1 if the weapon can fire
+    virtual bool consumeAmmoForCurrentWeapon()=0;
+    //open the backpack to switch weapons
+    virtual void openWeaponMenu()=0;
+    //called every time the weapon bonus is applied
+    virtual void handleWeaponDurability()=0;
+    //spread an area attack to the other enemies of a wave, damage is per enemy
+    virtual void applyAreaDamage(int damage)=0;
+};
+
+#endif
@@ -1,5 +1,5 @@
 #include "CombatPlayer.h"
-#include "../Core/InputSystem.h"
+#include "../Core/UISystem.h"
 #include "utils.h"
 #include<iostream>
 #include<memory>
@@ -10,17 +10,14 @@ using namespace std;
 CombatPlayer::CombatPlayer(const string &name)
 :Character(name,100),harmony(5),combo(0),extraTurns(0),
  weaponBonusDamage(0),equippedWeaponName("Bare Hands"),
- weaponNeedsAmmo(false),weaponDurability(-1){
-    addRune(std::unique_ptr<Rune>(new Rune("Cure Rune",vector<Note>{DO,RE,DO},"Heal",20,GREEN)));
-    addRune(std::unique_ptr<Rune>(new Rune("Attack Rune",vector<Note>{MI,FA,MI},"Damage",25,RED)));
-    addRune(std::unique_ptr<Rune>(new Rune("Defense Rune",vector<Note>{SOL,LA,SOL},"Defense",15,BLUE)));
-    addNoteEffect(DO,std::unique_ptr<NoteEffect>(new NoteEffect("Heal","Recover small amount of health",8,GREEN)));
-    addNoteEffect(RE,std::unique_ptr<NoteEffect>(new NoteEffect("Power up","Recover resonance",10,BLUE)));
-    addNoteEffect(MI,std::unique_ptr<NoteEffect>(new NoteEffect("Attack","Damage the enemy",12,RED)));
-    addNoteEffect(FA,std::unique_ptr<NoteEffect>(new NoteEffect("Shield","aquire temper defense",5,CYAN)));
-    addNoteEffect(SOL,std::unique_ptr<NoteEffect>(new NoteEffect("Purge","Rurge and recover small amount of health",5,MAGENTA)));
-    addNoteEffect(LA,std::unique_ptr<NoteEffect>(new NoteEffect("Variation","Random effect",0,WHITE)));
-    addNoteEffect(SI,std::unique_ptr<NoteEffect>(new NoteEffect("Accumulation","Extra turns",0,WHITE)));
+ weaponNeedsAmmo(false),weaponDurability(-1),host(nullptr){
+    addRune(CURE_RUNE);
+    addRune(ATTACK_RUNE);
+    addRune(DEFENSE_RUNE);
+    for(int n=DO;n<=SI;n++){
+        Note note=static_cast<Note>(n);
+        addNoteEffect(note,&Registry::getPlayerNoteEffect(note));
+    }
 }
 
 // Configures weapon bonuses and properties for the combat player
@@ -36,29 +33,10 @@ void CombatPlayer::setWeaponBonus(int bonus, const std::string& weaponName, bool
     weaponDurability = durability;
 }
 
-// Sets callback function for consuming healing items during combat
-// func - Function pointer for healing item consumption
-void CombatPlayer::setHealingCallback(std::function<int()> func){
-    consumeHealingItemFunc = func;
-}
-
-// Sets callback function for ammunition consumption during combat
-// func - Function pointer for ammo consumption check
-void CombatPlayer::setAmmoCallback(std::function<bool()> func){
-    consumeAmmoCallback = func;
-}
-
-// Sets the callback function for opening backpack during combat
-// This enables backpack functionality integration into the combat phase
-// func - Function pointer/callback for backpack opening
-void CombatPlayer::setBackpackCallback(std::function<void()> func){
-    openBackpackCallback = func;
-}
-
-// Sets callback function for weapon usage tracking
-// func - Function pointer for weapon usage events
-void CombatPlayer::setWeaponUsageCallback(std::function<void()> func){
-    weaponUsageCallback = func;
+// Sets the battle runner that provides healing items, ammo, backpack and durability handling
+// combatHost - Object implementing CombatHost, nullptr to fight without an inventory
+void CombatPlayer::setHost(CombatHost *combatHost){
+    host = combatHost;
 }
 //increase harmony by 1
 void CombatPlayer::increaseHarmony(){
@@ -94,88 +72,88 @@ void CombatPlayer::useExtraTurn(){
 bool CombatPlayer::activateRune(Character &target){
     int activeRuneIndex=checkMelody();
     if(activeRuneIndex==-1)return 0;
-    const auto &activeRune=runes[activeRuneIndex];
-    cout<<BOLD<<activeRune->color<<" !Detecting active rune: "<<activeRune->name<<"! "<<RESET<<endl;
-    cout<<"Effect: "<<activeRune->effect<<endl;
-    cout<<YELLOW<<"Press "<<RED<<"[Space]"<<YELLOW<<" to activate rune, or press other keys to continue..."<<RESET<<endl;
-    while(1){
-        if(InputSystem::kbhit()){
-            char key=InputSystem::getch();
-            if(key==' '){
-                CombatPlayer::activeRune(activeRuneIndex,target);
-                return 1;
-            }
-            else {
-                InputSystem::waitForAnyKey();
-                break;
-            }
-        }
-        InputSystem::sleepMs(100);
+    const Rune &activeRune=getRune(activeRuneIndex);
+    UISystem::out()<<BOLD<<activeRune.color<<" !Detecting active rune: "<<activeRune.name<<"! "<<RESET<<endl;
+    UISystem::out()<<"Effect: "<<activeRune.effect<<endl;
+    UISystem::out()<<YELLOW<<"Press "<<RED<<"[Space]"<<YELLOW<<" to activate rune, or press other keys to continue..."<<RESET<<endl;
+    char key=InputSystem::readKey();
+    if(key==' '){
+        CombatPlayer::activeRune(activeRuneIndex,target);
+        return 1;
     }
+    InputSystem::waitForAnyKey();
     return 0;
 }
 
 //flow of player's turn, target represents the enemy
+//each redraw is composed into the frame buffer and written at once, only changed lines are sent
 //target - Reference to enemy Character being fought
 void CombatPlayer::takeTurn(Character &target){
     bool actionTaken = false;
+    //the enemy's turn drew its own screen, so the first frame is a full repaint
+    frame.invalidate();
     while(!actionTaken){
         //information display
-        InputSystem::clearScreen();
-        InputSystem::drawTitle("Your Turn");
-        cout<<endl<<"Your health:    "<<getHealthBar()<<endl;
-        cout<<"Enemy's health: "<<target.getHealthBar()<<endl<<endl;
-        cout<<endl;
-        cout<<"Resonance: "<<getResonanceBar();
-        cout<<" Harmony: "<<YELLOW<<harmony<<"/10"<<RESET;
-        cout<<" | Combo: "<<CYAN<<combo<<RESET;
+        frame.beginFrame();
+        frame.addLine(InputSystem::formatTitle("Your Turn"));
+        frame.addLine("");
+        frame.addLine()+="Your health:    "+getHealthBar();
+        frame.addLine()+="Enemy's health: "+target.getHealthBar();
+        frame.addLine("");
+        frame.addLine("");
+        std::string &status=frame.addLine();
+        status+="Resonance: "+getResonanceBar();
+        status+=" Harmony: ";
+        status+=YELLOW+to_string(harmony)+"/10"+RESET;
+        status+=" | Combo: ";
+        status+=CYAN+to_string(combo)+RESET;
         if(extraTurns>0){
-            cout<<" | extra turn: "<<GREEN<< extraTurns<<RESET;
+            status+=" | extra turn: ";
+            status+=GREEN+to_string(extraTurns)+RESET;
         }
-        cout<<endl<<"Weapon: "<<WHITE<<equippedWeaponName<<RESET;
+        std::string &weapon=frame.addLine();
+        weapon+="Weapon: ";
+        weapon+=WHITE+equippedWeaponName+RESET;
         if(weaponBonusDamage > 0){
-            cout<<" (+"<<weaponBonusDamage<<" dmg";
-            if(weaponNeedsAmmo) cout<<", uses ammo";
-            if(weaponDurability >= 0) cout<<", dur "<<weaponDurability;
-            cout<<")";
+            weapon+=" (+"+to_string(weaponBonusDamage)+" dmg";
+            if(weaponNeedsAmmo) weapon+=", uses ammo";
+            if(weaponDurability >= 0) weapon+=", dur "+to_string(weaponDurability);
+            weapon+=")";
         } else {
-            cout<<" (bare hands)";
+            weapon+=" (bare hands)";
         }
-        cout<<endl;
-        cout<<getMelodyDisplay()<<endl<<endl;
+        frame.addLine(getMelodyDisplay());
+        frame.addLine("");
         showNoteInputMenu();
+        frame.present();
         if(activateRune(target))return ;
         //wait for further input
-        cout<<YELLOW<<"Please select an operation to continue..."<<RESET<<endl;
-        bool inputHandled = false;
-        while(!inputHandled){
-            if(InputSystem::kbhit()){
-                char key=InputSystem::getch();
-                bool consumed = handleInput(key,target);
-                if(consumed){
-                    changeResonance(5);
-                    actionTaken = true;
-                }
-                inputHandled = true;
-            }
-            InputSystem::sleepMs(100);
+        UISystem::out()<<YELLOW<<"Please select an operation to continue..."<<RESET<<'\n'<<flush;
+        char key=InputSystem::readKey();
+        if(handleInput(key,target)){
+            changeResonance(5);
+            actionTaken = true;
         }
     }
 }
-//function for displaying the simplified effects of the notes
+//add the simplified effects of the notes to the frame
+//the menu never changes, so its lines are built once and reused for every frame
 void CombatPlayer::showNoteInputMenu(){
-    InputSystem::drawSeparator();
-    cout<<BOLD<<"Play note: "<<RESET<<endl;
-    //for instructions
-    cout<<" [1] DO  - "<<GREEN<<"Heal"<<RESET<<endl;
-    cout<<" [2] RE  - "<<BLUE<<"Power up"<<RESET<<endl;
-    cout<<" [3] MI  - "<<RED<<"Attack"<<RESET<<endl;
-    cout<<" [4] FA  - "<<CYAN<<"Shield"<<RESET<<endl;
-    cout<<" [5] SOL - "<<YELLOW<<"Purge"<<RESET<<endl;
-    cout<<" [6] LA  - "<<MAGENTA<<"Variation"<<RESET<<endl;
-    cout<<" [7] SI  - "<<WHITE<<"Extra turns"<<RESET<<endl;
-    cout<<" [B] Open backpack (switch weapon)"<<endl; // Display backpack option and allows accessing inventory during combat
-    cout<<endl;
+    static const std::vector<std::string> menu={
+        InputSystem::formatSeparator(),
+        BOLD+std::string("Play note: ")+RESET,
+        //for instructions
+        std::string(" [1] DO  - ")+GREEN+"Heal"+RESET,
+        std::string(" [2] RE  - ")+BLUE+"Power up"+RESET,
+        std::string(" [3] MI  - ")+RED+"Attack"+RESET,
+        std::string(" [4] FA  - ")+CYAN+"Shield"+RESET,
+        std::string(" [5] SOL - ")+YELLOW+"Purge"+RESET,
+        std::string(" [6] LA  - ")+MAGENTA+"Variation"+RESET,
+        std::string(" [7] SI  - ")+WHITE+"Extra turns"+RESET,
+        " [B] Open backpack (switch weapon)", // Display backpack option and allows accessing inventory during combat
+        ""
+    };
+    frame.addLines(menu);
 }
 //relate the keys to the effect functions
 //key: related key
@@ -215,21 +193,23 @@ bool CombatPlayer::handleInput(char key,Character &target){
         case 'b':
         case 'B':
             // Player can press 'B' to open backpack and switch weapons
-            if(openBackpackCallback){
-                openBackpackCallback();
+            if(host){
+                host->openWeaponMenu();
+                //the weapon menu cleared the screen
+                frame.invalidate();
             } else {
-                cout<<RED<<"Backpack unavailable."<<RESET<<endl;
+                UISystem::out()<<RED<<"Backpack unavailable."<<RESET<<endl;
                 InputSystem::waitForAnyKey();
             }
             return false;
         default:
-            cout<<RED<<"Invalid input! Please use 1-7 to play note"<<RESET<<endl;
+            UISystem::out()<<RED<<"Invalid input! Please use 1-7 to play note"<<RESET<<endl;
             notePlayed=0;
     }
     if(notePlayed){
         increaseCombo();
         if(combo%5==0){
-            cout<<BOLD<<CYAN<<"Combo "<<combo<<"! Resonance increased !"<<RESET<<endl;
+            UISystem::out()<<BOLD<<CYAN<<"Combo "<<combo<<"! Resonance increased !"<<RESET<<endl;
             changeResonance(combo);
         }
         activateRune(target);
@@ -237,14 +217,7 @@ bool CombatPlayer::handleInput(char key,Character &target){
         return true;
     }
     if(key!='b' && key!='B'){
-        while(1){
-            if(InputSystem::kbhit()){
-                char key=InputSystem::getch();
-                handleInput(key,target);
-                break;
-            }
-            InputSystem::sleepMs(100);
-        }
+        handleInput(InputSystem::readKey(),target);
     }
     return false;
 }
@@ -254,57 +227,57 @@ bool CombatPlayer::handleInput(char key,Character &target){
 void CombatPlayer::applyNoteEffect(Note note,Character &target){
     const NoteEffect *effect=getNoteEffect(note);
     if(!effect)return ;
-    cout<<BOLD<<effect->color<<effect->name<<"!"<<RESET<<endl;
+    UISystem::out()<<BOLD<<effect->color<<effect->name<<"!"<<RESET<<endl;
     switch(note){
         case DO:
             {
-            int itemHeal = consumeHealingItemFunc ? consumeHealingItemFunc() : 0;
+            int itemHeal = host ? host->useHealingItem() : 0;
             if(itemHeal <= 0){
-                cout<<RED<<"No medical supplies available! Heal failed."<<RESET<<endl;
+                UISystem::out()<<RED<<"No medical supplies available! Heal failed."<<RESET<<endl;
                 break;
             }
             int healAmount=itemHeal;
             heal(healAmount);
-            cout<<GREEN<<"Used medical supplies to recover "<<healAmount<<" HP"<<RESET<<endl;
+            UISystem::out()<<GREEN<<"Used medical supplies to recover "<<healAmount<<" HP"<<RESET<<endl;
             break;}
         case RE:
             {int resonanceAmount=effect->power+(combo/2);
             changeResonance(resonanceAmount);
-            cout<<BLUE<<"Recovered "<<resonanceAmount<<" points of resonance"<<RESET<<endl;
+            UISystem::out()<<BLUE<<"Recovered "<<resonanceAmount<<" points of resonance"<<RESET<<endl;
             break;}
         case MI:
             {int weaponBonus = getWeaponBonusDamage();
             int damage=effect->power+harmony+weaponBonus;
             target.takeDamage(damage);
-            cout<<RED<<target.getName()<<" got "<<damage<<" points of damage"<<RESET<<endl;
-            if(weaponBonus > 0 && weaponUsageCallback){
-                weaponUsageCallback();
+            UISystem::out()<<RED<<target.getName()<<" got "<<damage<<" points of damage"<<RESET<<endl;
+            if(weaponBonus > 0 && host){
+                host->handleWeaponDurability();
             }
             break;}
         case FA:
             {int defenseAmount=effect->power+(harmony/2);
             setDefense(getDefense()+defenseAmount);
-            cout<<CYAN<<"Aquired "<<defenseAmount<<" points of defense"<<RESET<<endl;
+            UISystem::out()<<CYAN<<"Aquired "<<defenseAmount<<" points of defense"<<RESET<<endl;
             break;}
         case SOL:
             {if(getDefense()<0)setDefense(0);
             int healAmount=effect->power;
             heal(healAmount);
-            cout<<MAGENTA<<"Negative effects Purged. Recovered "<<healAmount<<" points of health"<<RESET<<endl;
+            UISystem::out()<<MAGENTA<<"Negative effects Purged. Recovered "<<healAmount<<" points of health"<<RESET<<endl;
             break;}
         case LA:
             {Note randomNote=static_cast<Note>(Utils::randomInt(1,6));
-            cout<<WHITE<<"Random notes applied"<<RESET<<endl;
+            UISystem::out()<<WHITE<<"Random notes applied"<<RESET<<endl;
             applyNoteEffect(randomNote,target);
             break;}
         case SI:
             {if(resonance>=30){
                     changeResonance(-30);
                     extraTurns+=2;
-                    cout<<WHITE<<"Aquire extra turns"<<RESET<<endl;
+                    UISystem::out()<<WHITE<<"Aquire extra turns"<<RESET<<endl;
                 }
                 else {
-                    cout<<RED<<"Not enough resonance! 30 resonance needed"<<RESET<<endl;
+                    UISystem::out()<<RED<<"Not enough resonance! 30 resonance needed"<<RESET<<endl;
                     // InputSystem::waitForAnyKey();
                 }
                 
@@ -318,22 +291,28 @@ void CombatPlayer::applyNoteEffect(Note note,Character &target){
 //target: to the enemy
 void CombatPlayer::applyRuneEffect(const Rune &rune,Character &target){
     int effectPower=rune.power+(harmony*2)+(combo/2);
-    cout<<BOLD<<rune.color<<"\n"<<rune.name<<" activated"<<RESET<<endl;
-    if(rune.name=="Cure Rune"){
-        heal(effectPower);
-        cout<<GREEN<<effectPower<<" healed"<<RESET<<endl;
-    }
-    else if(rune.name=="Attack Rune"){
-        int totalDamage = effectPower + getWeaponBonusDamage();
-        target.takeDamage(totalDamage);
-        cout<<RED<<target.getName()<<" took "<<totalDamage<<" points of damage"<<RESET<<endl;
-        if(totalDamage > effectPower && weaponUsageCallback){
-            weaponUsageCallback();
-        }
-    }
-    else if(rune.name=="Defense Rune"){
-        setDefense(getDefense()+effectPower);
-        cout<<BLUE<<"Aquired "<<effectPower<<" points of defense"<<RESET<<endl;
+    UISystem::out()<<BOLD<<rune.color<<"\n"<<rune.name<<" activated"<<RESET<<endl;
+    switch(rune.id){
+        case CURE_RUNE:
+            heal(effectPower);
+            UISystem::out()<<GREEN<<effectPower<<" healed"<<RESET<<endl;
+            break;
+        case ATTACK_RUNE:
+            {int totalDamage = effectPower + getWeaponBonusDamage();
+            target.takeDamage(totalDamage);
+            UISystem::out()<<RED<<target.getName()<<" took "<<totalDamage<<" points of damage"<<RESET<<endl;
+            if(totalDamage > effectPower && host){
+                host->handleWeaponDurability();
+            }
+            //the attack rune is an area effect when fighting a wave
+            if(host)host->applyAreaDamage(totalDamage);
+            break;}
+        case DEFENSE_RUNE:
+            setDefense(getDefense()+effectPower);
+            UISystem::out()<<BLUE<<"Aquired "<<effectPower<<" points of defense"<<RESET<<endl;
+            break;
+        default:
+            break;
     }
     resetCombo();
     // InputSystem::waitForAnyKey();
@@ -342,15 +321,15 @@ void CombatPlayer::applyRuneEffect(const Rune &rune,Character &target){
 //runeIndex: the index of applied rune
 //target: the target the rune is applied on
 void CombatPlayer::activeRune(int runeIndex,Character &target){
-    const auto &rune=runes[runeIndex];
+    const Rune &rune=getRune(runeIndex);
     if(resonance>=15){
         changeResonance(-15);
-        applyRuneEffect(*rune,target);
+        applyRuneEffect(rune,target);
         clearMelody();//
         increaseHarmony();
     }
     else {
-        cout<<RED<<"Not enough resonance! 15 resonance needed"<<RESET<<endl;
+        UISystem::out()<<RED<<"Not enough resonance! 15 resonance needed"<<RESET<<endl;
         InputSystem::waitForAnyKey();
     }
 }
@@ -358,12 +337,63 @@ void CombatPlayer::activeRune(int runeIndex,Character &target){
 void CombatPlayer::resetTurn(){
     defense=0;
 }
+//reset health, resonance, harmony and combo before a new encounter
+void CombatPlayer::resetEncounter(){
+    resetState();
+    harmony=5;
+    combo=0;
+    extraTurns=0;
+    frame.invalidate();
+}
 //return the amount of Weapon Bonus Damage
 int CombatPlayer::getWeaponBonusDamage(){
     if(weaponBonusDamage <= 0) return 0;
     if(!weaponNeedsAmmo) return weaponBonusDamage;
-    if(consumeAmmoCallback){
-        return consumeAmmoCallback() ? weaponBonusDamage : 0;
+    if(host){
+        return host->consumeAmmoForCurrentWeapon() ? weaponBonusDamage : 0;
     }
     return 0;
 }
+//copy the player's combat state for saving
+CombatPlayerState CombatPlayer::getState()const{
+    CombatPlayerState state;
+    state.health=health;
+    state.maxHealth=maxHealth;
+    state.resonance=resonance;
+    state.defense=defense;
+    for(int i=0;i<runeCount;i++)state.runes.push_back(runeIds[i]);
+    for(Note note:melody)state.melody.push_back(note);
+    state.harmony=harmony;
+    state.combo=combo;
+    state.extraTurns=extraTurns;
+    state.weaponBonusDamage=weaponBonusDamage;
+    state.weaponName=equippedWeaponName;
+    state.weaponNeedsAmmo=weaponNeedsAmmo;
+    state.weaponDurability=weaponDurability;
+    return state;
+}
+//whether a saved combat state can be restored: runes and notes in range, room for the runes
+bool CombatPlayer::isValidState(const CombatPlayerState &state){
+    if(state.runes.size()>static_cast<size_t>(MAX_CHARACTER_RUNES)||state.maxHealth<=0)return false;
+    for(int rune:state.runes)if(rune<0||rune>=RUNE_COUNT)return false;
+    for(int note:state.melody)if(note<DO||note>SI)return false;
+    return true;
+}
+//restore a saved combat state; false (nothing changed) if it is not valid
+bool CombatPlayer::restoreState(const CombatPlayerState &state){
+    if(!isValidState(state))return false;
+    health=state.health;
+    maxHealth=state.maxHealth;
+    resonance=state.resonance;
+    defense=state.defense;
+    runeCount=0;
+    for(int rune:state.runes)addRune(static_cast<RuneId>(rune));
+    melody.clear();
+    for(int note:state.melody)melody.push_back(static_cast<Note>(note));
+    harmony=state.harmony;
+    combo=state.combo;
+    extraTurns=state.extraTurns;
+    setWeaponBonus(state.weaponBonusDamage,state.weaponName,state.weaponNeedsAmmo,state.weaponDurability);
+    frame.invalidate();
+    return true;
+}
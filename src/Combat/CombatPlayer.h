@@ -2,7 +2,25 @@
 #define COMBATPLAYER_H
 
 #include "character.h"
-#include <functional>
+#include "CombatHost.h"
+#include "../Core/FrameBuffer.h"
+
+//everything a save needs to rebuild the combat player
+struct CombatPlayerState{
+    int health;
+    int maxHealth;
+    int resonance;
+    int defense;
+    std::vector<int> runes;     //RuneId values
+    std::vector<int> melody;    //Note values
+    int harmony;
+    int combo;
+    int extraTurns;
+    int weaponBonusDamage;
+    std::string weaponName;
+    bool weaponNeedsAmmo;
+    int weaponDurability;
+};
 
 class CombatPlayer:public Character{
 private:
@@ -13,10 +31,8 @@ private:
     std::string equippedWeaponName;
     bool weaponNeedsAmmo;
     int weaponDurability;
-    std::function<int()> consumeHealingItemFunc;
-    std::function<bool()> consumeAmmoCallback;
-    std::function<void()> openBackpackCallback;
-    std::function<void()> weaponUsageCallback;
+    CombatHost *host;
+    FrameBuffer frame;
     bool handleInput(char key,Character &target);
     int getWeaponBonusDamage();
     void activeRune(int runeIndex,Character &target);
@@ -27,10 +43,7 @@ private:
 public:
     CombatPlayer(const string &name);
     void setWeaponBonus(int bonus, const std::string& weaponName, bool needsAmmo = false, int durability = -1);
-    void setHealingCallback(std::function<int()> func);
-    void setAmmoCallback(std::function<bool()> func);
-    void setBackpackCallback(std::function<void()> func);
-    void setWeaponUsageCallback(std::function<void()> func);
+    void setHost(CombatHost *combatHost);
     void increaseHarmony();
     void increaseCombo();
     void resetCombo();
@@ -40,7 +53,11 @@ public:
     void useExtraTurn();
     void takeTurn(Character &target);
     void resetTurn();
+    void resetEncounter();
     bool activateRune(Character &target);
+    CombatPlayerState getState()const;
+    bool restoreState(const CombatPlayerState &state);
+    static bool isValidState(const CombatPlayerState &state);
 };
 
 #endif
\ No newline at end of file
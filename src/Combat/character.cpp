@@ -1,4 +1,5 @@
 #include "character.h"
+#include "../Core/UISystem.h"
 #include<iostream>
 #include<algorithm>
 #include<string>
@@ -31,26 +32,24 @@ void Character::changeResonance(int amount){
 void Character::setDefense(int def){
     defense=def;
 }
-//adding the rune for saving
-//rune: the rune applied
-void Character::addRune(unique_ptr<Rune> rune){
-    runes.push_back(move(rune));
+//give the character the registered rune "id"
+//id: the rune added, ignored when the character already knows MAX_CHARACTER_RUNES runes
+void Character::addRune(RuneId id){
+    if(runeCount<MAX_CHARACTER_RUNES)runeIds[runeCount++]=id;
 }
-//return the vector containing the runes
-const vector<unique_ptr<Rune>>& Character::getRunes()const{
-    return runes;
+//return the number of runes the character knows
+int Character::getRuneCount()const{
+    return runeCount;
+}
+//return the definition of the "index"-th rune of the character
+const Rune &Character::getRune(int index)const{
+    return Registry::getRune(runeIds[index]);
 }
 //match "note" with its corresponding "effect"
 //note: certain note
-//effect: word description of effect
-void Character::addNoteEffect(Note note,unique_ptr<NoteEffect> effect){
-    noteEffect[note]=move(effect);
-}
-//find and return the effect of the inputed "note"
-//note: note needed to find
-const NoteEffect* Character::getNoteEffect(Note note)const{
-    auto it=noteEffect.find(note);
-    return (it!=noteEffect.end())?it->second.get():nullptr;
+//effect: registered effect of the note
+void Character::addNoteEffect(Note note,const NoteEffect *effect){
+    noteEffect[note]=effect;
 }
 //add the "note" to melody for display
 //note: the node added
@@ -70,15 +69,23 @@ const vector<Note> &Character::getMelody()const{
 bool Character::isAlive()const{
     return health>0;
 }
+//restore health, resonance and defense, and forget the melody
+//used when a pooled character is reused for a new encounter
+void Character::resetState(){
+    health=maxHealth;
+    resonance=50;
+    defense=0;
+    melody.clear();
+}
 //check if any melody matches the rune
 //returns the index of the available rune
 int Character::checkMelody(){
-    for(int i=0;i<(int)runes.size();i++){
-        const auto &rune=runes[i];
-        if(melody.size()<rune->sequence.size())continue;
+    for(int i=0;i<runeCount;i++){
+        const Rune &rune=getRune(i);
+        if((int)melody.size()<rune.length)continue;
         bool match=1;
-        for(int j=0;j<(int)rune->sequence.size();j++){
-            if(melody[melody.size()-rune->sequence.size()+j]!=rune->sequence[j]){
+        for(int j=0;j<rune.length;j++){
+            if(melody[melody.size()-rune.length+j]!=rune.sequence[j]){
                 match=0;
                 break;
             }
@@ -119,7 +126,7 @@ string Character::getMelodyDisplay()const{
 void Character::applyNoteEffect(Note note,Character &target){
     const NoteEffect *effect=getNoteEffect(note);
     if(effect){
-        cout<<BOLD<<effect->color<<" "<<effect->name<<"!"<<RESET<<endl;
-        cout<<effect->description<<endl;
+        UISystem::out()<<BOLD<<effect->color<<" "<<effect->name<<"!"<<RESET<<endl;
+        UISystem::out()<<effect->description<<endl;
     }
 }
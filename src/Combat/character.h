@@ -2,30 +2,12 @@
 #define CHARACTER_H
 
 #include "utils.h"
+#include "registry.h"
 #include <string>
 #include <vector>
-#include <memory>
-#include <map>
 
 using namespace std;
 
-struct NoteEffect {
-    string name;
-    string description;
-    int power;
-    string color;
-    NoteEffect(const string &n,const string &desc,int p,const string &c):name(n),description(desc),power(p),color(c){}
-};
-
-struct Rune {
-    string name;
-    vector<Note> sequence;
-    string effect;
-    int power;
-    string color;
-    Rune(const string &n,const vector<Note> &seq,const string &e,int p,const string &c):name(n),sequence(seq),effect(e),power(p),color(c){}
-};
-
 class Character {
 protected:
     string name;
@@ -33,11 +15,14 @@ protected:
     int maxHealth;
     int resonance;
     int defense;
-    vector<unique_ptr<Rune>> runes;
+    //ids into the shared rune registry
+    RuneId runeIds[MAX_CHARACTER_RUNES];
+    int runeCount;
     vector<Note> melody;
-    map<Note,unique_ptr<NoteEffect>> noteEffect;
+    //indexed by Note, entries point into the shared registry
+    const NoteEffect *noteEffect[SI+1];
 public:
-    Character(const string &n,int h):name(n),health(h),maxHealth(h),resonance(50),defense(0){}
+    Character(const string &n,int h):name(n),health(h),maxHealth(h),resonance(50),defense(0),runeCount(0),noteEffect(){}
     virtual ~Character()=default;
     Character(const Character&)=delete;
     Character &operator=(const Character&)=delete;
@@ -52,15 +37,18 @@ public:
     void heal(int amount);
     void changeResonance(int amount);
     void setDefense(int def);
-    void addRune(unique_ptr<Rune> rune);
-    const vector<unique_ptr<Rune>>& getRunes()const;
-    void addNoteEffect(Note note,unique_ptr<NoteEffect> effect);
-    const NoteEffect *getNoteEffect(Note note)const;
+    void addRune(RuneId id);
+    int getRuneCount()const;
+    const Rune &getRune(int index)const;
+    void addNoteEffect(Note note,const NoteEffect *effect);
+    //note must be a valid Note (DO..SI)
+    const NoteEffect *getNoteEffect(Note note)const{return noteEffect[note];}
     void addNoteToMelody(Note note);
     void clearMelody();
     const vector<Note>& getMelody()const;
     void takeTurn(Character &target);
     bool isAlive()const;
+    void resetState();
     //check if the melody suits the rune
     int checkMelody();
     string getHealthBar()const;
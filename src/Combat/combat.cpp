@@ -1,48 +1,70 @@
 #include "combat.h"
-#include "../Core/InputSystem.h"
+#include "../Core/UISystem.h"
 #include "../Player/Player.h"
 #include "../Item/item.h"
+#include "utils.h"
 #include<iostream>
 #include<memory>
-#include<cstdlib>
-#include<ctime>
 using namespace std;
 
 // Constructor: Initializes combat system with player and enemies
-// Sets up combat player, weapons, enemies, and input system
+// Sets up combat player, weapons and the enemy pool. One Combat is built per session
+// and reused for every encounter through prepareEncounter().
 // owner - Pointer to Player object
 // ply - Player name string
 // startingWeapon - Initial weapon for combat
 // Outputs: None (constructor)
 Combat::Combat(Player* owner, const string &ply, Item* startingWeapon)
-:currentEnemyIndex(0),score(0),playerRef(owner){
-    srand(time(0));
+:playerRef(owner),currentEnemyIndex(0),score(0),waveActive(false),waveTarget(-1){
     player.reset(new CombatPlayer(ply));
     setCurrentWeapon(startingWeapon);
-    player->setHealingCallback([this]() { return useHealingItem(); });
-    player->setAmmoCallback([this]() { return consumeAmmoForCurrentWeapon(); });
-    player->setBackpackCallback([this]() { openWeaponMenu(); });
-    player->setWeaponUsageCallback([this]() { handleWeaponDurability(); });
+    player->setHost(this);
     enemies.push_back(std::unique_ptr<Enemy>(new Enemy("Noise Monster","Rhythm Breaker",60)));
     enemies.push_back(std::unique_ptr<Enemy>(new Enemy("Melody Thief","Melody Thief",70)));
     enemies.push_back(std::unique_ptr<Enemy>(new Enemy("Harmony Monster","Harmony Monster",100)));
     enemies.push_back(std::unique_ptr<Enemy>(new Enemy("Final Symphony","Rhythm Breaker",120)));
-    InputSystem::setNonBlockingInput();
+    //what each archetype's rune does to the player when it acts as part of a wave
+    for(const auto &enemy:enemies){
+        int damage=0,drain=0;
+        if(enemy->getRuneCount()>0){
+            const Rune &rune=enemy->getRune(0);
+            switch(rune.id){
+                case NOISE_RUNE:damage=rune.power;drain=10;break;
+                case THEFT_RUNE:drain=15;break;
+                default:damage=rune.power;break;
+            }
+        }
+        waveRuneDamage.push_back(damage);
+        waveRuneDrain.push_back(drain);
+    }
+    wave.reserve(16);
 }
 
 
-// What it does: Returns terminal to original state after combat
+// What it does: Nothing to release beyond the owned player and enemies
 Combat::~Combat(){
-    InputSystem::restoreTerminal();
+}
+
+// Resets the pooled combat state for a new encounter
+// What it does: Restores the combat player and equips the given weapon without allocating
+// Inputs: weaponPtr - Weapon to fight with, nullptr for bare hands
+void Combat::prepareEncounter(Item* weaponPtr){
+    player->resetEncounter();
+    setCurrentWeapon(weaponPtr);
 }
 
 // What it does: Runs combat loop with turn-based mechanics against specified enemy
 // Inputs: enemyIndex - Index of enemy to fight
 void Combat::fightEnemy(int enemyIndex){
+    if(enemyIndex<0)enemyIndex=0;
+    if(enemyIndex>=static_cast<int>(enemies.size()))enemyIndex=static_cast<int>(enemies.size())-1;
+    currentEnemyIndex=enemyIndex;
     Enemy &enemy=*enemies[enemyIndex];
+    //the enemy comes from the pool and may have fought before
+    enemy.resetEncounter();
     //show the name of encountered enemy
     InputSystem::clearScreen();
-    cout<<BOLD<<"\nYour encountered "<<RED<<enemy.getName()<<"!"<<RESET<<endl;
+    UISystem::out()<<BOLD<<"\nYour encountered "<<RED<<enemy.getName()<<"!"<<RESET<<endl;
     showRuneIntro();
     InputSystem::sleepMs(3000);
     //start the turns
@@ -52,7 +74,7 @@ void Combat::fightEnemy(int enemyIndex){
         if(!enemy.isAlive())break;
         while(player->hasExtraTurns()&&enemy.isAlive()){
             player->useExtraTurn();
-            cout<<BOLD<<GREEN<<"\n Extra turns!"<<RESET<<endl;
+            UISystem::out()<<BOLD<<GREEN<<"\n Extra turns!"<<RESET<<endl;
             
             player->takeTurn(enemy);
             if(!enemy.isAlive())break;
@@ -61,14 +83,96 @@ void Combat::fightEnemy(int enemyIndex){
         enemy.resetTurn();
         enemy.takeTurn(*player);
     }
+    showEncounterResult(calculateReward(enemyIndex));
+}
+
+// What it does: Runs combat against several enemies at once. The wave state lives in
+//               EnemyWave; the player fights the first living enemy through its pooled
+//               Enemy, area attacks hit the whole wave and the enemies act as one batch.
+// Inputs: archetypes - Index in the enemy pool of each member of the wave
+void Combat::fightWave(const vector<int> &archetypes){
+    wave.clear();
+    int rewardTotal=0;
+    for(int archetype:archetypes){
+        if(archetype<0||archetype>=static_cast<int>(enemies.size()))continue;
+        wave.add(archetype,enemies[archetype]->getMaxHealth());
+        rewardTotal+=calculateReward(archetype);
+    }
+    if(wave.size()==0)return;
+
+    InputSystem::clearScreen();
+    UISystem::out()<<BOLD<<"\nA wave of "<<RED<<wave.size()<<" enemies"<<RESET<<BOLD<<" surrounds you!"<<RESET<<endl;
+    showRuneIntro();
+    UISystem::out()<<YELLOW<<"The Attack Rune hits every enemy of the wave."<<RESET<<endl;
+    InputSystem::sleepMs(3000);
+
+    waveActive=true;
+    while(player->isAlive()&&wave.aliveCount()>0){
+        //the first living member is loaded into its pooled Enemy and fought directly
+        waveTarget=wave.firstAlive();
+        Enemy &enemy=*enemies[wave.archetype[waveTarget]];
+        enemy.loadWaveState(wave.health[waveTarget],wave.resonance[waveTarget],
+                            wave.defense[waveTarget],wave.turnCounter[waveTarget]);
+        player->resetTurn();
+        player->takeTurn(enemy);
+        while(player->hasExtraTurns()&&enemy.isAlive()){
+            player->useExtraTurn();
+            UISystem::out()<<BOLD<<GREEN<<"\n Extra turns!"<<RESET<<endl;
+            player->takeTurn(enemy);
+        }
+        wave.health[waveTarget]=enemy.getHealth();
+        wave.resonance[waveTarget]=enemy.getResonance();
+        if(wave.aliveCount()==0)break;
+        wave.resetTurn();
+        resolveWaveTurn();
+    }
+    waveActive=false;
+    waveTarget=-1;
+    showEncounterResult(rewardTotal);
+}
+
+// What it does: Lets every living member of the wave act and applies the summed result
+//               to the player at once
+void Combat::resolveWaveTurn(){
+    InputSystem::clearScreen();
+    InputSystem::drawTitle("Enemy wave's turn");
+    for(int i=0;i<wave.size();i++){
+        if(wave.health[i]<=0)continue;
+        UISystem::out()<<BOLD<<enemies[wave.archetype[i]]->getName()<<RESET<<"  "
+            <<Utils::formatHealthBar(wave.health[i],wave.maxHealth[i],10)<<endl;
+    }
+    UISystem::out()<<endl;
+    int resonanceDrain=0;
+    int damage=wave.resolveTurn(waveRuneDamage,waveRuneDrain,resonanceDrain);
+    int before=player->getHealth();
+    player->takeDamage(damage);
+    player->changeResonance(-resonanceDrain);
+    UISystem::out()<<RED<<wave.aliveCount()<<" enemies attack together, you took "
+        <<(before-player->getHealth())<<" points of damage"<<RESET<<endl;
+    if(resonanceDrain>0){
+        UISystem::out()<<MAGENTA<<"Your resonance is drained by "<<resonanceDrain<<RESET<<endl;
+    }
+    InputSystem::waitForAnyKey();
+}
+
+// What it does: Spreads an area attack to every other member of the current wave
+// Inputs: damage - Damage dealt to each enemy before its defense
+void Combat::applyAreaDamage(int damage){
+    if(!waveActive||wave.size()<2)return;
+    wave.applyAreaDamage(damage,waveTarget);
+    UISystem::out()<<RED<<"The blast also hits the rest of the wave!"<<RESET<<endl;
+}
+
+// What it does: Shows the ending titles and pays the reward if the player survived
+// Inputs: reward - Money looted on victory
+void Combat::showEncounterResult(int reward){
     //show ending titles, more functions could be implemented in the showVictory() and showGameOver()
     InputSystem::clearScreen();
     if(player->isAlive()){
         showVictory();
-        int reward = calculateReward(enemyIndex);
         if(playerRef && reward > 0){
             playerRef->money += reward;
-            cout<<GREEN<<"You looted "<<reward<<" Money from the battle!"<<RESET<<endl;
+            UISystem::out()<<GREEN<<"You looted "<<reward<<" Money from the battle!"<<RESET<<endl;
         }
     }
     else showGameOver();
@@ -87,21 +191,19 @@ int Combat::useHealingItem(){
     if(!playerRef) return 0;
     vector<Item*>& inv = playerRef->getInventory();
     Item* best = nullptr;
-    size_t bestIndex = 0;
     for(size_t i=0;i<inv.size();++i){
         Item* item = inv[i];
         if(item && item->healthEffect > 0){
             if(!best || item->healthEffect > best->healthEffect){
                 best = item;
-                bestIndex = i;
             }
         }
     }
     if(!best) return 0;
-    string itemName = best->name;
     int healAmount = best->healthEffect;
-    playerRef->removeItem(itemName);
-    cout<<CYAN<<"Consumed "<<itemName<<" for healing."<<RESET<<endl;
+    UISystem::out()<<CYAN<<"Consumed "<<best->name<<" for healing."<<RESET<<endl;
+    // Remove the exact instance found above instead of searching again by a copied name
+    playerRef->removeSpecificItem(best);
     return healAmount;
 }
 
@@ -111,15 +213,16 @@ int Combat::useHealingItem(){
 bool Combat::consumeAmmoForCurrentWeapon(){
     if(!currentWeapon.needsAmmo) return true;
     if(!playerRef) return false;
-    std::string ammo = currentWeapon.ammoItem.empty() ? "Bullet" : currentWeapon.ammoItem;
-    if(ammo.empty()) return true;
-    if(playerRef->hasItem(ammo)){
-        std::string ammoName = ammo;
-        playerRef->removeItem(ammoName);
-        cout<<YELLOW<<"Consumed "<<ammo<<" for "<<currentWeapon.name<<"."<<RESET<<endl;
-        return true;
+    static const std::string defaultAmmo = "Bullet";
+    const std::string& ammo = currentWeapon.ammoItem.empty() ? defaultAmmo : currentWeapon.ammoItem;
+    for(Item* item : playerRef->getInventory()){
+        if(item && item->name == ammo){
+            UISystem::out()<<YELLOW<<"Consumed "<<ammo<<" for "<<currentWeapon.name<<"."<<RESET<<endl;
+            playerRef->removeSpecificItem(item);
+            return true;
+        }
     }
-    cout<<RED<<"No "<<ammo<<" left! "<<currentWeapon.name<<" deals no extra damage."<<RESET<<endl;
+    UISystem::out()<<RED<<"No "<<ammo<<" left! "<<currentWeapon.name<<" deals no extra damage."<<RESET<<endl;
     InputSystem::waitForAnyKey();
     return false;
 }
@@ -128,7 +231,7 @@ bool Combat::consumeAmmoForCurrentWeapon(){
 // What it does: Displays available weapons and allows player to equip one from backpack
 void Combat::openWeaponMenu(){
     if(!playerRef){
-        cout<<RED<<"Cannot access backpack right now."<<RESET<<endl;
+        UISystem::out()<<RED<<"Cannot access backpack right now."<<RESET<<endl;
         InputSystem::waitForAnyKey();
         return;
     }
@@ -147,13 +250,12 @@ void Combat::openWeaponMenu(){
     
     // Handle case when backpack has no weapons
     if(weapons.empty()){
-        cout<<YELLOW<<"No weapons available. Using bare hands."<<RESET<<endl;
+        UISystem::out()<<YELLOW<<"No weapons available. Using bare hands."<<RESET<<endl;
         setCurrentWeapon(nullptr);
         InputSystem::waitForAnyKey();
         return;
     }
-    bool selecting=true;
-    while(selecting){
+    while(true){
         InputSystem::clearScreen();
         InputSystem::drawTitle("Select Weapon");
         
@@ -161,43 +263,36 @@ void Combat::openWeaponMenu(){
         for(size_t i=0;i<weapons.size();++i){
             Item* item = weapons[i];
             bool needsAmmo = (item->name == "Shotgun");
-            cout<<"["<<(i+1)<<"] "<<item->name<<" - Damage "<<item->damage
+            UISystem::out()<<"["<<(i+1)<<"] "<<item->name<<" - Damage "<<item->damage
                 <<" | Durability "<<item->durability;
-            if(needsAmmo) cout<<" (requires Bullets)";
-            cout<<endl;
+            if(needsAmmo) UISystem::out()<<" (requires Bullets)";
+            UISystem::out()<<endl;
         }
-        cout<<"[0] Cancel"<<endl;
-        cout<<YELLOW<<"Press number to equip weapon."<<RESET<<endl;
+        UISystem::out()<<"[0] Cancel"<<endl;
+        UISystem::out()<<YELLOW<<"Press number to equip weapon."<<RESET<<endl;
         
         // Handle player input for weapon selection
-        bool gotInput=false;
-        while(!gotInput){
-            if(InputSystem::kbhit()){
-                char key=InputSystem::getch();
-                if(key=='0'){
-                    cout<<YELLOW<<"Weapon selection cancelled."<<RESET<<endl;
-                    InputSystem::waitForAnyKey();
-                    return;
-                }
-                if(key>='1' && key<='9'){
-                    int option = key-'0';
-                    if(option>=1 && option <= static_cast<int>(weapons.size())){
-                        Item* chosen = weapons[option-1];      // Equip the chosen weapon from backpack
-                        setCurrentWeapon(chosen);
-                        cout<<GREEN<<"Equipped "<<currentWeapon.name<<" (+"
-                            <<currentWeapon.damage<<" dmg";
-                        if(currentWeapon.needsAmmo) cout<<", uses Bullets";
-                        cout<<")."<<RESET<<endl;
-                        InputSystem::waitForAnyKey();
-                        return;
-                    }
-                }
-                cout<<RED<<"Invalid selection."<<RESET<<endl;
+        char key=InputSystem::readKey();
+        if(key=='0'){
+            UISystem::out()<<YELLOW<<"Weapon selection cancelled."<<RESET<<endl;
+            InputSystem::waitForAnyKey();
+            return;
+        }
+        if(key>='1' && key<='9'){
+            int option = key-'0';
+            if(option>=1 && option <= static_cast<int>(weapons.size())){
+                Item* chosen = weapons[option-1];      // Equip the chosen weapon from backpack
+                setCurrentWeapon(chosen);
+                UISystem::out()<<GREEN<<"Equipped "<<currentWeapon.name<<" (+"
+                    <<currentWeapon.damage<<" dmg";
+                if(currentWeapon.needsAmmo) UISystem::out()<<", uses Bullets";
+                UISystem::out()<<")."<<RESET<<endl;
                 InputSystem::waitForAnyKey();
-                gotInput = true;
+                return;
             }
-            InputSystem::sleepMs(100);
         }
+        UISystem::out()<<RED<<"Invalid selection."<<RESET<<endl;
+        InputSystem::waitForAnyKey();
     }
 }
 
@@ -234,7 +329,7 @@ void Combat::handleWeaponDurability(){
     if(currentWeapon.itemPtr->durability <= 0){
         std::string brokenName = currentWeapon.itemPtr->name;
         playerRef->removeSpecificItem(currentWeapon.itemPtr);
-        cout<<RED<<brokenName<<" broke!"<<RESET<<endl;
+        UISystem::out()<<RED<<brokenName<<" broke!"<<RESET<<endl;
         setCurrentWeapon(nullptr);
         InputSystem::waitForAnyKey();
     } else {
@@ -259,15 +354,15 @@ int Combat::calculateReward(int enemyIndex) const{
 // Displays rune system introduction
 // What it does: Shows rune combinations and controls for combat
 void Combat::showRuneIntro(){
-    cout<<BOLD<<MAGENTA;
+    UISystem::out()<<BOLD<<MAGENTA;
     InputSystem::drawSeparator();
-    cout<<RESET;
-    cout<<"Use the number keys 1-7 to play notes, and space to activate runes."<<endl;
-    cout<<endl;
-    cout<<BOLD<<"Rune combinations:"<<RESET<<endl;
-    cout<<GREEN<<"1-2-1 Cure Rune"<<RESET<<endl;
-    cout<<RED<<"3-4-3 Attack Rune"<<RESET<<endl;
-    cout<<BLUE<<"5-6-5 Defense Rune"<<RESET<<endl;
+    UISystem::out()<<RESET;
+    UISystem::out()<<"Use the number keys 1-7 to play notes, and space to activate runes."<<endl;
+    UISystem::out()<<endl;
+    UISystem::out()<<BOLD<<"Rune combinations:"<<RESET<<endl;
+    UISystem::out()<<GREEN<<"1-2-1 Cure Rune"<<RESET<<endl;
+    UISystem::out()<<RED<<"3-4-3 Attack Rune"<<RESET<<endl;
+    UISystem::out()<<BLUE<<"5-6-5 Defense Rune"<<RESET<<endl;
 }
 
 
@@ -275,10 +370,10 @@ void Combat::showRuneIntro(){
 // What it does: Shows victory message and clears screen
 void Combat::showVictory(){
     InputSystem::clearScreen();
-    cout<<BOLD<<GREEN;
+    UISystem::out()<<BOLD<<GREEN;
     InputSystem::drawTitle("Congratulations! Your have defeated the enemy!");
     InputSystem::sleepMs(2000);
-    cout<<RESET;
+    UISystem::out()<<RESET;
 }
 
 
@@ -286,8 +381,8 @@ void Combat::showVictory(){
 // What it does: Shows defeat message and clears screen
 void Combat::showGameOver(){
     InputSystem::clearScreen();
-    cout<<BOLD<<RED;
+    UISystem::out()<<BOLD<<RED;
     InputSystem::drawTitle("You failed to defeat the enemy.");
     InputSystem::sleepMs(2000);
-    cout<<RESET;
+    UISystem::out()<<RESET;
 }
@@ -2,7 +2,9 @@
 #define COMBAT_H
 
 #include "CombatPlayer.h"
+#include "CombatHost.h"
 #include "enemy.h"
+#include "wave.h"
 #include<vector>
 #include<memory>
 #include<string>
@@ -10,8 +12,8 @@
 class Player;
 struct Item;
 
-//The class for combat actions;
-class Combat{
+//The class for combat actions; it is also the CombatHost of its CombatPlayer
+class Combat final:public CombatHost{
 private:
     struct EquippedWeapon {
         Item* itemPtr;
@@ -21,27 +23,37 @@ private:
         std::string ammoItem;
     };
 
-    unique_ptr<CombatPlayer> player;
     Player* playerRef;
+    unique_ptr<CombatPlayer> player;
     vector<unique_ptr<Enemy>> enemies;
     int currentEnemyIndex;
     int score;
     EquippedWeapon currentWeapon;
+    EnemyWave wave;
+    bool waveActive;
+    int waveTarget;
+    vector<int> waveRuneDamage;  //per enemy archetype
+    vector<int> waveRuneDrain;   //per enemy archetype
 
     void showRuneIntro();
     void showVictory();
     void showGameOver();
-    int useHealingItem();
-    bool consumeAmmoForCurrentWeapon();
-    void openWeaponMenu();
+    int useHealingItem() override;
+    bool consumeAmmoForCurrentWeapon() override;
+    void openWeaponMenu() override;
     void applyEquippedWeapon();
     void setCurrentWeapon(Item* weaponPtr);
-    void handleWeaponDurability();
+    void handleWeaponDurability() override;
+    void applyAreaDamage(int damage) override;
+    void resolveWaveTurn();
+    void showEncounterResult(int reward);
     int calculateReward(int enemyIndex) const;
 public:
     Combat(Player* owner, const string &ply, Item* startingWeapon);
     ~Combat();
+    void prepareEncounter(Item* weaponPtr);
     void fightEnemy(int enemyIndex);
+    void fightWave(const vector<int> &archetypes);
     void equipWeapon(Item* weaponPtr);
 };
 
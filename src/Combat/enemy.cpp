@@ -1,6 +1,6 @@
 #include "enemy.h"
 #include "CombatPlayer.h"
-#include "../Core/InputSystem.h"
+#include "../Core/UISystem.h"
 #include "utils.h"
 #include<iostream>
 #include<memory>
@@ -11,27 +11,16 @@ using namespace std;
 //name: string name of the enemy
 //enemyType: the type of enemy
 //health: the amount of health of the enemy
-Enemy::Enemy(const string &name,const string &enemyType,int health):Character(name,health),type(enemyType),turnCounter(0){
-    if(type=="Rhythm Breaker"){
-        description={"Piercing noise emitting!","Your rhythm is disrupted!","Playing dissonant notes!"};
-        addRune(std::unique_ptr<Rune>(new Rune("Noise rune",vector<Note>{SI,RE,SI},"Cause damage and reduce resonance",15,RED)));
-    }
-    else if(type=="Melody Thief"){
-        description={"Your melody stolen!","Imitating your playing!","Disturbing the music!"};
-        addRune(std::unique_ptr<Rune>(new Rune("Theft rune",vector<Note>{FA,SOL,FA},"Theft resonance",10,MAGENTA)));
-    }
-    else if (type=="Harmony Monster"){
-        description={"Producing defening harmony!","Low frequencies vibrating!","Creating discordant chords"};
-        addRune(std::unique_ptr<Rune>(new Rune("Shock rune",vector<Note>{DO,SI,DO},"Cause a great amount of damage",30,RED)));
-    }
+Enemy::Enemy(const string &name,const string &enemyType,int health):Character(name,health),profile(Registry::findEnemyProfile(enemyType)),type(enemyType),turnCounter(0){
+    if(profile)addRune(profile->rune);
 }
 // Enemy's action in one turn
 //target: normally the player
 void Enemy::takeTurn(Character &target){
     InputSystem::clearScreen();
     InputSystem::drawTitle(name+"'s turn");
-    cout<<BOLD<<"Enemy: "<<name<<RESET<<endl;
-    cout<<"Health: "<<getHealthBar()<<endl<<endl;
+    UISystem::out()<<BOLD<<"Enemy: "<<name<<RESET<<endl;
+    UISystem::out()<<"Health: "<<getHealthBar()<<endl<<endl;
     //Enemy's behavior
     if(turnCounter%3==0&&resonance>=10)useRuneAttack(target);
     else if(turnCounter%2==0)disruptPlayer(target);
@@ -43,42 +32,46 @@ void Enemy::takeTurn(Character &target){
 //enemy use rune to attack
 //target: player type
 void Enemy::useRuneAttack(Character &target){
-    if(runes.empty())return ;
-    const auto &rune=runes[0];
+    if(runeCount==0)return ;
+    const Rune &rune=getRune(0);
     changeResonance(-10);
-    cout<<RED<<getRandomDescription()<<RESET<<endl;
-    cout<<BOLD<<rune->color<<name<<" used "<<rune->name<<"!"<<RESET<<endl;
-    if(rune->name=="Noise rune"){
-        target.takeDamage(rune->power);
-        static_cast<CombatPlayer&>(target).changeResonance(-10);
-        cout<<RED<<"You took "<<rune->power<<" points of damage, and resonance is reduced!"<<RESET<<endl;
-    }
-    else if(rune->name=="Theft rune"){
-        int stolen=min(15,static_cast<CombatPlayer&>(target).getResonance());
-        static_cast<CombatPlayer&>(target).changeResonance(-stolen);
-        changeResonance(stolen);
-        cout<<MAGENTA<<name<<" stole "<<stolen<<" points of resonance!"<<RESET<<endl;
-    }
-    else if(rune->name=="Shock rune"){
-        target.takeDamage(rune->power);
-        cout<<RED<<"You took "<<rune->power<<" points of damage!"<<RESET<<endl;
+    UISystem::out()<<RED<<getRandomDescription()<<RESET<<endl;
+    UISystem::out()<<BOLD<<rune.color<<name<<" used "<<rune.name<<"!"<<RESET<<endl;
+    switch(rune.id){
+        case NOISE_RUNE:
+            target.takeDamage(rune.power);
+            static_cast<CombatPlayer&>(target).changeResonance(-10);
+            UISystem::out()<<RED<<"You took "<<rune.power<<" points of damage, and resonance is reduced!"<<RESET<<endl;
+            break;
+        case THEFT_RUNE:
+            {int stolen=min(15,static_cast<CombatPlayer&>(target).getResonance());
+            static_cast<CombatPlayer&>(target).changeResonance(-stolen);
+            changeResonance(stolen);
+            UISystem::out()<<MAGENTA<<name<<" stole "<<stolen<<" points of resonance!"<<RESET<<endl;
+            break;}
+        case SHOCK_RUNE:
+            target.takeDamage(rune.power);
+            UISystem::out()<<RED<<"You took "<<rune.power<<" points of damage!"<<RESET<<endl;
+            break;
+        default:
+            break;
     }
 }
 //disrupt player("target"), with possibility of clear melody, change resonance, and reset combo
 //target: player type
 void Enemy::disruptPlayer(Character &target){
-    cout<<YELLOW<<getRandomDescription()<<RESET<<endl;
+    UISystem::out()<<YELLOW<<getRandomDescription()<<RESET<<endl;
     if(rand()%100<50){
         static_cast<CombatPlayer&>(target).clearMelody();
-        cout<<RED<<"Your melody was cleared!"<<RESET<<endl;
+        UISystem::out()<<RED<<"Your melody was cleared!"<<RESET<<endl;
     }
     if(rand()%100<30){
         static_cast<CombatPlayer&>(target).changeResonance(-8);
-        cout<<RED<<"Your resonance reduced!"<<RESET<<endl;
+        UISystem::out()<<RED<<"Your resonance reduced!"<<RESET<<endl;
     }
     if(rand()%100<20){
         static_cast<CombatPlayer&>(target).resetCombo();
-        cout<<RED<<"Your combo has been reset!"<<RESET<<endl;
+        UISystem::out()<<RED<<"Your combo has been reset!"<<RESET<<endl;
     }
 }
 //normal attack from the enemy to player("target")
@@ -86,11 +79,30 @@ void Enemy::disruptPlayer(Character &target){
 void Enemy::normalAttack(Character &target){
     int damage=10+(rand()%6);
     target.takeDamage(damage);
-    cout<<RED<<name<<" caused you "<<damage<<" points of damage"<<RESET<<endl;
+    UISystem::out()<<RED<<name<<" caused you "<<damage<<" points of damage"<<RESET<<endl;
 }
 //return a random description
 string Enemy::getRandomDescription(){
-    return description[rand()%description.size()];
+    if(!profile)return "";
+    return profile->descriptions[rand()%ENEMY_DESCRIPTION_COUNT];
+}
+//bring a pooled enemy back to full strength before a new encounter
+void Enemy::resetEncounter(){
+    resetState();
+    turnCounter=0;
+}
+//let a pooled enemy stand in for one member of a wave
+//hp, res, def, turns: the member's health, resonance, defense and turn counter
+void Enemy::loadWaveState(int hp,int res,int def,int turns){
+    health=hp;
+    resonance=res;
+    defense=def;
+    turnCounter=turns;
+    melody.clear();
+}
+//return the number of turns the enemy has taken
+int Enemy::getTurnCounter()const{
+    return turnCounter;
 }
 //reset the defense after each turn
 void Enemy::resetTurn(){
@@ -7,7 +7,7 @@
 using namespace std;
 class Enemy:public Character{
 private:
-    vector<string> description;
+    const EnemyProfile *profile;
     string type;
     int turnCounter;
     void useRuneAttack(Character &target);
@@ -18,6 +18,9 @@ public:
     Enemy(const string &name,const string &enemyType,int health);
     void takeTurn(Character &target);
     void resetTurn();
+    void resetEncounter();
+    void loadWaveState(int hp,int res,int def,int turns);
+    int getTurnCounter()const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "registry.h"
+using namespace std;
+
+namespace {
+//indexed by RuneId
+const Rune runeTable[RUNE_COUNT]={
+    {CURE_RUNE,"Cure Rune",{DO,RE,DO},3,"Heal",20,GREEN},
+    {ATTACK_RUNE,"Attack Rune",{MI,FA,MI},3,"Damage",25,RED},
+    {DEFENSE_RUNE,"Defense Rune",{SOL,LA,SOL},3,"Defense",15,BLUE},
+    {NOISE_RUNE,"Noise rune",{SI,RE,SI},3,"Cause damage and reduce resonance",15,RED},
+    {THEFT_RUNE,"Theft rune",{FA,SOL,FA},3,"Theft resonance",10,MAGENTA},
+    {SHOCK_RUNE,"Shock rune",{DO,SI,DO},3,"Cause a great amount of damage",30,RED}
+};
+//indexed by Note, slot 0 is unused
+const NoteEffect playerNoteEffects[SI+1]={
+    {"","",0,RESET},
+    {"Heal","Recover small amount of health",8,GREEN},
+    {"Power up","Recover resonance",10,BLUE},
+    {"Attack","Damage the enemy",12,RED},
+    {"Shield","aquire temper defense",5,CYAN},
+    {"Purge","Rurge and recover small amount of health",5,MAGENTA},
+    {"Variation","Random effect",0,WHITE},
+    {"Accumulation","Extra turns",0,WHITE}
+};
+const EnemyProfile enemyProfiles[]={
+    {"Rhythm Breaker",NOISE_RUNE,{"Piercing noise emitting!","Your rhythm is disrupted!","Playing dissonant notes!"}},
+    {"Melody Thief",THEFT_RUNE,{"Your melody stolen!","Imitating your playing!","Disturbing the music!"}},
+    {"Harmony Monster",SHOCK_RUNE,{"Producing defening harmony!","Low frequencies vibrating!","Creating discordant chords"}}
+};
+}
+
+//return the definition of the rune "id"
+const Rune &Registry::getRune(RuneId id){
+    return runeTable[id];
+}
+//return the player's effect of "note"
+const NoteEffect &Registry::getPlayerNoteEffect(Note note){
+    return playerNoteEffects[note];
+}
+//find the profile of the enemy "type"
+//returns nullptr for unknown types
+const EnemyProfile *Registry::findEnemyProfile(const string &type){
+    for(const EnemyProfile &profile:enemyProfiles){
+        if(type==profile.type)return &profile;
+    }
+    return nullptr;
+}
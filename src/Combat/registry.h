@@ -0,0 +1,45 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+#include "utils.h"
+#include <string>
+
+//Shared, immutable definitions of note effects, runes and enemy types.
+//Characters only keep pointers or ids into these tables.
+
+enum RuneId {CURE_RUNE,ATTACK_RUNE,DEFENSE_RUNE,NOISE_RUNE,THEFT_RUNE,SHOCK_RUNE,RUNE_COUNT};
+
+const int MAX_RUNE_LENGTH=3;
+const int MAX_CHARACTER_RUNES=4;
+const int ENEMY_DESCRIPTION_COUNT=3;
+
+struct NoteEffect {
+    const char *name;
+    const char *description;
+    int power;
+    const char *color;
+};
+
+struct Rune {
+    RuneId id;
+    const char *name;
+    Note sequence[MAX_RUNE_LENGTH];
+    int length;
+    const char *effect;
+    int power;
+    const char *color;
+};
+
+struct EnemyProfile {
+    const char *type;
+    RuneId rune;
+    const char *descriptions[ENEMY_DESCRIPTION_COUNT];
+};
+
+namespace Registry{
+    const Rune &getRune(RuneId id);
+    const NoteEffect &getPlayerNoteEffect(Note note);
+    const EnemyProfile *findEnemyProfile(const string &type);
+}
+
+#endif
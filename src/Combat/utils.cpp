@@ -1,72 +1,44 @@
 #include "utils.h"
+#include "../Core/UISystem.h"
 #include<iostream>
-#include<termios.h>
-#include<unistd.h>
-#include<fcntl.h>
-#include<sys/ioctl.h>
-#include<chrono>
-#include<thread>
 #include<algorithm>
 #include<cstdlib>
 #include<ctime>
 using namespace std;
-int Terminal::terminalWidth=80;
-bool Terminal::widthCalculated=0;
-struct termios Terminal::originalTermios;
-//enable nonblocking input
+//enable nonblocking input through the current frontend
 void Terminal::setNonBlockingInput(){
-    struct termios newTerminal;
-    tcgetattr(STDIN_FILENO,&originalTermios);
     //hide the cursor
-    cout<<"\x1b[?25l"<<endl;
-    newTerminal=originalTermios;
-    newTerminal.c_lflag&=~(ICANON|ECHO);
-    tcsetattr(STDIN_FILENO,TCSANOW,&newTerminal);
-    fcntl(STDIN_FILENO,F_SETFL,O_NONBLOCK);
+    UISystem::out()<<"\x1b[?25l"<<endl;
+    InputSystem::initialize();
 }
 //reset terminal settings
 void Terminal::restoreTerminal(){
     //enabling the cursor
-    cout<<"\x1b[?25h"<<endl;
-    tcsetattr(STDIN_FILENO,TCSANOW,&originalTermios);
-    fcntl(STDIN_FILENO,F_SETFL,0);
+    UISystem::out()<<"\x1b[?25h"<<endl;
+    InputSystem::cleanup();
 }
-//check keyboard input
+//check keyboard input, shares the key queue of InputSystem so no key is lost
 bool Terminal::kbhit(){
-    struct timeval tv={0,0};
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(STDIN_FILENO,&fds);
-    return select(STDIN_FILENO+1,&fds,NULL,NULL,&tv)>0;
+    return InputSystem::kbhit();
 }
 //get ketboard input
 char Terminal::getch(){
-    char c=0;
-    read(STDIN_FILENO,&c,1);
-    return c;
+    return InputSystem::getch();
 }
 //clear screen
 void Terminal::clearScreen(){
-    cout<<"\033[2J\033[1;1H";
+    UISystem::out()<<"\033[2J\033[1;1H";
 }
-//the size of the terminal is saved in "rows" and "cols"
+//the size of the terminal is saved in "rows" and "cols", rows is fixed at 24
 //rows: number of rows of the terminal
 //cols: number of columns of the terminal
 void Terminal::getTerminalSize(int &rows,int &cols){
-    struct winsize w;
-    ioctl(STDOUT_FILENO,TIOCGWINSZ, &w);
-    rows=w.ws_row;
-    cols=w.ws_col;
-    terminalWidth=cols;
-    widthCalculated=1;
+    rows=24;
+    cols=getTerminalWidth();
 }
-//return the terminalWidth
+//return the width of the current frontend
 int Terminal::getTerminalWidth(){
-    if(!widthCalculated){
-        int rows,cols;
-        getTerminalSize(rows,cols);
-    }
-    return terminalWidth;
+    return InputSystem::getTerminalWidth();
 }
 //draw separating line
 //length: the length of the separating line
@@ -75,9 +47,9 @@ void Terminal::drawSeparator(int length){
         length=getTerminalWidth()-2;
         length=max(length,20);
     }
-    cout<<CYAN;
-    for(int i=0;i<length;i++)cout<<"─";
-    cout<<RESET<<endl;
+    UISystem::out()<<CYAN;
+    for(int i=0;i<length;i++)UISystem::out()<<"─";
+    UISystem::out()<<RESET<<endl;
 }
 //draw "title" suiting the size of the terminal
 //title: content of title
@@ -85,9 +57,9 @@ void Terminal::drawTitle(string title){
     int width=getTerminalWidth();
     int padding=(width-title.length()-4)/2;
     padding=max(padding,0);
-    cout<<MAGENTA<<BOLD;
-    for(int i=0;i<padding;i++)cout<<" ";
-    cout<<title<<RESET<<endl;
+    UISystem::out()<<MAGENTA<<BOLD;
+    for(int i=0;i<padding;i++)UISystem::out()<<" ";
+    UISystem::out()<<title<<RESET<<endl;
 }
 //notes to string
 //note: note needed
@@ -106,16 +78,13 @@ string Utils::noteToString(Note note){
 }
 //wait for nonblocking input
 void Utils::waitForAnyKey(){
-    cout<<YELLOW<<"Press any key to continue"<<RESET<<endl;
-    while(!Terminal::kbhit()){
-        sleepMs(100);
-    }
-    Terminal::getch();
+    UISystem::out()<<YELLOW<<"Press any key to continue"<<RESET<<endl;
+    InputSystem::readKey();
 }
 //wait for "ms" ms
 //ms: time for waiting
 void Utils::sleepMs(int ms){
-    this_thread::sleep_for(chrono::milliseconds(ms));
+    InputSystem::sleepMs(ms);
 }
 //create the format of the health bar and returns the bar
 //current: current health
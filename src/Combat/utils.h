@@ -14,11 +14,8 @@
 
 enum Note {DO=1,RE,MI,FA,SOL,LA,SI};
 using namespace std;
+//terminal helpers of the combat screens, all going through the current frontend
 class Terminal{
-private:
-    static int terminalWidth;
-    static bool widthCalculated;
-    static struct termios originalTermios;
 public:
     static void setNonBlockingInput();
     static bool kbhit();
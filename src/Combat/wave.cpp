@@ -0,0 +1,94 @@
+#include "wave.h"
+#include<algorithm>
+#include<cstdlib>
+using namespace std;
+//remove every enemy, the capacity is kept for the next wave
+void EnemyWave::clear(){
+    archetype.clear();
+    health.clear();
+    maxHealth.clear();
+    defense.clear();
+    resonance.clear();
+    turnCounter.clear();
+}
+//reserve room for "count" enemies so adding them does not allocate
+void EnemyWave::reserve(int count){
+    archetype.reserve(count);
+    health.reserve(count);
+    maxHealth.reserve(count);
+    defense.reserve(count);
+    resonance.reserve(count);
+    turnCounter.reserve(count);
+}
+//add an enemy to the wave
+//archetypeIndex: index of the enemy in the combat pool
+//hp: health of the enemy
+void EnemyWave::add(int archetypeIndex,int hp){
+    archetype.push_back(archetypeIndex);
+    health.push_back(hp);
+    maxHealth.push_back(hp);
+    defense.push_back(0);
+    resonance.push_back(50);
+    turnCounter.push_back(0);
+}
+//return the number of enemies in the wave, dead ones included
+int EnemyWave::size()const{
+    return static_cast<int>(health.size());
+}
+//return the number of enemies still alive
+int EnemyWave::aliveCount()const{
+    int alive=0;
+    for(int i=0;i<size();i++)alive+=(health[i]>0);
+    return alive;
+}
+//return the index of the first living enemy, -1 if the wave is defeated
+int EnemyWave::firstAlive()const{
+    for(int i=0;i<size();i++){
+        if(health[i]>0)return i;
+    }
+    return -1;
+}
+//hit every enemy of the wave at once, defense is applied per enemy
+//damage: damage dealt to each enemy
+//skipIndex: enemy already hit directly, -1 to hit everyone
+void EnemyWave::applyAreaDamage(int damage,int skipIndex){
+    int n=size();
+    int *hp=health.data();
+    const int *def=defense.data();
+    for(int i=0;i<n;i++){
+        int hit=(i!=skipIndex);
+        int realDamage=max(0,damage-def[i])*hit;
+        hp[i]=max(0,hp[i]-realDamage);
+    }
+}
+//reset the defense of every enemy after their turn
+void EnemyWave::resetTurn(){
+    fill(defense.begin(),defense.end(),0);
+}
+//let every living enemy act, the results are summed and returned as one batch
+//runeDamage: damage of the rune of each archetype
+//runeDrain: resonance drained by the rune of each archetype
+//resonanceDrain: set to the total resonance drained from the player
+//returns the total damage dealt to the player
+int EnemyWave::resolveTurn(const vector<int> &runeDamage,const vector<int> &runeDrain,int &resonanceDrain){
+    int n=size();
+    int totalDamage=0;
+    resonanceDrain=0;
+    for(int i=0;i<n;i++){
+        if(health[i]<=0)continue;
+        //same behaviour as Enemy::takeTurn, without the disruption rolls
+        if(turnCounter[i]%3==0&&resonance[i]>=10){
+            resonance[i]-=10;
+            totalDamage+=runeDamage[archetype[i]];
+            resonanceDrain+=runeDrain[archetype[i]];
+        }
+        else totalDamage+=10+(rand()%6);
+    }
+    //turn counters and resonance advance for the whole wave in one pass
+    for(int i=0;i<n;i++){
+        int alive=(health[i]>0);
+        turnCounter[i]+=alive;
+        resonance[i]=min(100,resonance[i]+5*alive);
+    }
+    return totalDamage;
+}
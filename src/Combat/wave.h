@@ -0,0 +1,29 @@
+#ifndef WAVE_H
+#define WAVE_H
+
+#include<vector>
+using namespace std;
+
+//state of a wave of enemies fighting at the same time, kept as structure-of-arrays
+//so area effects and the enemies' turn are simple passes over contiguous ints
+class EnemyWave{
+public:
+    vector<int> archetype;   //index into Combat's enemy pool
+    vector<int> health;
+    vector<int> maxHealth;
+    vector<int> defense;
+    vector<int> resonance;
+    vector<int> turnCounter;
+
+    void clear();
+    void reserve(int count);
+    void add(int archetypeIndex,int hp);
+    int size()const;
+    int aliveCount()const;
+    int firstAlive()const;
+    void applyAreaDamage(int damage,int skipIndex=-1);
+    void resetTurn();
+    int resolveTurn(const vector<int> &runeDamage,const vector<int> &runeDrain,int &resonanceDrain);
+};
+
+#endif
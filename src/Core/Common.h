@@ -11,7 +11,8 @@ enum GameState {
     DAY,
     NIGHT,
     COMBAT,
-    GAME_OVER
+    GAME_OVER,
+    QUIT        // Saved and quit, or the input ended
 };
 
 enum ItemType { 
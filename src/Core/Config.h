@@ -9,7 +9,8 @@
 enum Difficulty {
     DIFFICULTY_EASY = 0,    ///< Easy difficulty mode
     DIFFICULTY_NORMAL = 1,  ///< Normal difficulty mode
-    DIFFICULTY_HARD = 2     ///< Hard difficulty mode
+    DIFFICULTY_HARD = 2,    ///< Hard difficulty mode
+    DIFFICULTY_COUNT = 3    ///< Number of difficulty modes
 };
 
 /**
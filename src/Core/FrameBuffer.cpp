@@ -0,0 +1,120 @@
+// FrameBuffer.cpp - Line based frame composition implementation
+#include "FrameBuffer.h"
+#include "Frontend.h"
+
+using namespace std;
+
+// Constructor: Preallocates line storage and the output buffer
+// What it does: Reserves memory so composing and presenting a frame does not allocate
+// Inputs: reservedLines - Number of lines to preallocate
+//         reservedBytes - Size of the output buffer to preallocate
+// Outputs: None (constructor)
+FrameBuffer::FrameBuffer(size_t reservedLines, size_t reservedBytes)
+    : lines(reservedLines), shownLines(reservedLines),
+      lineCount(0), shownCount(0), fullRedraw(true) {
+    for (size_t i = 0; i < reservedLines; ++i) {
+        lines[i].reserve(128);
+        shownLines[i].reserve(128);
+    }
+    output.reserve(reservedBytes);
+}
+
+// Starts composing a new frame
+// What it does: Forgets the lines of the previous frame while keeping their capacity
+// Inputs: None
+// Outputs: None
+void FrameBuffer::beginFrame() {
+    lineCount = 0;
+}
+
+// Appends an empty line to the frame
+// What it does: Returns a cleared line string that the caller appends text to
+// Inputs: None
+// Outputs: string& - The new line, valid until the next addLine call
+std::string& FrameBuffer::addLine() {
+    if (lineCount == lines.size()) {
+        lines.push_back(string());
+        shownLines.push_back(string());
+    }
+    string& line = lines[lineCount++];
+    line.clear();
+    return line;
+}
+
+// Appends a line of text to the frame
+// What it does: Copies text into the next line of the frame
+// Inputs: text - Content of the line, without a trailing newline
+// Outputs: None
+void FrameBuffer::addLine(const std::string& text) {
+    addLine() += text;
+}
+
+// Appends a cached block of lines to the frame
+// What it does: Copies a prebuilt static region (menus, legends) into the frame
+// Inputs: block - Lines to append
+// Outputs: None
+void FrameBuffer::addLines(const std::vector<std::string>& block) {
+    for (size_t i = 0; i < block.size(); ++i) {
+        addLine(block[i]);
+    }
+}
+
+// Marks the screen content as unknown
+// What it does: Forces the next present() to clear the screen and repaint every line.
+//               Call it after anything else cleared or drew over the screen.
+// Inputs: None
+// Outputs: None
+void FrameBuffer::invalidate() {
+    fullRedraw = true;
+}
+
+// Appends an ANSI cursor move to the start of a row
+// What it does: Writes ESC[row;1H into the output buffer without temporary strings
+// Inputs: row - Zero based row index
+// Outputs: None
+void FrameBuffer::appendCursorMove(size_t row) {
+    char digits[20];
+    int length = 0;
+    size_t value = row + 1;
+    do {
+        digits[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    output += "\033[";
+    while (length > 0) {
+        output += digits[--length];
+    }
+    output += ";1H";
+}
+
+// Writes the composed frame to the screen
+// What it does: Emits only the lines that differ from the frame on screen, clears whatever
+//               was printed below the frame and hands everything to the frontend at once
+// Inputs: None
+// Outputs: None
+void FrameBuffer::present() {
+    output.clear();
+    if (fullRedraw) {
+        output += "\033[2J\033[H";
+    }
+
+    for (size_t i = 0; i < lineCount; ++i) {
+        if (!fullRedraw && i < shownCount && shownLines[i] == lines[i]) {
+            continue;
+        }
+        appendCursorMove(i);
+        output += lines[i];
+        output += "\033[K";
+        shownLines[i] = lines[i];
+    }
+
+    // Drop stale lines of a longer frame and messages printed after the last present
+    appendCursorMove(lineCount);
+    output += "\033[J";
+
+    shownCount = lineCount;
+    fullRedraw = false;
+
+    Frontend::current().showFrame(output);
+}
@@ -0,0 +1,33 @@
+// FrameBuffer.h - Line based frame composition for full-screen views
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+#include <string>
+#include <vector>
+
+class FrameBuffer {
+private:
+    std::vector<std::string> lines;       // Lines of the frame being composed
+    std::vector<std::string> shownLines;  // Lines currently visible on screen
+    std::string output;                   // Preallocated bytes for one write()
+    size_t lineCount;                     // Lines used by the current frame
+    size_t shownCount;                    // Lines used by the frame on screen
+    bool fullRedraw;                      // Screen content is unknown, repaint everything
+
+    void appendCursorMove(size_t row);
+
+public:
+    FrameBuffer(size_t reservedLines = 40, size_t reservedBytes = 8192);
+
+    // Frame composition
+    void beginFrame();
+    std::string& addLine();
+    void addLine(const std::string& text);
+    void addLines(const std::vector<std::string>& block);
+
+    // Output
+    void invalidate();
+    void present();
+};
+
+#endif
@@ -0,0 +1,123 @@
+// Frontend.cpp - Terminal and headless frontends
+#include "Frontend.h"
+#include "GameSession.h"
+#include <iostream>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <cerrno>
+
+using namespace std;
+
+// Returns the next key
+// What it does: Hands out the key kept by peekKey() first, then asks the input source
+// Inputs: timeoutMs - Milliseconds to wait, 0 to only check, -1 to wait forever
+// Outputs: int - The key as an unsigned char value, or -1 on timeout or end of input
+int Frontend::nextKey(int timeoutMs) {
+    if (peekedKey >= 0) {
+        int key = peekedKey;
+        peekedKey = -1;
+        return key;
+    }
+    return input().nextKey(timeoutMs);
+}
+
+// Checks for a key without waiting
+// What it does: Takes a key from the source if one is ready and keeps it for nextKey()
+// Inputs: None
+// Outputs: bool - True if a key is waiting
+bool Frontend::peekKey() {
+    if (peekedKey < 0) {
+        peekedKey = input().nextKey(0);
+    }
+    return peekedKey >= 0;
+}
+
+// Gets the current frontend
+// What it does: Returns the frontend of the game session bound to the calling thread
+// Inputs: None
+// Outputs: Frontend& - Where output and input go
+Frontend &Frontend::current() {
+    return GameSession::current().getFrontend();
+}
+
+// Gets the terminal frontend
+// What it does: Returns the one frontend on stdin/stdout, created on first use
+// Inputs: None
+// Outputs: Frontend& - The terminal
+Frontend &Frontend::terminal() {
+    static TerminalFrontend terminalFrontend;
+    return terminalFrontend;
+}
+
+// Creates a terminal frontend
+// What it does: Reads keys from keySource, or from the terminal if none is given
+// Inputs: keySource - Source of key presses, may be nullptr
+// Outputs: None (constructor)
+TerminalFrontend::TerminalFrontend(InputSource *keySource)
+    : keys(keySource ? keySource : &terminalKeys), rawMode(false), columns(0) {
+}
+
+// Gets the output stream
+// What it does: Returns std::cout
+// Inputs: None
+// Outputs: ostream& - Standard output
+ostream &TerminalFrontend::out() {
+    return cout;
+}
+
+// Shows a full-screen frame
+// What it does: Flushes text still buffered in cout (it belongs before the frame), then
+//               writes the whole frame with as few write() calls as possible
+// Inputs: frame - Bytes of the frame
+// Outputs: None
+void TerminalFrontend::showFrame(const string &frame) {
+    cout.flush();
+    size_t written = 0;
+    while (written < frame.size()) {
+        ssize_t result = write(STDOUT_FILENO, frame.data() + written, frame.size() - written);
+        if (result < 0 && errno == EINTR) continue;
+        if (result <= 0) break;
+        written += static_cast<size_t>(result);
+    }
+}
+
+// Gets the terminal width
+// What it does: Asks the terminal once with ioctl and caches the result; 80 if stdout is no terminal
+// Inputs: None
+// Outputs: int - Width in columns
+int TerminalFrontend::width() {
+    if (columns == 0) {
+        struct winsize ws;
+        columns = ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != -1 && ws.ws_col > 0 ? ws.ws_col : 80;
+    }
+    return columns;
+}
+
+// Prepares the terminal for the game
+// What it does: Turns off line buffering and echo, so keys arrive as they are pressed
+// Inputs: None
+// Outputs: None
+void TerminalFrontend::open() {
+    if (rawMode || tcgetattr(STDIN_FILENO, &originalTermios) != 0) return;
+    struct termios newTermios = originalTermios;
+    newTermios.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(STDIN_FILENO, TCSANOW, &newTermios);
+    rawMode = true;
+}
+
+// Gives the terminal back
+// What it does: Restores the settings open() replaced
+// Inputs: None
+// Outputs: None
+void TerminalFrontend::close() {
+    if (!rawMode) return;
+    tcsetattr(STDIN_FILENO, TCSANOW, &originalTermios);
+    rawMode = false;
+}
+
+// Creates a headless frontend
+// What it does: Sets up an output stream without a buffer and remembers the key source
+// Inputs: keySource - Source of every decision, e.g. a BotInputSource
+// Outputs: None (constructor)
+NullFrontend::NullFrontend(InputSource &keySource) : sink(nullptr), keys(keySource) {
+}
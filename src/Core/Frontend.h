@@ -0,0 +1,88 @@
+// Frontend.h - What the game draws to and takes its decisions from
+#ifndef FRONTEND_H
+#define FRONTEND_H
+
+#include "InputSource.h"
+#include <ostream>
+#include <string>
+#include <termios.h>
+
+// Every screen, message and prompt of a game goes through one Frontend: text is written
+// to out(), full-screen frames to showFrame(), and every decision is read as key presses
+// from input(). A Game plays on the frontend of its GameSession; InputSystem, UISystem and
+// the modules' output reach it through Frontend::current().
+class Frontend {
+private:
+    int peekedKey;  // Key taken by peekKey() and not yet returned, -1 if none
+
+public:
+    Frontend() : peekedKey(-1) {}
+    virtual ~Frontend() {}
+
+    // Stream for everything the game prints
+    virtual std::ostream &out() = 0;
+
+    // Shows a composed full-screen frame (escape sequences included) in one piece
+    virtual void showFrame(const std::string &frame) = 0;
+
+    // Where key presses come from
+    virtual InputSource &input() = 0;
+
+    // True if a person is watching: delays are kept and typed digits echoed
+    virtual bool isInteractive() { return input().isInteractive(); }
+
+    // Columns available for separators and centered titles
+    virtual int width() { return 80; }
+
+    // Called when a game binds and releases the frontend, e.g. to switch terminal modes
+    virtual void open() {}
+    virtual void close() {}
+
+    // Returns the next key as an unsigned char value, or -1 on timeout or end of input;
+    // a key kept by peekKey() comes first
+    int nextKey(int timeoutMs);
+
+    // Checks for a key without waiting, keeping it for nextKey()
+    bool peekKey();
+
+    // The frontend of the current game session (see GameSession::current())
+    static Frontend &current();
+
+    // The process's terminal, for sessions created without a frontend
+    static Frontend &terminal();
+};
+
+// Text on stdout and keys from the terminal, or from another source such as a script
+class TerminalFrontend : public Frontend {
+private:
+    TerminalInputSource terminalKeys;
+    InputSource *keys;
+    struct termios originalTermios;
+    bool rawMode;   // True while the terminal is switched to unbuffered, silent input
+    int columns;    // Terminal width, read once; 0 until then
+
+public:
+    explicit TerminalFrontend(InputSource *keySource = nullptr);
+    std::ostream &out() override;
+    void showFrame(const std::string &frame) override;
+    InputSource &input() override { return *keys; }
+    int width() override;
+    void open() override;
+    void close() override;
+};
+
+// Throws all output away and takes its decisions from a script or bot source,
+// for headless runs inside a simulation harness
+class NullFrontend : public Frontend {
+private:
+    std::ostream sink;  // Has no buffer, so every write is dropped before it is formatted
+    InputSource &keys;
+
+public:
+    explicit NullFrontend(InputSource &keySource);
+    std::ostream &out() override { return sink; }
+    void showFrame(const std::string &) override {}
+    InputSource &input() override { return keys; }
+};
+
+#endif
@@ -9,29 +9,44 @@
 #include "Config.h"
 #include "../Combat/combat.h"
 #include "UISystem.h"
+#include "Frontend.h"
 #include <iostream>
+#include <ctime>
 using namespace std;
 
 // Define constants declared in Config.h
 const char* SAVE_FILE_NAME = "savegame.dat";
 
-// Constructor: Initializes game state and modules
-// What it does: Sets up initial game state and calls module initialization
+// Constructor: Initializes game state and modules on the current frontend
+// What it does: Plays on the frontend of the current session, the terminal unless one is bound
 // Inputs: None
 // Outputs: None (constructor)
-Game::Game() : currentState(MAIN_MENU), currentDay(1),
+Game::Game() : Game(Frontend::current()) {
+}
+
+// Constructor: Initializes game state and modules on a given frontend
+// What it does: Creates the game's own session on gameFrontend and binds it to this thread, so
+//               all output, input, difficulty and saves of the game go through it, sets up
+//               initial game state and calls module initialization
+// Inputs: gameFrontend - Frontend to play on; must outlive the game
+// Outputs: None (constructor)
+Game::Game(Frontend& gameFrontend) : currentState(MAIN_MENU), currentDay(1),
                dayPhase(nullptr), nightPhase(nullptr),
                saveSystem(nullptr), market(nullptr),
-               map(nullptr), itemDB(nullptr), combat(nullptr) {
+               map(nullptr), itemDB(nullptr), combat(nullptr),
+               session(&gameFrontend), previousSession(GameSession::bind(&session)) {
     initializeModules();
 }
 
 // Destructor: Cleans up dynamically allocated modules
-// What it does: Deletes all module instances to prevent memory leaks
+// What it does: Deletes all module instances to prevent memory leaks and binds the session
+//               that was current before the game again; the game's session then finishes its
+//               queued saves
 // Inputs: None
 // Outputs: None (destructor)
 Game::~Game() {
     cleanupModules();
+    GameSession::bind(previousSession);
 }
 
 // Initializes all game modules and systems
@@ -40,7 +55,7 @@ Game::~Game() {
 // Outputs: None
 void Game::initializeModules() {
     // Initialize other modules
-    cout << "Initializing game modules..." << endl;
+    UISystem::out() << "Initializing game modules..." << endl;
 
     // Initialize core systems
     map = new Map();
@@ -53,6 +68,9 @@ void Game::initializeModules() {
     // Create market instance (for night phase)
     market = new Market();
 
+    // Create the session's combat system once; encounters reset and reuse it
+    combat = new Combat(&player, "Survivor", nullptr);
+
     // DayPhase will be created when actually used
     // because it needs dependencies from other modules
     dayPhase = nullptr;
@@ -74,35 +92,51 @@ void Game::cleanupModules() {
 }
 
 // Main game loop that runs the entire game
-// What it does: Initializes systems, handles game state transitions, and runs until game over
+// What it does: Initializes systems, handles game state transitions, and runs until game over,
+//               until the player saves and quits, or until the frontend's input ends
 // Inputs: None
 // Outputs: None
 void Game::run() {
     InputSystem::initialize();
     UISystem::showInfo("Game initialized successfully");
 
-    while (currentState != GAME_OVER) {
-        switch (currentState) {
-            case MAIN_MENU:
-                handleMainMenu();
-                break;
-            case DAY:
-                startDayPhase();
-                break;
-            case NIGHT:
-                startNightPhase();
-                break;
-            case COMBAT:
-                startCombatPhase();
-                break;
-            default:
-                break;
+    try {
+        while (currentState != GAME_OVER && currentState != QUIT) {
+            runState();
+            checkGameOver();
         }
+    } catch (const InputClosed&) {
+        UISystem::out() << "\nInput closed. Exiting..." << endl;
+        currentState = QUIT;
+    }
 
-        checkGameOver();
+    if (currentState == GAME_OVER) {
+        UISystem::out() << "GAME OVER" << endl;
     }
+    InputSystem::cleanup();
+}
 
-    cout << "GAME OVER" << endl;
+// Runs one step of the current game state
+// What it does: Dispatches to the menu or phase handler of the current state
+// Inputs: None
+// Outputs: None
+void Game::runState() {
+    switch (currentState) {
+        case MAIN_MENU:
+            handleMainMenu();
+            break;
+        case DAY:
+            startDayPhase();
+            break;
+        case NIGHT:
+            startNightPhase();
+            break;
+        case COMBAT:
+            startCombatPhase();
+            break;
+        default:
+            break;
+    }
 }
 
 // Sets the current game state
@@ -114,12 +148,13 @@ void Game::setState(GameState newState) {
 }
 
 // Advances the game to the next day
-// What it does: Increments day counter and displays day transition message
+// What it does: Increments day counter, displays day transition message and autosaves
 // Inputs: None
 // Outputs: None
 void Game::advanceDay() {
     currentDay++;
     UISystem::showInfo("DAY " + to_string(currentDay));
+    SaveSystem::journalGame(player, currentDay, market, map);
 }
 
 // Starts a new game with initial setup
@@ -129,6 +164,7 @@ void Game::advanceDay() {
 void Game::startNewGame() {
     // Reset player state
     player = Player();
+    SaveSystem::discardJournalState();
     currentDay = 1;
     currentState = DAY;
 
@@ -161,6 +197,7 @@ void Game::startNewGame() {
             break;
     }
     setGameDifficulty(difficulty);
+    map->generateDailyMap(currentDay);
 
     UISystem::startSection("NEW GAME START");
 
@@ -175,21 +212,55 @@ void Game::startNewGame() {
     UISystem::endSection();
 }
 
-// Loads a saved game from file
-// What it does: Checks for save file existence and loads player data and day
+// Loads a saved game from file or a save slot
+// What it does: Lists the save slots from the slot store's index, if there are any, and loads
+//               the chosen slot or the last game; otherwise loads the last game directly
 // Inputs: None
 // Outputs: bool - True if load successful, false otherwise
 bool Game::loadGame() {
     UISystem::startSection("LOAD GAME");
 
-    if (!SaveSystem::saveExists()) {
+    bool hasSave = SaveSystem::saveExists();
+    vector<SlotInfo> slots = SaveSystem::listSlots();
+    if (!hasSave && slots.empty()) {
         UISystem::showWarning("No save file found. Please start a new game first.");
         UISystem::endSection();
         return false;
     }
 
     int loadedDay = 1;
-    if (!SaveSystem::loadGame(player, loadedDay)) {
+    bool loaded = false;
+    if (slots.empty()) {
+        loaded = SaveSystem::loadGame(player, loadedDay, market, map);
+    } else {
+        const char* difficultyNames[] = { "Easy", "Normal", "Hard" };
+        if (hasSave) {
+            UISystem::out() << "[0] Continue last game" << endl;
+        }
+        for (const SlotInfo& slot : slots) {
+            char when[32] = "";
+            time_t timestamp = static_cast<time_t>(slot.timestamp);
+            strftime(when, sizeof(when), "%Y-%m-%d %H:%M", localtime(&timestamp));
+            const char* difficulty = slot.difficulty >= DIFFICULTY_EASY && slot.difficulty <= DIFFICULTY_HARD
+                                         ? difficultyNames[slot.difficulty] : "?";
+            UISystem::out() << "[" << (slot.slot + 1) << "] Day " << slot.day << ", HP " << slot.hp << ", $"
+                 << slot.money << ", " << difficulty << ", " << when << endl;
+        }
+        UISystem::out() << "Choose a save: ";
+        int choice = -1;
+        if (!InputSystem::readNumber(choice)) {
+            choice = -1;
+        }
+        if (choice == 0 && hasSave) {
+            loaded = SaveSystem::loadGame(player, loadedDay, market, map);
+        } else if (choice > 0) {
+            loaded = SaveSystem::loadFromSlot(choice - 1, player, loadedDay, market, map);
+        } else {
+            UISystem::showError("Invalid choice!");
+        }
+    }
+
+    if (!loaded) {
         UISystem::showError("Failed to load save data.");
         UISystem::endSection();
         return false;
@@ -202,15 +273,57 @@ bool Game::loadGame() {
 }
 
 // Saves the current game state to file
-// What it does: Serializes player data and current day to save file
+// What it does: Serializes player data and current day and hands them to the background save writer
 // Inputs: None
 // Outputs: None
 void Game::saveGame() {
     UISystem::startSection("SAVE GAME");
-    SaveSystem::saveGame(player, currentDay);
+    SaveSystem::saveGame(player, currentDay, market, map);
+    UISystem::showInfo("Saving in the background...");
     UISystem::endSection();
 }
 
+// Captures the whole game state in memory
+// What it does: Snapshots player, combat player, inventory, day, difficulty, market and map
+//               without touching the save file, cheap enough to call every turn
+// Inputs: None
+// Outputs: string - Snapshot for rollback()
+string Game::checkpoint() {
+    return SaveSystem::captureSnapshot(player, currentDay, market, map);
+}
+
+// Returns the game to a checkpoint
+// What it does: Restores everything checkpoint() captured
+// Inputs: snapshot - Result of an earlier checkpoint()
+// Outputs: bool - True if restored, false (game unchanged) if the snapshot is invalid
+bool Game::rollback(const string& snapshot) {
+    return SaveSystem::restoreSnapshot(snapshot, player, currentDay, market, map);
+}
+
+// Forks the whole game state in memory
+// What it does: Copies player, market, map, day and difficulty into a branch. The copies share
+//               inventory, combat player, market history and location templates with the game
+//               until one side changes them, so a fork costs little however long the game ran.
+// Inputs: None
+// Outputs: GameBranch - Independent state to simulate on
+GameBranch Game::fork() const {
+    GameBranch branch = { player, *market, *map, currentDay, getGameDifficulty() };
+    return branch;
+}
+
+// Makes a branch the game's state
+// What it does: Replaces player, market, map, day and difficulty with the branch's; the branch
+//               stays valid and keeps sharing unchanged parts with the game
+// Inputs: branch - Result of an earlier fork(), possibly changed since
+// Outputs: None
+void Game::adopt(const GameBranch& branch) {
+    player = branch.player;
+    *market = branch.market;
+    *map = branch.map;
+    currentDay = branch.day;
+    setGameDifficulty(branch.difficulty);
+}
+
 // Checks if game over conditions are met
 // What it does: Checks if player is dead and transitions to game over state if true
 // Inputs: None
@@ -230,17 +343,22 @@ void Game::checkGameOver() {
 // Inputs: None
 // Outputs: None
 void Game::startDayPhase() {
-    cout << "\n=== DAY " << currentDay << " : DAY TIME ===" << endl;
+    UISystem::out() << "\n=== DAY " << currentDay << " : DAY TIME ===" << endl;
 
-    // Generate daily map
-    map->generateDailyMap(currentDay);
+    // Generate daily map, unless a loaded save already holds today's
+    if (map->getGeneratedDay() != currentDay) {
+        map->generateDailyMap(currentDay);
+    }
 
     // Create DayPhase instance if not exists
     if (!dayPhase) {
-        dayPhase = new DayPhase(&player, map, itemDB);
+        dayPhase = new DayPhase(&player, map, itemDB, combat, market);
     }
 
-    dayPhase->executeDay(currentDay);
+    if (!dayPhase->executeDay(currentDay)) {
+        currentState = QUIT;
+        return;
+    }
 
     // After day phase, automatically transition to night
     currentState = NIGHT;
@@ -251,13 +369,16 @@ void Game::startDayPhase() {
 // Inputs: None
 // Outputs: None
 void Game::startNightPhase() {
-    cout << "\n=== DAY " << currentDay << " : NIGHT TIME ===" << endl;
+    UISystem::out() << "\n=== DAY " << currentDay << " : NIGHT TIME ===" << endl;
 
     // Display player status
     player.displayInventory();
 
     // Use our created market instance
-    NightPhase::executeNight(player, market, currentDay);
+    if (!NightPhase::executeNight(player, market, currentDay)) {
+        currentState = QUIT;
+        return;
+    }
 
     // Advance to next day
     advanceDay();
@@ -274,7 +395,7 @@ void Game::startNightPhase() {
 // Inputs: None
 // Outputs: None
 void Game::startCombatPhase() {
-    cout << "\n=== COMBAT PHASE ===" << endl;
+    UISystem::out() << "\n=== COMBAT PHASE ===" << endl;
 
     // Initialize combat player if not already done
     if (!player.getCombatPlayer()) {
@@ -283,12 +404,8 @@ void Game::startCombatPhase() {
 
     Item* bestWeapon = player.getBestWeapon();
 
-    // Create combat instance
-    if (!combat) {
-        combat = new Combat(&player, "Player", bestWeapon);
-    } else {
-        combat->equipWeapon(bestWeapon);
-    }
+    // Reuse the session's combat instance
+    combat->prepareEncounter(bestWeapon);
 
     // Start combat with first enemy
     combat->fightEnemy(0);
@@ -4,17 +4,28 @@
 
 #include "Common.h"
 #include "Player.h"
+#include "../Night/Market.h"
+#include "../Map/Map.h"
+#include "GameSession.h"
 using namespace std;
 
 // 前向声明其他模块
 class DayPhase;
 class NightPhase;
 class SaveSystem;
-class Market;
-class Map;
 class ItemDatabase;
 class Combat;
 
+// 游戏状态的一个分支,用于"如果这样做会怎样"的推演
+// 复制时与原游戏共享背包、战斗状态、市场历史和地点模板,哪一方先修改哪一部分才复制那一部分
+struct GameBranch {
+    Player player;
+    Market market;
+    Map map;
+    int day;
+    int difficulty;
+};
+
 class Game {
 private:
     Player player;
@@ -30,17 +41,24 @@ private:
     ItemDatabase* itemDB;
     Combat* combat;
 
+    // 本局游戏的会话(前端、难度、存档文件),以及构造前绑定到本线程的会话(析构时恢复)
+    // 每局游戏各有一个会话,所以多局游戏可以在不同线程上同时运行;需在同一线程上创建、运行和销毁
+    GameSession session;
+    GameSession* previousSession;
+
     // 初始化方法
     void initializeModules();
     void cleanupModules();
 
 public:
     // 构造函数和析构函数
-    Game();
+    Game();                                     // 使用当前前端(默认为终端)
+    explicit Game(Frontend& gameFrontend);      // 例如无界面模拟用的 NullFrontend
     ~Game();
 
     // 主游戏循环
     void run();
+    void runState();                            // 执行当前状态的一步
 
     // 状态管理
     void setState(GameState newState);
@@ -57,6 +75,10 @@ public:
     void startNewGame();
     bool loadGame();
     void saveGame();
+    string checkpoint();                        // 内存快照,用于回滚
+    bool rollback(const string& snapshot);      // 恢复到 checkpoint() 的状态
+    GameBranch fork() const;                    // 内存分支,开销只与之后修改的部分有关
+    void adopt(const GameBranch& branch);       // 采用分支的状态
     void checkGameOver();
 
     // 阶段切换
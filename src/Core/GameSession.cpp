@@ -0,0 +1,73 @@
+// GameSession.cpp - Per-game state and its binding to threads
+#include "GameSession.h"
+#include "Config.h"
+#include "../Night/Market.h"
+
+using namespace std;
+
+thread_local GameSession *GameSession::bound = nullptr;
+
+// Creates a session
+// What it does: Starts on normal difficulty with the default save files
+// Inputs: sessionFrontend - Frontend for output and input, nullptr for the terminal
+// Outputs: None (constructor)
+GameSession::GameSession(Frontend *sessionFrontend)
+    : frontend(sessionFrontend), difficulty(DIFFICULTY_NORMAL) {
+}
+
+// Destroys a session
+// What it does: Releases the night market; the save state finishes its queued writes
+// Inputs: None
+// Outputs: None (destructor)
+GameSession::~GameSession() {
+}
+
+// Gets the session's frontend
+// What it does: Returns the frontend given to the constructor, or the terminal if none was
+// Inputs: None
+// Outputs: Frontend& - Where output and input go
+Frontend &GameSession::getFrontend() {
+    return frontend ? *frontend : Frontend::terminal();
+}
+
+// Sets the difficulty without generating error
+// What it does: Ignores values that are no difficulty
+// Inputs: newDifficulty - DIFFICULTY_EASY, DIFFICULTY_NORMAL or DIFFICULTY_HARD
+// Outputs: None
+void GameSession::setDifficulty(int newDifficulty) {
+    if (newDifficulty >= DIFFICULTY_EASY && newDifficulty <= DIFFICULTY_HARD) {
+        difficulty = newDifficulty;
+    }
+}
+
+// Gets the market for nights started without one
+// What it does: Creates the market on first use and keeps it for the rest of the session
+// Inputs: None
+// Outputs: Market& - The session's night market
+Market &GameSession::getNightMarket() {
+    if (!nightMarket) {
+        nightMarket.reset(new Market());
+    }
+    return *nightMarket;
+}
+
+// Gets the current session
+// What it does: Returns the session bound to the calling thread, or the thread's default
+//               session, created on first use and destroyed when the thread ends
+// Inputs: None
+// Outputs: GameSession& - Session of the game running on this thread
+GameSession &GameSession::current() {
+    if (bound) return *bound;
+    static thread_local GameSession threadDefault;
+    return threadDefault;
+}
+
+// Binds a session to the calling thread
+// What it does: Makes session the current one of this thread only
+// Inputs: session - Session to use, nullptr for the thread's default session
+// Outputs: GameSession* - The session bound before, to restore later
+GameSession *GameSession::bind(GameSession *session) {
+    GameSession *previous = bound;
+    bound = session;
+    return previous;
+}
@@ -0,0 +1,54 @@
+// GameSession.h - Everything one game changes outside its player, market and map
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include "Frontend.h"
+#include "../Save/SaveSystem.h"
+#include <memory>
+
+class Market;  // Defined in Night/Market.h
+
+// The state a running game used to keep in process-wide globals: its frontend, difficulty,
+// save files and journal, and the market of nights started without one. Each Game owns a
+// session and binds it to its thread for as long as it exists, so games on separate threads
+// never share any of it. The item catalog is immutable and shared by every session.
+//
+// Subsystems reach the session of their game through GameSession::current().
+class GameSession {
+private:
+    static thread_local GameSession *bound;
+
+    Frontend *frontend;                // nullptr: the terminal
+    int difficulty;                    // DIFFICULTY_EASY, DIFFICULTY_NORMAL or DIFFICULTY_HARD
+    SaveSession saves;
+    std::unique_ptr<Market> nightMarket;  // Created when a night needs it
+
+public:
+    explicit GameSession(Frontend *sessionFrontend = nullptr);
+    ~GameSession();
+    GameSession(const GameSession &) = delete;
+    GameSession &operator=(const GameSession &) = delete;
+
+    // Where the session's output and input go
+    Frontend &getFrontend();
+
+    // Difficulty of the session's game
+    int getDifficulty() const { return difficulty; }
+    void setDifficulty(int newDifficulty);
+
+    // Save files, journaled state and background writer (used by SaveSystem)
+    SaveSession &getSaveSession() { return saves; }
+
+    // Market for a night started without one
+    Market &getNightMarket();
+
+    // The session bound to the calling thread; a thread that never bound one gets its own
+    // default session, playing on the terminal
+    static GameSession &current();
+
+    // Binds session to the calling thread (nullptr for the thread's default session) and
+    // returns the session bound before, to restore later
+    static GameSession *bind(GameSession *session);
+};
+
+#endif
@@ -0,0 +1,130 @@
+// InputSource.cpp - Terminal, script and bot key sources
+#include "InputSource.h"
+#include <unistd.h>
+#include <poll.h>
+#include <cerrno>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+// Creates a terminal source with an empty key queue
+// What it does: Initializes the queue indices
+// Inputs: None
+// Outputs: None
+TerminalInputSource::TerminalInputSource()
+    : queueHead(0), queueCount(0), inputClosed(false) {
+}
+
+// Waits for input and moves every pending byte into the key queue
+// What it does: Sleeps in poll() until stdin is readable or the timeout expires,
+//               then reads all available keys with a single read()
+// Inputs: timeoutMs - Milliseconds to wait, 0 to only check, -1 to wait forever
+// Outputs: bool - True if at least one key was queued, false on timeout or closed input
+bool TerminalInputSource::fillKeyQueue(int timeoutMs) {
+    if (inputClosed) return false;
+
+    struct pollfd pfd;
+    pfd.fd = STDIN_FILENO;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int ready = poll(&pfd, 1, timeoutMs);
+    while (ready < 0 && errno == EINTR) {
+        ready = poll(&pfd, 1, timeoutMs);
+    }
+    if (ready <= 0) return false;
+
+    char buffer[KEY_QUEUE_SIZE];
+    int space = KEY_QUEUE_SIZE - queueCount;
+    if (space <= 0) return true;
+    ssize_t bytes = read(STDIN_FILENO, buffer, space);
+    if (bytes <= 0) {
+        // Readable but nothing read means end of input
+        if (bytes == 0 || errno != EAGAIN) inputClosed = true;
+        return false;
+    }
+    for (ssize_t i = 0; i < bytes; ++i) {
+        keyQueue[(queueHead + queueCount) % KEY_QUEUE_SIZE] = buffer[i];
+        queueCount++;
+    }
+    return true;
+}
+
+// Returns the next key typed on the terminal
+// What it does: Takes the next queued key, blocking in poll() (no CPU use) until one arrives
+// Inputs: timeoutMs - Milliseconds to wait, 0 to only check, -1 to wait forever
+// Outputs: int - The key as an unsigned char value, or -1 on timeout or closed input
+int TerminalInputSource::nextKey(int timeoutMs) {
+    if (queueCount == 0 && !fillKeyQueue(timeoutMs)) {
+        return -1;
+    }
+    unsigned char key = static_cast<unsigned char>(keyQueue[queueHead]);
+    queueHead = (queueHead + 1) % KEY_QUEUE_SIZE;
+    queueCount--;
+    return key;
+}
+
+// Creates a source that replays the given keys
+// What it does: Stores the keys and starts at the first one
+// Inputs: scriptKeys - Keys to replay, in order
+// Outputs: None
+ScriptInputSource::ScriptInputSource(const string &scriptKeys)
+    : keys(scriptKeys), position(0) {
+}
+
+// Reads a whole script file into memory
+// What it does: Loads every byte of the file, newlines included, as keys
+// Inputs: path - Script file path
+//         scriptKeys - Receives the file content
+// Outputs: bool - True if the file could be read, false otherwise
+bool ScriptInputSource::loadFile(const string &path, string &scriptKeys) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+    ostringstream content;
+    content << file.rdbuf();
+    scriptKeys = content.str();
+    return true;
+}
+
+// Returns the next key of the script
+// What it does: Hands out the script one byte at a time; there is never anything to wait for
+// Inputs: timeoutMs - Ignored, a script is always ready or finished
+// Outputs: int - The key as an unsigned char value, or -1 once the script is finished
+int ScriptInputSource::nextKey(int timeoutMs) {
+    (void)timeoutMs;
+    if (position >= keys.size()) return -1;
+    return static_cast<unsigned char>(keys[position++]);
+}
+
+// Creates a bot source with no keys
+// What it does: Initializes the key buffer
+// Inputs: None
+// Outputs: None
+BotInputSource::BotInputSource() : position(0) {
+}
+
+// Queues keys for the game to read
+// What it does: Appends keys after the ones not read yet, dropping the ones already read
+// Inputs: keys - Keys to queue
+// Outputs: None
+void BotInputSource::push(const string &keys) {
+    if (position > 0) {
+        pending.erase(0, position);
+        position = 0;
+    }
+    pending += keys;
+}
+
+// Returns the next key chosen by the bot
+// What it does: Asks refill() for more keys when the buffer is empty
+// Inputs: timeoutMs - Ignored, the bot answers immediately
+// Outputs: int - The key as an unsigned char value, or -1 if the bot has nothing more to say
+int BotInputSource::nextKey(int timeoutMs) {
+    (void)timeoutMs;
+    if (position >= pending.size()) {
+        refill();
+        if (position >= pending.size()) return -1;
+    }
+    return static_cast<unsigned char>(pending[position++]);
+}
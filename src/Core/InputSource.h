@@ -0,0 +1,67 @@
+// InputSource.h - Where the game's key presses come from
+#ifndef INPUTSOURCE_H
+#define INPUTSOURCE_H
+
+#include <string>
+
+// A stream of key presses. InputSystem reads every key through the current source,
+// so the game can be driven by the terminal, a script file or a bot.
+class InputSource {
+public:
+    virtual ~InputSource() {}
+
+    // Returns the next key as an unsigned char value, or -1 on timeout or end of input.
+    // timeoutMs: 0 only checks, -1 waits as long as needed
+    virtual int nextKey(int timeoutMs) = 0;
+
+    // True if a person is typing: input is echoed and delays are kept
+    virtual bool isInteractive() const { return false; }
+};
+
+// Keys typed on the terminal, read with poll() + read() into a small queue
+class TerminalInputSource : public InputSource {
+private:
+    static const int KEY_QUEUE_SIZE = 64;
+    char keyQueue[KEY_QUEUE_SIZE];
+    int queueHead;
+    int queueCount;
+    bool inputClosed;
+
+    bool fillKeyQueue(int timeoutMs);
+
+public:
+    TerminalInputSource();
+    int nextKey(int timeoutMs) override;
+    bool isInteractive() const override { return true; }
+};
+
+// Keys replayed from memory, loaded from a script file or given as a string
+class ScriptInputSource : public InputSource {
+private:
+    std::string keys;
+    size_t position;
+
+public:
+    explicit ScriptInputSource(const std::string &scriptKeys);
+    static bool loadFile(const std::string &path, std::string &scriptKeys);
+    int nextKey(int timeoutMs) override;
+};
+
+// Keys pushed by a bot. When the buffer runs dry, refill() is asked for more,
+// so a bot subclass can look at the game state and answer the next prompt.
+class BotInputSource : public InputSource {
+private:
+    std::string pending;
+    size_t position;
+
+protected:
+    // Override to push() the next keys; leaving the buffer empty ends the input
+    virtual void refill() {}
+
+public:
+    BotInputSource();
+    void push(const std::string &keys);
+    int nextKey(int timeoutMs) override;
+};
+
+#endif
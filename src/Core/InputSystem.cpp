@@ -1,83 +1,110 @@
 // InputSystem.cpp - Unified input handling system implementation
 #include "InputSystem.h"
+#include "UISystem.h"
 #include <iostream>
 #include <unistd.h>
-#include <sys/ioctl.h>
 #include <cstdlib>
 #include <cstdio>
 
 using namespace std;
 
-// Static member initialization
-struct termios InputSystem::originalTermios;
-bool InputSystem::isInitialized = false;
-int InputSystem::terminalWidth = 80;
-bool InputSystem::widthCalculated = false;
-
-// Initializes the input system for non-blocking input
-// What it does: Sets up terminal for non-blocking input mode
+// Prepares the frontend for input
+// What it does: Lets the current frontend set up its input (raw mode on a terminal)
 // Inputs: None
 // Outputs: None
 void InputSystem::initialize() {
-    if (!isInitialized) {
-        setNonBlockingInput();
-        isInitialized = true;
-    }
+    Frontend::current().open();
 }
 
-// Cleans up the input system and restores terminal settings
-// What it does: Restores original terminal settings to prevent terminal corruption
+// Gives the frontend's input back
+// What it does: Undoes initialize(), restoring the terminal settings
 // Inputs: None
 // Outputs: None
 void InputSystem::cleanup() {
-    if (isInitialized) {
-        restoreTerminal();
-        isInitialized = false;
-    }
+    Frontend::current().close();
 }
 
-// Configures terminal for non-blocking input mode
-// What it does: Disables canonical mode and echo to allow immediate key detection
+// Tells whether a person is at the keyboard
+// What it does: Asks the current frontend; scripts and bots are not interactive
 // Inputs: None
-// Outputs: None
-void InputSystem::setNonBlockingInput() {
-    struct termios newTermios;
-    tcgetattr(STDIN_FILENO, &originalTermios);
-    newTermios = originalTermios;
-    newTermios.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newTermios);
-}
-
-// Restores original terminal settings
-// What it does: Returns terminal to its original state after non-blocking mode
-// Inputs: None
-// Outputs: None
-void InputSystem::restoreTerminal() {
-    tcsetattr(STDIN_FILENO, TCSANOW, &originalTermios);
+// Outputs: bool - True when reading from the terminal
+bool InputSystem::isInteractive() {
+    return Frontend::current().isInteractive();
 }
 
 // Checks if a key has been pressed (non-blocking)
-// What it does: Returns true if a key is available to read, false otherwise
+// What it does: Returns true if a key is waiting, keeping it for the next read
 // Inputs: None
 // Outputs: bool - True if key pressed, false otherwise
 bool InputSystem::kbhit() {
-    struct timeval tv = {0L, 0L};
-    fd_set fds;
-    FD_ZERO(&fds);
-    FD_SET(STDIN_FILENO, &fds);
-    return select(STDIN_FILENO + 1, &fds, NULL, NULL, &tv) > 0;
+    return Frontend::current().peekKey();
 }
 
 // Gets a single character from input (non-blocking)
-// What it does: Reads one character from stdin without waiting
+// What it does: Takes the next key without waiting
 // Inputs: None
 // Outputs: char - The character read, or 0 if no character available
 char InputSystem::getch() {
-    char ch = 0;
-    if (read(STDIN_FILENO, &ch, 1) != 1) {
-        ch = 0;
+    int key = waitForKey(0);
+    return key < 0 ? 0 : static_cast<char>(key);
+}
+
+// Waits for the next key press with an optional timeout
+// What it does: Returns the key kept by kbhit() or the next key of the current frontend
+// Inputs: timeoutMs - Milliseconds to wait, 0 to only check, -1 to wait forever
+// Outputs: int - The key as an unsigned char value, or -1 on timeout or closed input
+int InputSystem::waitForKey(int timeoutMs) {
+    return Frontend::current().nextKey(timeoutMs);
+}
+
+// Blocks until a key is pressed
+// What it does: Waits without a timeout and returns the key. If the input has ended no key
+//               can ever arrive, so InputClosed is thrown for Game::run() to end the game.
+// Inputs: None
+// Outputs: char - The key pressed
+char InputSystem::readKey() {
+    int key = waitForKey(-1);
+    if (key < 0) {
+        throw InputClosed();
+    }
+    return static_cast<char>(key);
+}
+
+// Reads a whole number typed by the player
+// What it does: Reads keys through the current source until Enter, so numbers and single keys
+//               come from the same queue. Leading blanks and empty lines are skipped, digits are
+//               echoed on the terminal and Backspace erases the last one.
+// Inputs: value - Receives the number
+// Outputs: bool - True if a valid number was entered, false if the line held anything else
+bool InputSystem::readNumber(int &value) {
+    const bool echo = isInteractive();
+    UISystem::out() << flush;  // Show the prompt before waiting
+    string line;
+    bool valid = true;
+    char key = readKey();
+    while (key == '\n' || key == '\r' || key == ' ') {
+        key = readKey();
+    }
+    while (key != '\n' && key != '\r') {
+        if ((key == 127 || key == '\b') && echo) {
+            if (!line.empty()) {
+                line.erase(line.size() - 1);
+                UISystem::out() << "\b \b" << flush;
+            }
+        } else {
+            bool digit = key >= '0' && key <= '9';
+            bool sign = key == '-' && line.empty();
+            if (!digit && !sign) valid = false;
+            line += key;
+            if (echo) UISystem::out() << key << flush;
+        }
+        key = readKey();
     }
-    return ch;
+    if (echo) UISystem::out() << endl;
+
+    if (!valid || line.empty() || line == "-" || line.size() > 9) return false;
+    value = atoi(line.c_str());
+    return true;
 }
 
 // Clears the terminal screen
@@ -85,23 +112,7 @@ char InputSystem::getch() {
 // Inputs: None
 // Outputs: None
 void InputSystem::clearScreen() {
-    cout << "\033[2J\033[H";
-}
-
-// Gets the current terminal dimensions
-// What it does: Queries terminal for rows and columns using ioctl
-// Inputs: rows - Reference to store number of rows
-//         cols - Reference to store number of columns
-// Outputs: None (updates parameters by reference)
-void InputSystem::getTerminalSize(int &rows, int &cols) {
-    struct winsize ws;
-    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != -1) {
-        rows = ws.ws_row;
-        cols = ws.ws_col;
-    } else {
-        rows = 24;
-        cols = 80;
-    }
+    UISystem::out() << "\033[2J\033[H";
 }
 
 // Draws a horizontal separator line
@@ -109,10 +120,7 @@ void InputSystem::getTerminalSize(int &rows, int &cols) {
 // Inputs: length - Length of separator, -1 for full terminal width
 // Outputs: None
 void InputSystem::drawSeparator(int length) {
-    if (length == -1) {
-        length = getTerminalWidth();
-    }
-    cout << string(length, '=') << endl;
+    UISystem::out() << formatSeparator(length) << endl;
 }
 
 // Draws a centered title with bold formatting
@@ -120,25 +128,38 @@ void InputSystem::drawSeparator(int length) {
 // Inputs: title - The title text to display
 // Outputs: None
 void InputSystem::drawTitle(const string &title) {
+    UISystem::out() << formatTitle(title) << endl;
+}
+
+// Builds a horizontal separator line without printing it
+// What it does: Returns a line of '=' characters, defaults to terminal width
+// Inputs: length - Length of separator, -1 for full terminal width
+// Outputs: string - The separator line, without newline
+string InputSystem::formatSeparator(int length) {
+    if (length == -1) {
+        length = getTerminalWidth();
+    }
+    return string(length, '=');
+}
+
+// Builds a centered bold title without printing it
+// What it does: Pads the title to the middle of the terminal and applies bold formatting
+// Inputs: title - The title text
+// Outputs: string - The formatted title line, without newline
+string InputSystem::formatTitle(const string &title) {
     int width = getTerminalWidth();
-    int padding = (width - title.length()) / 2;
+    int padding = (width - static_cast<int>(title.length())) / 2;
     if (padding < 0) padding = 0;
 
-    cout << string(padding, ' ') << BOLD << title << RESET << endl;
+    return string(padding, ' ') + BOLD + title + RESET;
 }
 
-// Gets the current terminal width (cached)
-// What it does: Returns terminal width, calculates once and caches result
+// Gets the current terminal width
+// What it does: Asks the current frontend, which caches the terminal's width
 // Inputs: None
 // Outputs: int - Terminal width in characters
 int InputSystem::getTerminalWidth() {
-    if (!widthCalculated) {
-        int rows, cols;
-        getTerminalSize(rows, cols);
-        terminalWidth = cols;
-        widthCalculated = true;
-    }
-    return terminalWidth;
+    return Frontend::current().width();
 }
 
 // Waits for any key press to continue
@@ -146,17 +167,16 @@ int InputSystem::getTerminalWidth() {
 // Inputs: None
 // Outputs: None
 void InputSystem::waitForAnyKey() {
-    cout << YELLOW << "Press any key to continue..." << RESET << endl;
-    while (!kbhit()) {
-        sleepMs(100);
-    }
-    getch(); // Clear the key press
+    UISystem::out() << YELLOW << "Press any key to continue..." << RESET << endl;
+    readKey(); // Consume the key press
 }
 
 // Sleeps for specified milliseconds
-// What it does: Pauses execution for the given time using usleep
+// What it does: Pauses execution for the given time using usleep. Scripted and bot
+//               input skip the pause, since nobody is reading the screen.
 // Inputs: ms - Number of milliseconds to sleep
 // Outputs: None
 void InputSystem::sleepMs(int ms) {
+    if (!isInteractive()) return;
     usleep(ms * 1000);
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #define INPUTSYSTEM_H
 
 #include <string>
-#include <termios.h>
+#include "Frontend.h"
 
 // ANSI escape sequences for colors
 #define RESET "\033[0m"
@@ -16,27 +16,29 @@
 #define WHITE "\033[37m"
 #define BOLD "\033[1m"
 
-class InputSystem {
-private:
-    static struct termios originalTermios;
-    static bool isInitialized;
-    static int terminalWidth;
-    static bool widthCalculated;
+// Thrown by readKey() when the input has ended and no key can ever arrive; Game::run()
+// catches it and ends the game
+struct InputClosed {};
 
+// Keys and terminal display of the current frontend (see Frontend.h)
+class InputSystem {
 public:
     // Input methods
     static void initialize();
     static void cleanup();
-    static void setNonBlockingInput();
-    static void restoreTerminal();
     static bool kbhit();
     static char getch();
+    static int waitForKey(int timeoutMs = -1);
+    static char readKey();
+    static bool readNumber(int &value);
+    static bool isInteractive();
 
     // Terminal display methods
     static void clearScreen();
-    static void getTerminalSize(int &rows, int &cols);
     static void drawSeparator(int length = -1);
     static void drawTitle(const std::string &title);
+    static std::string formatSeparator(int length = -1);
+    static std::string formatTitle(const std::string &title);
     static int getTerminalWidth();
 
     // Utility methods
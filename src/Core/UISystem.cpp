@@ -6,6 +6,14 @@
 
 using namespace std;
 
+// Gets the game's output stream
+// What it does: Returns the current frontend's stream, stdout unless a game bound another frontend
+// Inputs: None
+// Outputs: ostream& - Stream for game text
+ostream& UISystem::out() {
+    return Frontend::current().out();
+}
+
 // Displays a menu with title and options
 // What it does: Clears screen, shows centered title, and lists numbered options
 // Inputs: title - Menu title text
@@ -17,7 +25,7 @@ void UISystem::showMenu(const string& title, const vector<string>& options) {
     InputSystem::drawSeparator();
 
     for (size_t i = 0; i < options.size(); ++i) {
-        cout << " " << BRIGHT_CYAN << "[" << (i + 1) << "]" << RESET << " " << options[i] << endl;
+        UISystem::out() << " " << BRIGHT_CYAN << "[" << (i + 1) << "]" << RESET << " " << options[i] << endl;
     }
 
     InputSystem::drawSeparator();
@@ -30,20 +38,17 @@ void UISystem::showMenu(const string& title, const vector<string>& options) {
 // Outputs: int - Selected option number (1-based)
 int UISystem::getMenuChoice(const string& title, const vector<string>& options) {
     showMenu(title, options);
-    cout << STATUS_INFO << "Use number keys to select an option" << RESET << endl;
+    UISystem::out() << STATUS_INFO << "Use number keys to select an option" << RESET << endl;
 
     while (true) {
-        if (InputSystem::kbhit()) {
-            char key = InputSystem::getch();
-            int choice = key - '0';
+        char key = InputSystem::readKey();
+        int choice = key - '0';
 
-            if (choice >= 1 && choice <= static_cast<int>(options.size())) {
-                return choice;
-            } else {
-                cout << STATUS_WARNING << "Invalid choice! Please select 1-" << options.size() << RESET << endl;
-            }
+        if (choice >= 1 && choice <= static_cast<int>(options.size())) {
+            return choice;
+        } else {
+            UISystem::out() << STATUS_WARNING << "Invalid choice! Please select 1-" << options.size() << RESET << endl;
         }
-        InputSystem::sleepMs(100);
     }
 }
 
@@ -55,31 +60,28 @@ int UISystem::getMenuChoice(const string& title, const vector<string>& options)
 // Outputs: int - Selected number, or -1 if 'q' pressed
 int UISystem::getNumericChoice(int min, int max, const string& prompt) {
     if (!prompt.empty()) {
-        cout << STATUS_INFO << prompt << RESET << endl;
+        UISystem::out() << STATUS_INFO << prompt << RESET << endl;
     }
 
     while (true) {
-        if (InputSystem::kbhit()) {
-            char key = InputSystem::getch();
+        char key = InputSystem::readKey();
 
-            if (key == 'q' || key == 'Q') {
-                return -1; // Quit signal
-            }
+        if (key == 'q' || key == 'Q') {
+            return -1; // Quit signal
+        }
 
-            if (isdigit(key)) {
-                int choice = key - '0';
+        if (isdigit(key)) {
+            int choice = key - '0';
 
-                // Handle multi-digit numbers
-                if (choice >= min && choice <= max) {
-                    return choice;
-                } else {
-                    cout << STATUS_WARNING << "Please enter a number between " << min << " and " << max << RESET << endl;
-                }
+            // Handle multi-digit numbers
+            if (choice >= min && choice <= max) {
+                return choice;
             } else {
-                cout << STATUS_WARNING << "Please enter a valid number" << RESET << endl;
+                UISystem::out() << STATUS_WARNING << "Please enter a number between " << min << " and " << max << RESET << endl;
             }
+        } else {
+            UISystem::out() << STATUS_WARNING << "Please enter a valid number" << RESET << endl;
         }
-        InputSystem::sleepMs(100);
     }
 }
 
@@ -92,14 +94,14 @@ int UISystem::getNumericChoice(int min, int max, const string& prompt) {
 //         money - Current money amount
 // Outputs: None
 void UISystem::showStatusBar(int hp, int maxHp, int stamina, int maxStamina, int money) {
-    cout << BOLD << "=== PLAYER STATUS ===" << RESET << endl;
+    UISystem::out() << BOLD << "=== PLAYER STATUS ===" << RESET << endl;
 
     string healthColor = (hp > maxHp * 0.6) ? GREEN : (hp > maxHp * 0.3) ? YELLOW : RED;
     string staminaColor = (stamina > maxStamina * 0.5) ? GREEN : (stamina > maxStamina * 0.2) ? YELLOW : RED;
 
-    cout << "Health:   " << healthColor << createHealthBar(hp, maxHp) << " " << hp << "/" << maxHp << " HP" << RESET << endl;
-    cout << "Stamina:  " << staminaColor << createStaminaBar(stamina, maxStamina) << " " << stamina << "/" << maxStamina << RESET << endl;
-    cout << "Money:    " << BRIGHT_YELLOW << formatCurrency(money) << RESET << endl;
+    UISystem::out() << "Health:   " << healthColor << createHealthBar(hp, maxHp) << " " << hp << "/" << maxHp << " HP" << RESET << endl;
+    UISystem::out() << "Stamina:  " << staminaColor << createStaminaBar(stamina, maxStamina) << " " << stamina << "/" << maxStamina << RESET << endl;
+    UISystem::out() << "Money:    " << BRIGHT_YELLOW << formatCurrency(money) << RESET << endl;
 
     InputSystem::drawSeparator();
 }
@@ -109,7 +111,7 @@ void UISystem::showStatusBar(int hp, int maxHp, int stamina, int maxStamina, int
 // Inputs: None
 // Outputs: None
 void UISystem::showInventoryHeader() {
-    cout << BOLD << BRIGHT_CYAN << "=== INVENTORY ===" << RESET << endl;
+    UISystem::out() << BOLD << BRIGHT_CYAN << "=== INVENTORY ===" << RESET << endl;
 }
 
 // Displays a single inventory item entry
@@ -121,13 +123,13 @@ void UISystem::showInventoryHeader() {
 void UISystem::showItemEntry(const string& itemName, int quantity, const string& description) {
     string quantityColor = (quantity > 0) ? GREEN : RED;
 
-    cout << "  " << BRIGHT_WHITE << itemName << RESET;
-    cout << " x" << quantityColor << quantity << RESET;
+    UISystem::out() << "  " << BRIGHT_WHITE << itemName << RESET;
+    UISystem::out() << " x" << quantityColor << quantity << RESET;
 
     if (!description.empty()) {
-        cout << " - " << CYAN << description << RESET;
+        UISystem::out() << " - " << CYAN << description << RESET;
     }
-    cout << endl;
+    UISystem::out() << endl;
 }
 
 // Displays trade information for an item
@@ -138,14 +140,14 @@ void UISystem::showItemEntry(const string& itemName, int quantity, const string&
 //         customer - Customer name (optional)
 // Outputs: None
 void UISystem::showTradeInfo(const string& item, int price, int quantity, const string& customer) {
-    cout << "  " << BRIGHT_WHITE << item << RESET;
-    cout << " | Price: " << BRIGHT_YELLOW << formatCurrency(price) << RESET;
-    cout << " | Qty: " << (quantity > 0 ? GREEN : RED) << quantity << RESET;
+    UISystem::out() << "  " << BRIGHT_WHITE << item << RESET;
+    UISystem::out() << " | Price: " << BRIGHT_YELLOW << formatCurrency(price) << RESET;
+    UISystem::out() << " | Qty: " << (quantity > 0 ? GREEN : RED) << quantity << RESET;
 
     if (!customer.empty()) {
-        cout << " | Customer: " << BRIGHT_CYAN << customer << RESET;
+        UISystem::out() << " | Customer: " << BRIGHT_CYAN << customer << RESET;
     }
-    cout << endl;
+    UISystem::out() << endl;
 }
 
 // Displays a success message with checkmark
@@ -153,7 +155,7 @@ void UISystem::showTradeInfo(const string& item, int price, int quantity, const
 // Inputs: message - Success message text
 // Outputs: None
 void UISystem::showSuccess(const string& message) {
-    cout << BRIGHT_GREEN << "✓ " << message << RESET << endl;
+    UISystem::out() << BRIGHT_GREEN << "✓ " << message << RESET << endl;
 }
 
 // Displays a warning message with warning symbol
@@ -161,7 +163,7 @@ void UISystem::showSuccess(const string& message) {
 // Inputs: message - Warning message text
 // Outputs: None
 void UISystem::showWarning(const string& message) {
-    cout << BRIGHT_YELLOW << "⚠ " << message << RESET << endl;
+    UISystem::out() << BRIGHT_YELLOW << "⚠ " << message << RESET << endl;
 }
 
 // Displays an error message with X symbol
@@ -169,7 +171,7 @@ void UISystem::showWarning(const string& message) {
 // Inputs: message - Error message text
 // Outputs: None
 void UISystem::showError(const string& message) {
-    cout << BRIGHT_RED << "✗ " << message << RESET << endl;
+    UISystem::out() << BRIGHT_RED << "✗ " << message << RESET << endl;
 }
 
 // Displays an info message with info symbol
@@ -177,7 +179,7 @@ void UISystem::showError(const string& message) {
 // Inputs: message - Info message text
 // Outputs: None
 void UISystem::showInfo(const string& message) {
-    cout << BRIGHT_CYAN << "ℹ " << message << RESET << endl;
+    UISystem::out() << BRIGHT_CYAN << "ℹ " << message << RESET << endl;
 }
 
 // Starts a new UI section with title
@@ -196,7 +198,7 @@ void UISystem::startSection(const string& title) {
 // Outputs: None
 void UISystem::endSection() {
     InputSystem::drawSeparator();
-    cout << STATUS_INFO << "Press any key to continue..." << RESET << endl;
+    UISystem::out() << STATUS_INFO << "Press any key to continue..." << RESET << endl;
     InputSystem::waitForAnyKey();
 }
 
@@ -3,6 +3,7 @@
 #define UISYSTEM_H
 
 #include "InputSystem.h"
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -24,6 +25,9 @@
 
 class UISystem {
 public:
+    // Stream of the current frontend; every message of the game is written here
+    static std::ostream& out();
+
     // Menu functions
     static void showMenu(const std::string& title, const std::vector<std::string>& options);
     static int getMenuChoice(const std::string& title, const std::vector<std::string>& options);
@@ -1,10 +1,24 @@
 #include "Game.h"
+#include "InputSystem.h"
+#include "Frontend.h"
 #include <iostream>
+#include <string>
 
 using namespace std;
 
-int main() {
-    Game game;
+// Usage: game [--script <file>]
+// With --script the keys are replayed from the file instead of the terminal
+int main(int argc, char *argv[]) {
+    string scriptKeys;
+    bool scripted = argc == 3 && string(argv[1]) == "--script";
+    if (scripted && !ScriptInputSource::loadFile(argv[2], scriptKeys)) {
+        cerr << "Cannot read script file: " << argv[2] << endl;
+        return 1;
+    }
+    ScriptInputSource script(scriptKeys);
+    TerminalFrontend frontend(scripted ? &script : nullptr);
+
+    Game game(frontend);
     game.run();
     return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 
 #include "backpack.h"
+#include "../Core/UISystem.h"
 #include <iostream>
 
 // Adds a new item to the backpack inventory if space is available
@@ -8,7 +9,7 @@
 bool Backpack::addItem(const Item& item) {
     
     if (isFull()) {
-        cout << "Backpack is full, cannot add item!" << endl;
+        UISystem::out() << "Backpack is full, cannot add item!" << endl;
         return false;
     }
     items.push_back(item);
@@ -41,15 +42,15 @@ Item Backpack::getItem(int index) const {
 void Backpack::displayItems() const {
     // If there are no items stored in the internal container (e.g. std::vector<Item> items), print a message and exit early
     if (items.empty()) {
-        cout << "Backpack is empty" << endl;
+        UISystem::out() << "Backpack is empty" << endl;
         return;
     }
     
     // Print a header so the player knows they are looking at the backpack UI
-    cout << "=== Backpack Items ===" << endl;
+    UISystem::out() << "=== Backpack Items ===" << endl;
     // For each item, it prints the item's name and description
     for (size_t i = 0; i < items.size(); i++) {
-        cout << i + 1 << ". " << items[i].name << " - " << items[i].description << endl;
+        UISystem::out() << i + 1 << ". " << items[i].name << " - " << items[i].description << endl;
     }
-    cout << "=================" << endl;
+    UISystem::out() << "=================" << endl;
 }
@@ -1,4 +1,5 @@
 #include "item.h"
+#include "../Core/UISystem.h"
 #include <iostream>
 using namespace std;
 
@@ -6,37 +7,37 @@ using namespace std;
 // Shows item name, description, value, category, and specific attributes
 // Inputs: item - Item object to display information for
 void showItemInfo(Item item) {
-    cout << "=== " << item.name << " ===" << endl;
-    cout << "Description: " << item.description << endl;
-    cout << "Value: " << item.value << endl;
+    UISystem::out() << "=== " << item.name << " ===" << endl;
+    UISystem::out() << "Description: " << item.description << endl;
+    UISystem::out() << "Value: " << item.value << endl;
     
     switch (item.category) {
         case CATEGORY_SCRAP:
-            cout << "Category: Scrap" << endl;
+            UISystem::out() << "Category: Scrap" << endl;
             break;
         case CATEGORY_FOOD:
-            cout << "Category: Food";
+            UISystem::out() << "Category: Food";
             if (item.isEdible) {
-                cout << " - Health Recovery:" << item.healthEffect << " Stamina Recovery:" << item.staminaEffect;
+                UISystem::out() << " - Health Recovery:" << item.healthEffect << " Stamina Recovery:" << item.staminaEffect;
             }
-            cout << endl;
+            UISystem::out() << endl;
             break;
         case CATEGORY_MEDICINE:
-            cout << "Category: Medical Supplies - Health Recovery:" << item.healthEffect << endl;
+            UISystem::out() << "Category: Medical Supplies - Health Recovery:" << item.healthEffect << endl;
             break;
         case CATEGORY_TOOL:
-            cout << "Category: Tool - Durability:" << item.durability << endl;
+            UISystem::out() << "Category: Tool - Durability:" << item.durability << endl;
             break;
         case CATEGORY_WEAPON:
-            cout << "Category: Weapon - Damage:" << item.damage << " Durability:" << item.durability << endl;
+            UISystem::out() << "Category: Weapon - Damage:" << item.damage << " Durability:" << item.durability << endl;
             break;
         case CATEGORY_AMMO:
-            cout << "Category: Ammunition" << endl;
+            UISystem::out() << "Category: Ammunition" << endl;
             break;
     }
     
     if (item.isEdible) {
-        cout << "Status: Edible" << endl;
+        UISystem::out() << "Status: Edible" << endl;
     }
-    cout << endl;
+    UISystem::out() << endl;
 }
@@ -12,6 +12,7 @@ const int CATEGORY_MEDICINE = 2; // Medical
 const int CATEGORY_TOOL = 3;     // Tools
 const int CATEGORY_WEAPON = 4;   // Weapons
 const int CATEGORY_AMMO = 5;     // Ammunition
+const int CATEGORY_COUNT = 6;    // Number of categories
 
 // difficulty level constants - defined in Config.h
 
@@ -1,12 +1,17 @@
 #include "itemdatabase.h"
+#include "../Core/UISystem.h"
+#include "../Core/GameSession.h"
 #include <cstdlib>
 #include <ctime>
+#include <mutex>
 #include <string>
 using namespace std;
 
-Item itemPrototypes[20];  // To store the definition of items
-int itemPrototypeCount = 0;
-int currentDifficulty = DIFFICULTY_NORMAL;  // current difficulty
+// The item catalog: built once by initItemDatabase() and never changed afterwards, so every
+// game session in the process reads it without locking
+static Item itemPrototypes[20];  // To store the definition of items
+static int itemPrototypeCount = 0;
+static once_flag catalogBuilt;
 
 // function that creates items' prototype
 // id - Unique identifier for the item
@@ -19,7 +24,7 @@ int currentDifficulty = DIFFICULTY_NORMAL;  // current difficulty
 // dmg - Damage value for weapons
 // dur - Durability for tools and weapons
 // edible - Whether the item can be consumed
-void createItemPrototype(int id, string name, string desc, int cat, int val, int health, int stamina, int dmg, int dur, bool edible) {
+static void createItemPrototype(int id, string name, string desc, int cat, int val, int health, int stamina, int dmg, int dur, bool edible) {
     if (itemPrototypeCount >= 20){
       return;
     }
@@ -39,8 +44,8 @@ void createItemPrototype(int id, string name, string desc, int cat, int val, int
     itemPrototypeCount++;
 }
 
-// function that initializes the data base and random seed for item generation
-void initItemDatabase() {
+// function that builds the catalog and seeds rand()
+static void buildItemCatalog() {
     itemPrototypeCount = 0;
     
     // === Scrap ===
@@ -81,17 +86,21 @@ void initItemDatabase() {
     srand(time(NULL));
 }
 
-// function that sets the difficulty without generating error
+// function that initializes the data base and random seed for item generation
+// Only the first call builds the catalog; later calls, from any thread, wait until it is built
+void initItemDatabase() {
+    call_once(catalogBuilt, buildItemCatalog);
+}
+
+// function that sets the difficulty of the current game session without generating error
 // difficulty - Integer representing difficulty level (DIFFICULTY_EASY, DIFFICULTY_NORMAL, DIFFICULTY_HARD)
 void setGameDifficulty(int difficulty) {
-    if (difficulty >= DIFFICULTY_EASY && difficulty <= DIFFICULTY_HARD) {
-        currentDifficulty = difficulty;
-    }
+    GameSession::current().setDifficulty(difficulty);
 }
 
-// function that gets the current difficulty
+// function that gets the difficulty of the current game session
 int getGameDifficulty() {
-    return currentDifficulty;
+    return GameSession::current().getDifficulty();
 }
 
 
@@ -236,7 +245,7 @@ void deleteItem(Item* item) {
 // return Item* - Pointer to newly created shop Item, or NULL if invalid index
 Item* getShopItem(int index) {
     if (index < 0 || index >= getShopItemCount()) {
-        cout << "Error: Invalid shop item index!" << endl;
+        UISystem::out() << "Error: Invalid shop item index!" << endl;
         return NULL;
     }
     
@@ -270,7 +279,7 @@ int getShopItemCount() {
 // return Item* - Pointer to newly created most expensive Item, or NULL if database empty
 Item* getMostExpensiveItem() {
     if (itemPrototypeCount == 0) {
-        cout << "Error: No items in database!" << endl;
+        UISystem::out() << "Error: No items in database!" << endl;
         return NULL;
     }
     
@@ -294,7 +303,7 @@ Item* getMostExpensiveItem() {
 // return Item* - Pointer to newly created cheapest Item, or NULL if database empty
 Item* getCheapestItem() {
     if (itemPrototypeCount == 0) {
-        cout << "Error: No items in database!" << endl;
+        UISystem::out() << "Error: No items in database!" << endl;
         return NULL;
     }
     
@@ -317,7 +326,7 @@ Item* getCheapestItem() {
 // return Item* - Pointer to newly created found Item
 Item* findItemById(int id) {
     if (id < 0) {
-        cout << "Error: Invalid item ID!" << endl;
+        UISystem::out() << "Error: Invalid item ID!" << endl;
         return NULL;
     }
     
@@ -329,10 +338,37 @@ Item* findItemById(int id) {
         }
     }
     
-    cout << "Error: Item with ID " << id << " not found!" << endl;
+    UISystem::out() << "Error: Item with ID " << id << " not found!" << endl;
     return NULL;
 }
 
+// Gets the prototype of an item without copying it
+// id - Item ID to look up
+// return const Item* - Pointer into the prototype table, NULL if the ID is unknown
+const Item* getItemPrototype(int id) {
+    // Prototypes are created in ID order, so the ID is normally the index
+    if (id >= 0 && id < itemPrototypeCount && itemPrototypes[id].id == id) {
+        return &itemPrototypes[id];
+    }
+    for (int i = 0; i < itemPrototypeCount; i++) {
+        if (itemPrototypes[i].id == id) {
+            return &itemPrototypes[i];
+        }
+    }
+    return NULL;
+}
+
+// Creates an item from its prototype ID without searching by name
+// id - Item ID of the prototype
+// return Item* - New copy of the prototype, NULL if the ID is unknown
+Item* createItemFromPrototype(int id) {
+    const Item* prototype = getItemPrototype(id);
+    if (prototype == NULL) {
+        return NULL;
+    }
+    return new Item(*prototype);
+}
+
 // Gets total number of item prototypes
 int getTotalItemPrototypes() {
     return itemPrototypeCount;
@@ -343,27 +379,27 @@ int getTotalItemPrototypes() {
 // return bool - True if item is valid, false otherwise with error messages
 bool isValidItem(Item* item) {
     if (item == NULL) {
-        cout << "Error: Item pointer is NULL!" << endl;
+        UISystem::out() << "Error: Item pointer is NULL!" << endl;
         return false;
     }
     
     if (item->id < 0) {
-        cout << "Error: Item ID cannot be negative!" << endl;
+        UISystem::out() << "Error: Item ID cannot be negative!" << endl;
         return false;
     }
     
     if (item->name.empty()) {
-        cout << "Error: Item name cannot be empty!" << endl;
+        UISystem::out() << "Error: Item name cannot be empty!" << endl;
         return false;
     }
     
     if (item->value < 0) {
-        cout << "Error: Item value cannot be negative!" << endl;
+        UISystem::out() << "Error: Item value cannot be negative!" << endl;
         return false;
     }
     
     if (item->category < CATEGORY_SCRAP || item->category > CATEGORY_AMMO) {
-        cout << "Error: Invalid item category!" << endl;
+        UISystem::out() << "Error: Invalid item category!" << endl;
         return false;
     }
     
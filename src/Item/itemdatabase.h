@@ -8,7 +8,6 @@
 
 using namespace std;
 
-void createItemPrototype(int id, string name, string desc, int cat, int val, int health, int stamina, int dmg, int dur, bool edible);
 void initItemDatabase();
 void setGameDifficulty(int difficulty);
 Item* createItem(string itemName);
@@ -24,6 +23,8 @@ bool isValidItem(Item* item);
 
 
 Item* findItemById(int id);
+const Item* getItemPrototype(int id);
+Item* createItemFromPrototype(int id);
 
 
 
@@ -7,14 +7,17 @@
 #include <unordered_map>
 #include <iostream>
 #include <limits>
-#include <cstdlib>
+#include <algorithm>
+#include <vector>
 
-// Constructor: Initializes DayPhase with player, map, and item database
+// Constructor: Initializes DayPhase with player, map, item database and combat system
 // What it does: Sets up the DayPhase object with references to game components
-// Inputs: player - Pointer to Player object, map - Pointer to Map object, itemDB - Pointer to ItemDatabase
+// Inputs: player - Pointer to Player object, map - Pointer to Map object, itemDB - Pointer to ItemDatabase,
+//         combat - Pointer to the session's pooled Combat used for every encounter,
+//         market - Pointer to the session's Market, saved along with the player
 // Outputs: None (constructor)
-DayPhase::DayPhase(Player* player, Map* map, ItemDatabase* itemDB)
-    : m_player(player), m_map(map), m_itemDB(itemDB), m_currentDay(1) {}
+DayPhase::DayPhase(Player* player, Map* map, ItemDatabase* itemDB, Combat* combat, Market* market)
+    : m_player(player), m_map(map), m_itemDB(itemDB), m_combat(combat), m_market(market), m_currentDay(1), m_quit(false) {}
 
 namespace {
 // Helper function: Translates internal loot names to display names
@@ -47,14 +50,16 @@ std::string translateLootName(const std::string& raw) {
 // Main day execution loop: Handles the day phase exploration
 // What it does: Manages the day exploration phase, allowing player to select and explore locations
 // Inputs: currentDay - Current day number for tracking progress
-// Outputs: None
-void DayPhase::executeDay(int currentDay) {
+// Outputs: bool - True when the day is over, false if the player saved and quit
+bool DayPhase::executeDay(int currentDay) {
     m_currentDay = currentDay;
+    m_quit = false;
     UISystem::startSection("DAY PHASE");
     UISystem::showInfo("Exploring locations...");
 
     while (true) {
         Location* selectedLocation = selectLocationMenu();
+        if (m_quit) break;
         if (!selectedLocation) {
             UISystem::showInfo("You decided to return to camp and rest...");
             break;
@@ -66,86 +71,83 @@ void DayPhase::executeDay(int currentDay) {
         bool continueExploring = true;
         bool waiting = true;
         while (waiting) {
-            if (InputSystem::kbhit()) {
-                char choice = InputSystem::getch();
-                if (choice == 's' || choice == 'S') {
-                    performSaveAndExit();
-                }
-                if (choice == 'y' || choice == 'Y') {
-                    waiting = false;
-                } else if (choice == 'n' || choice == 'N') {
-                    continueExploring = false;
-                    waiting = false;
-                }
+            char choice = InputSystem::readKey();
+            if (choice == 's' || choice == 'S') {
+                performSaveAndExit();
+                break;
+            }
+            if (choice == 'y' || choice == 'Y') {
+                waiting = false;
+            } else if (choice == 'n' || choice == 'N') {
+                continueExploring = false;
+                waiting = false;
             }
-            InputSystem::sleepMs(100);
         }
+        if (m_quit) break;
         if (!continueExploring) {
             UISystem::showInfo("You decided to return to camp...");
             break;
         }
     }
 
+    if (m_quit) {
+        return false;
+    }
     UISystem::endSection();
+    return true;
 }
 
 // Location selection menu: Displays available locations for exploration
 // What it does: Shows a menu of unexplored locations and handles user selection
 // Inputs: None
-// Outputs: Location* - Pointer to selected location, or nullptr if user cancels
+// Outputs: Location* - Pointer to selected location, or nullptr if user cancels or saves and quits
 Location* DayPhase::selectLocationMenu() {
     auto availableLocations = m_map->getAvailableLocations();
 
     if (availableLocations.empty()) {
-        std::cout << "All locations have been explored!" << std::endl;
+        UISystem::out() << "All locations have been explored!" << std::endl;
         return nullptr;
     }
 
     while (true) {
-        std::cout << "=== Select Exploration Location ===" << std::endl;
+        UISystem::out() << "=== Select Exploration Location ===" << std::endl;
         for (size_t i = 0; i < availableLocations.size(); ++i) {
-            std::cout << i + 1 << ". " << availableLocations[i]->name
+            UISystem::out() << i + 1 << ". " << availableLocations[i]->name
                       << " (Danger Level: " << availableLocations[i]->dangerLevel << ")" << std::endl;
         }
-        std::cout << "0. Return to Camp" << std::endl;
-        std::cout << "[S] Save & Quit" << std::endl;
-        std::cout << "Please choose (0-" << availableLocations.size() << "): ";
-
-        bool awaitingInput = true;
-        while (awaitingInput) {
-            if (InputSystem::kbhit()) {
-                char key = InputSystem::getch();
-                if (key == 's' || key == 'S') {
-                    performSaveAndExit();
-                }
-                if (key >= '0' && key <= '9') {
-                    int choice = key - '0';
-                    if (choice == 0) {
-                        return nullptr;
-                    }
-                    if (choice >= 1 && choice <= static_cast<int>(availableLocations.size())) {
-                        return availableLocations[choice - 1];
-                    }
-                    std::cout << "Invalid choice!" << std::endl;
-                    awaitingInput = false;
-                } else {
-                    std::cout << "Invalid input!" << std::endl;
-                    awaitingInput = false;
-                }
+        UISystem::out() << "0. Return to Camp" << std::endl;
+        UISystem::out() << "[S] Save & Quit" << std::endl;
+        UISystem::out() << "Please choose (0-" << availableLocations.size() << "): ";
+
+        char key = InputSystem::readKey();
+        if (key == 's' || key == 'S') {
+            performSaveAndExit();
+            return nullptr;
+        }
+        if (key >= '0' && key <= '9') {
+            int choice = key - '0';
+            if (choice == 0) {
+                return nullptr;
+            }
+            if (choice >= 1 && choice <= static_cast<int>(availableLocations.size())) {
+                return availableLocations[choice - 1];
             }
-            InputSystem::sleepMs(100);
+            UISystem::out() << "Invalid choice!" << std::endl;
+        } else {
+            UISystem::out() << "Invalid input!" << std::endl;
         }
     }
 }
 
 // Location exploration: Handles the exploration of a selected location
 // What it does: Generates and processes events for the selected location, marks it as completed
+//               and appends the changes to the save journal
 // Inputs: location - Pointer to the location to explore
 // Outputs: None
 void DayPhase::exploreLocation(Location* location) {
-    std::cout << "\n=== Exploring " << location->name << " ===" << std::endl;
-    std::cout << "Danger Level: " << location->dangerLevel << std::endl;
-    std::cout << "Searching..." << std::endl;
+    UISystem::out() << "\n=== Exploring " << location->name << " ===" << std::endl;
+    UISystem::out() << "Danger Level: " << location->dangerLevel << std::endl;
+    UISystem::out() << "Searching..." << std::endl;
 
     // Generate random event
     EventResult result = EventFactory::generateEvent(*location);
@@ -155,6 +157,9 @@ void DayPhase::exploreLocation(Location* location) {
 
     // Mark location as explored
     m_map->completeLocation(location);
+
+    // Autosave what the event changed
+    SaveSystem::journalGame(*m_player, m_currentDay, m_market, m_map);
 }
 
 // Event result handler: Processes different types of events and their outcomes
@@ -162,27 +167,27 @@ void DayPhase::exploreLocation(Location* location) {
 // Inputs: result - EventResult object containing event type and data
 // Outputs: None
 void DayPhase::handleEventResult(const EventResult& result) {
-    std::cout << "\n" << result.message << std::endl;
+    UISystem::out() << "\n" << result.message << std::endl;
 
     switch (result.type) {
         case EventType::LOOT_FOUND:
-            std::cout << "Found supplies:" << std::endl;
+            UISystem::out() << "Found supplies:" << std::endl;
             for (const auto& item : result.loot) {
-                std::cout << "  - " << item.first << " x" << item.second << std::endl;
+                UISystem::out() << "  - " << item.first << " x" << item.second << std::endl;
                 std::string mappedName = translateLootName(item.first);
                 for (int i = 0; i < item.second; ++i) {
                     Item* newItem = createItem(mappedName);
                     if (newItem) {
                         m_player->addItem(newItem);
                     } else {
-                        std::cout << "    Unable to store " << mappedName << std::endl;
+                        UISystem::out() << "    Unable to store " << mappedName << std::endl;
                     }
                 }
             }
             break;
 
         case EventType::ENEMY_ENCOUNTER: {
-            std::cout << "Encountered enemy: " << result.enemyId << "! Prepare for combat!" << std::endl;
+            UISystem::out() << "Encountered enemy: " << result.enemyId << "! Prepare for combat!" << std::endl;
             int enemyIndex = 0;
             if (result.enemyId == "mutant_dog") {
                 enemyIndex = 1;
@@ -194,16 +199,28 @@ void DayPhase::handleEventResult(const EventResult& result) {
                 enemyIndex = 3;
             }
             Item* bestWeapon = m_player->getBestWeapon();
-            Combat combat(m_player, "Survivor", bestWeapon);
-            combat.fightEnemy(enemyIndex);
+            m_combat->prepareEncounter(bestWeapon);
+            if (result.enemyId == "boss") {
+                // Bosses bring a wave of followers that grows with the days survived
+                int waveSize = std::min(2 + m_currentDay / 5, 8);
+                std::vector<int> archetypes;
+                archetypes.reserve(waveSize);
+                archetypes.push_back(enemyIndex);
+                for (int i = 1; i < waveSize; ++i) {
+                    archetypes.push_back((i - 1) % 3);
+                }
+                m_combat->fightWave(archetypes);
+            } else {
+                m_combat->fightEnemy(enemyIndex);
+            }
             break;
         }
 
         case EventType::SPECIAL_DISCOVERY:
             if (result.requiredItem == "none") {
-                std::cout << "Special discovery:" << std::endl;
+                UISystem::out() << "Special discovery:" << std::endl;
                 for (const auto& item : result.loot) {
-                    std::cout << "  - " << item.first << " x" << item.second << std::endl;
+                    UISystem::out() << "  - " << item.first << " x" << item.second << std::endl;
                     std::string mappedName = translateLootName(item.first);
                     for (int i = 0; i < item.second; ++i) {
                         Item* newItem = createItem(mappedName);
@@ -214,12 +231,12 @@ void DayPhase::handleEventResult(const EventResult& result) {
                 }
             } else {
                 std::string requiredItem = translateLootName(result.requiredItem);
-                std::cout << "You need " << requiredItem << " to open this container." << std::endl;
+                UISystem::out() << "You need " << requiredItem << " to open this container." << std::endl;
                 if (m_player->hasItem(requiredItem)) {
-                    std::cout << "You used " << requiredItem << " to open it!" << std::endl;
+                    UISystem::out() << "You used " << requiredItem << " to open it!" << std::endl;
                     m_player->removeItem(requiredItem);
                     for (const auto& item : result.loot) {
-                        std::cout << "  - " << item.first << " x" << item.second << std::endl;
+                        UISystem::out() << "  - " << item.first << " x" << item.second << std::endl;
                         std::string mappedName = translateLootName(item.first);
                         for (int i = 0; i < item.second; ++i) {
                             Item* newItem = createItem(mappedName);
@@ -229,23 +246,28 @@ void DayPhase::handleEventResult(const EventResult& result) {
                         }
                     }
                 } else {
-                    std::cout << "You don't have the required tool, have to give up..." << std::endl;
+                    UISystem::out() << "You don't have the required tool, have to give up..." << std::endl;
                 }
             }
             break;
 
         case EventType::NOTHING_FOUND:
-            std::cout << "This search yielded nothing..." << std::endl;
+            UISystem::out() << "This search yielded nothing..." << std::endl;
             break;
     }
 }
 
-// Save and exit function: Saves game progress and exits the game
-// What it does: Calls the save system to persist player data and current day, then terminates the program
+// Save and exit function: Saves game progress and ends the game
+// What it does: Calls the save system to persist player data, current day and market state, waits for
+//               the background write to finish, then marks the day as quit so executeDay() returns
+//               false and the game loop stops
 // Inputs: None
-// Outputs: None (terminates program)
-void DayPhase::performSaveAndExit() const {
-    SaveSystem::saveGame(*m_player, m_currentDay);
-    std::cout << "Progress saved. Exiting game..." << std::endl;
-    std::exit(0);
+// Outputs: None
+void DayPhase::performSaveAndExit() {
+    if (SaveSystem::saveGame(*m_player, m_currentDay, m_market, m_map).get()) {
+        UISystem::out() << "Progress saved. Exiting game..." << std::endl;
+    } else {
+        UISystem::out() << "Error: progress could not be saved. Exiting game..." << std::endl;
+    }
+    m_quit = true;
 }
\ No newline at end of file
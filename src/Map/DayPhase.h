@@ -4,6 +4,8 @@
 class Player;
 class Map;
 class ItemDatabase;
+class Combat;
+class Market;
 
 #include "Event.h"
 
@@ -12,15 +14,18 @@ private:
     Player* m_player;
     Map* m_map;
     ItemDatabase* m_itemDB;
+    Combat* m_combat;
+    Market* m_market;
     int m_currentDay;
+    bool m_quit;  // Set once the player saved and quit during this day
 
     Location* selectLocationMenu();
     void exploreLocation(Location* location);
     void handleEventResult(const EventResult& result);
-    void performSaveAndExit() const;
+    void performSaveAndExit();
 
 public:
-    DayPhase(Player* player, Map* map, ItemDatabase* itemDB);
-    void executeDay(int currentDay);
+    DayPhase(Player* player, Map* map, ItemDatabase* itemDB, Combat* combat, Market* market);
+    bool executeDay(int currentDay); // false if the player saved and quit
 };
 #endif
\ No newline at end of file
@@ -7,7 +7,7 @@
 // What it does: Creates map instance and sets up location templates
 // Inputs: None
 // Outputs: None (constructor)
-Map::Map() {
+Map::Map() : generatedDay(0) {
     initializePrototypes();
 }
 
@@ -17,7 +17,7 @@ Map::Map() {
 // Outputs: None
 void Map::initializePrototypes() {
     // Define location templates with different danger levels
-    locationPrototypes = {
+    locationPrototypes = std::make_shared<const std::vector<Location>>(std::vector<Location>{
         // Low danger areas
         {"safe_zone", "Safe Zone", 1,
          {{"bandage", 0.3}, {"water", 0.4}, {"canned_food", 0.2}},
@@ -37,7 +37,7 @@ void Map::initializePrototypes() {
         {"military_base", "Military Base", 5,
          {{"medkit", 0.15}, {"sniper_rifle", 0.05}, {"grenade", 0.1}, {"armor", 0.08}},
          0.8, 0.2, 0.05}
-    };
+    });
 }
 
 // Generates daily map with locations based on current day
@@ -47,6 +47,8 @@ void Map::initializePrototypes() {
 void Map::generateDailyMap(int currentDay) {
     dailyLocations.clear();
     locationCompleted.clear();
+    dailyPrototypes.clear();
+    generatedDay = currentDay;
 
     std::random_device rd;
     std::mt19937 gen(rd());
@@ -57,8 +59,9 @@ void Map::generateDailyMap(int currentDay) {
 
     // Generate daily map
     for (int i = 0; i < locationCount; ++i) {
-        std::uniform_int_distribution<> dis(0, locationPrototypes.size() - 1);
-        Location location = locationPrototypes[dis(gen)];
+        std::uniform_int_distribution<> dis(0, locationPrototypes->size() - 1);
+        int prototype = dis(gen);
+        Location location = (*locationPrototypes)[prototype];
 
         // Adjust danger level based on day
         int adjustedDanger = location.dangerLevel + (currentDay / 5);
@@ -69,6 +72,7 @@ void Map::generateDailyMap(int currentDay) {
 
         dailyLocations.push_back(location);
         locationCompleted.push_back(false);
+        dailyPrototypes.push_back(prototype);
     }
 }
 
@@ -99,4 +103,60 @@ void Map::completeLocation(Location* loc) {
             break;
         }
     }
-}
\ No newline at end of file
+}
+// Copies the daily map for saving
+// What it does: Collects the template, danger level and explored flag of every daily location
+// Inputs: None
+// Outputs: MapState - The day's map
+MapState Map::getState() const {
+    MapState state;
+    state.day = generatedDay;
+    state.prototypes = dailyPrototypes;
+    state.completed = locationCompleted;
+    for (const Location& location : dailyLocations) {
+        state.dangerLevels.push_back(location.dangerLevel);
+    }
+    return state;
+}
+
+// Checks a saved daily map
+// What it does: Verifies that every location has a danger level and explored flag and refers to
+//               an existing template
+// Inputs: state - Map saved by getState()
+// Outputs: bool - True if restoreState() would accept the state
+bool Map::isValidState(const MapState& state) const {
+    size_t count = state.prototypes.size();
+    if (state.dangerLevels.size() != count || state.completed.size() != count) {
+        return false;
+    }
+    for (int prototype : state.prototypes) {
+        if (prototype < 0 || prototype >= static_cast<int>(locationPrototypes->size())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Rebuilds a saved daily map
+// What it does: Recreates every location from its template the same way generateDailyMap() does,
+//               then applies the saved danger level and explored flag
+// Inputs: state - Map saved by getState()
+// Outputs: bool - True if the map was rebuilt, false (map unchanged) if the state is inconsistent
+bool Map::restoreState(const MapState& state) {
+    if (!isValidState(state)) {
+        return false;
+    }
+    size_t count = state.prototypes.size();
+
+    dailyLocations.clear();
+    for (size_t i = 0; i < count; ++i) {
+        Location location = (*locationPrototypes)[state.prototypes[i]];
+        location.dangerLevel = state.dangerLevels[i];
+        location.id = location.id + "_" + std::to_string(i);
+        dailyLocations.push_back(location);
+    }
+    dailyPrototypes = state.prototypes;
+    locationCompleted = state.completed;
+    generatedDay = state.day;
+    return true;
+}
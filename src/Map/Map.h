@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 
 struct Location { // define location
     std::string id;         // inner ID, e.g., "city_ruins"
@@ -16,10 +17,17 @@ struct Location { // define location
     double emptyChance;         
 };
 
+struct MapState { // everything needed to rebuild one day's map
+    int day;                           // day the map was generated for, 0 if none yet
+    std::vector<int> prototypes;       // index into the location templates, per location
+    std::vector<int> dangerLevels;     // adjusted danger level, per location
+    std::vector<bool> completed;       // explored flag, per location
+};
+
 class Map {
 private:
-    // store location template
-    std::vector<Location> locationPrototypes;
+    // store location template, never changed after construction, so copies of the map share it
+    std::shared_ptr<const std::vector<Location>> locationPrototypes;
 
     // actually generated location on that day
     std::vector<Location> dailyLocations;
@@ -27,6 +35,10 @@ private:
     // track already explored location, and you can't explore the same location two times
     std::vector<bool> locationCompleted;
 
+    // template each daily location was made from, and the day they were made for
+    std::vector<int> dailyPrototypes;
+    int generatedDay;
+
     void initializePrototypes(); // load location template
 
 public:
@@ -37,5 +49,13 @@ public:
     std::vector<Location*> getAvailableLocations(); // get the list of location, used in location menu
 
     void completeLocation(Location* loc); // remark a explored location
+
+    int getGeneratedDay() const { return generatedDay; } // day of the current map, 0 if none
+
+    MapState getState() const; // copy the daily map for saving
+
+    bool isValidState(const MapState& state) const; // whether a saved daily map fits the templates
+
+    bool restoreState(const MapState& state); // rebuild a saved daily map, false if it does not fit the templates
 };
 #endif
\ No newline at end of file
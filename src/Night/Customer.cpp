@@ -1,175 +1,260 @@
-#include "Customer.h"
-#include "Market.h"  // Include here for MarketTrends definition
-#include "../Core/Config.h"
-#include "../Item/item.h"
-#include <cstdlib>
-#include <ctime>
-#include <algorithm>
-#include <iostream>
-
-// Customer generation related constants (use these defaults if not defined in Config.h)
-#ifndef MIN_CUSTOMERS
-#define MIN_CUSTOMERS 1
-#endif
-#ifndef MAX_CUSTOMERS
-#define MAX_CUSTOMERS 3
-#endif
-#ifndef MIN_PATIENCE
-#define MIN_PATIENCE 1
-#endif
-#ifndef MAX_PATIENCE
-#define MAX_PATIENCE 5
-#endif
-#ifndef MIN_PRICE_MULTIPLIER
-#define MIN_PRICE_MULTIPLIER 0.8f
-#endif
-#ifndef MAX_PRICE_MULTIPLIER
-#define MAX_PRICE_MULTIPLIER 1.2f
-#endif
-
-/**
- * Customer constructor
- * What it does: Initializes a Customer object with the provided name, desired item, quantity, patience, and base price
- * Inputs:
- *   - n: Customer's name string
- *   - item: Name of the item the customer wants to buy
- *   - qty: Quantity of items desired
- *   - pat: Patience level (affects price negotiation)
- *   - price: Base price per item
- * Outputs: None (constructor initializes member variables)
- */
-Customer::Customer(const std::string& n, const std::string& item, int qty, int pat, int price)
-    : name(n), desired_item(item), desired_quantity(qty), patience(pat), base_price(price) {
-}
-
-/**
- * Default constructor for Customer
- * What it does: Creates an empty Customer object with all fields initialized to empty strings or zero
- * Inputs: None
- * Outputs: None (constructor initializes all member variables to default values)
- */
-Customer::Customer() 
-    : name(""), desired_item(""), desired_quantity(0), patience(0), base_price(0) {
-}
-
-/**
- * Get random customer name
- * What it does: Returns a randomly selected customer name from a predefined list of survivor archetypes.
- *               Initializes random seed on first call if not already initialized.
- * Inputs: None
- * Outputs: Returns a string containing a randomly selected customer name from the predefined list
- */
-std::string getRandomCustomerName() {
-    static const std::vector<std::string> customerNames = {
-        "Old Hunter", "Anxious Mother", "Wounded Soldier", "Cunning Merchant",
-        "Desperate Survivor", "Young Scavenger", "Experienced Explorer", "Mysterious Stranger",
-        "Hungry Wanderer", "Medicine Seeker"
-    };
-    
-    static bool initialized = false;
-    if (!initialized) {
-        srand(static_cast<unsigned int>(time(NULL)));
-        initialized = true;
-    }
-    
-    int index = rand() % customerNames.size();
-    return customerNames[index];
-}
-
-/**
- * Get random desired item
- * What it does: Returns a randomly selected item name from a predefined list of items that customers might want.
- *               Initializes random seed on first call if not already initialized.
- * Inputs: None
- * Outputs: Returns a string containing a randomly selected item name from the predefined list
- */
-std::string getRandomDesiredItem() {
-    static const std::vector<std::string> desiredItems = {
-        "Canned food", "Scrap Metal", "Electronic Component", "Gold Ring",
-        "Rag", "Bandage", "First Aid Kit", "Military Rations"
-    };
-    
-    static bool initialized = false;
-    if (!initialized) {
-        srand(static_cast<unsigned int>(time(NULL)));
-        initialized = true;
-    }
-    
-    int index = rand() % desiredItems.size();
-    return desiredItems[index];
-}
-
-/**
- * Generate random customers
- * What it does: Creates a vector of randomly generated customers for the night phase.
- *               Each customer is assigned a random name, desired item, and patience level.
- *               The desired quantity is calculated using the demand growth system: base quantity
- *               plus a random factor multiplied by the current market demand for that item type.
- *               This implements the core innovation where customer demands grow over time.
- * Inputs:
- *   - trends: Reference to MarketTrends object containing current demand multipliers for different item categories
- *   - count: Number of customers to generate. If negative, randomly generates between MIN_CUSTOMERS and MAX_CUSTOMERS
- * Outputs: Returns a vector of Customer objects, each with randomly assigned attributes and
- *          demand-influenced quantities
- */
-std::vector<Customer> generateCustomers(MarketTrends& trends, int count) {
-    // Initialize random seed if not already done
-    static bool initialized = false;
-    if (!initialized) {
-        srand(static_cast<unsigned int>(time(NULL)));
-        initialized = true;
-    }
-    
-    // Determine number of customers (1-3)
-    if (count < 0) {
-        count = MIN_CUSTOMERS + (rand() % (MAX_CUSTOMERS - MIN_CUSTOMERS + 1));
-    }
-    
-    std::vector<Customer> customers;
-    customers.reserve(count);
-    
-    for (int i = 0; i < count; i++) {
-        std::string name = getRandomCustomerName();
-        std::string item = getRandomDesiredItem();
-        
-        // Base quantity (1-3 items)
-        int baseQuantity = 1 + (rand() % 3);
-        
-        // Get demand multiplier for this item type
-        float demandMultiplier = trends.getDemandForItem(item);
-        
-        // Calculate desired quantity with demand growth
-        // desired_quantity = base_amount + (random_factor * MarketTrends.demand)
-        int randomFactor = 1 + (rand() % 3);  // Random factor 1-3
-        int desiredQuantity = baseQuantity + static_cast<int>(randomFactor * demandMultiplier);
-        
-        // Ensure minimum of 1
-        if (desiredQuantity < 1) desiredQuantity = 1;
-        
-        // Generate patience (1-5)
-        int patience = MIN_PATIENCE + (rand() % (MAX_PATIENCE - MIN_PATIENCE + 1));
-        
-        // Generate base price (based on item value from database)
-        // We'll use a default value and adjust based on item type
-        int basePrice = 5;  // Default base price
-        if (item == "Canned food" || item == "Military Rations") {
-            basePrice = 3;
-        } else if (item == "Gold Ring" || item == "Electronic Component") {
-            basePrice = 10;
-        } else if (item == "Scrap Metal") {
-            basePrice = 2;
-        } else if (item == "First Aid Kit" || item == "Bandage") {
-            basePrice = 8;
-        }
-        
-        // Apply price multiplier based on patience
-        float priceMultiplier = MIN_PRICE_MULTIPLIER + 
-            (static_cast<float>(rand()) / RAND_MAX) * (MAX_PRICE_MULTIPLIER - MIN_PRICE_MULTIPLIER);
-        basePrice = static_cast<int>(basePrice * priceMultiplier);
-        
-        customers.push_back(Customer(name, item, desiredQuantity, patience, basePrice));
-    }
-    
-    return customers;
-}
-
+#include "Customer.h"
+#include "Market.h"  // Include here for MarketTrends definition
+#include "../Core/Config.h"
+#include "../Item/item.h"
+#include <algorithm>
+#include <iostream>
+
+// Customer generation related constants (use these defaults if not defined in Config.h)
+#ifndef MIN_CUSTOMERS
+#define MIN_CUSTOMERS 1
+#endif
+#ifndef MAX_CUSTOMERS
+#define MAX_CUSTOMERS 3
+#endif
+#ifndef MIN_PATIENCE
+#define MIN_PATIENCE 1
+#endif
+#ifndef MAX_PATIENCE
+#define MAX_PATIENCE 5
+#endif
+#ifndef MIN_PRICE_MULTIPLIER
+#define MIN_PRICE_MULTIPLIER 0.8f
+#endif
+#ifndef MAX_PRICE_MULTIPLIER
+#define MAX_PRICE_MULTIPLIER 1.2f
+#endif
+
+/**
+ * Customer constructor
+ * What it does: Initializes a Customer object with the provided name, desired item, quantity, patience, and base price
+ * Inputs:
+ *   - n: Customer's name string
+ *   - item: Name of the item the customer wants to buy
+ *   - qty: Quantity of items desired
+ *   - pat: Patience level (affects price negotiation)
+ *   - price: Base price per item
+ * Outputs: None (constructor initializes member variables)
+ */
+Customer::Customer(const std::string& n, const std::string& item, int qty, int pat, int price)
+    : name(n), desired_item(item), desired_quantity(qty), patience(pat), base_price(price) {
+}
+
+/**
+ * Default constructor for Customer
+ * What it does: Creates an empty Customer object with all fields initialized to empty strings or zero
+ * Inputs: None
+ * Outputs: None (constructor initializes all member variables to default values)
+ */
+Customer::Customer() 
+    : name(""), desired_item(""), desired_quantity(0), patience(0), base_price(0) {
+}
+
+namespace {
+const std::vector<std::string> customerNames = {
+    "Old Hunter", "Anxious Mother", "Wounded Soldier", "Cunning Merchant",
+    "Desperate Survivor", "Young Scavenger", "Experienced Explorer", "Mysterious Stranger",
+    "Hungry Wanderer", "Medicine Seeker"
+};
+
+// Desired items and their base price per item, indexed by item atom
+const std::vector<std::string> desiredItems = {
+    "Canned food", "Scrap Metal", "Electronic Component", "Gold Ring",
+    "Rag", "Bandage", "First Aid Kit", "Military Rations"
+};
+const int desiredItemPrices[] = {3, 2, 10, 10, 5, 8, 8, 3};
+const int desiredItemIds[] = {4, 0, 2, 3, 1, 7, 8, 6};  // Prototype ID in the item database
+}
+
+/**
+ * Clear the roster
+ * What it does: Empties every array of the roster, keeping the allocated capacity
+ * Inputs: None
+ * Outputs: None (modifies all member arrays)
+ */
+void CustomerRoster::clear() {
+    name_id.clear();
+    item_atom.clear();
+    quantity.clear();
+    patience.clear();
+    base_price.clear();
+    offer.clear();
+}
+
+/**
+ * Build a Customer from one roster entry
+ * What it does: Looks up the name and item of entry "index" in the customer tables
+ * Inputs:
+ *   - index: Index of the customer in the roster
+ * Outputs: Returns a Customer with the entry's attributes
+ */
+Customer CustomerRoster::toCustomer(int index) const {
+    return Customer(customerNames[name_id[index]], desiredItems[item_atom[index]],
+                    quantity[index], patience[index], base_price[index]);
+}
+
+/**
+ * Get random customer name
+ * What it does: Returns a randomly selected customer name from a predefined list of survivor archetypes.
+ * Inputs:
+ *   - rng: Session random generator
+ * Outputs: Returns a string containing a randomly selected customer name from the predefined list
+ */
+std::string getRandomCustomerName(CustomerRng& rng) {
+    return customerNames[rng.range(0, static_cast<int>(customerNames.size()) - 1)];
+}
+
+/**
+ * Get random desired item
+ * What it does: Returns a randomly selected item name from a predefined list of items that customers might want.
+ * Inputs:
+ *   - rng: Session random generator
+ * Outputs: Returns a string containing a randomly selected item name from the predefined list
+ */
+std::string getRandomDesiredItem(CustomerRng& rng) {
+    return desiredItems[rng.range(0, static_cast<int>(desiredItems.size()) - 1)];
+}
+
+/**
+ * Get the number of desired items
+ * What it does: Returns the size of the desired item table
+ * Inputs: None
+ * Outputs: Returns the number of item atoms
+ */
+int getDesiredItemCount() {
+    return static_cast<int>(desiredItems.size());
+}
+
+/**
+ * Get a desired item name by atom
+ * What it does: Returns the entry "atom" of the desired item table
+ * Inputs:
+ *   - atom: Index into the desired item table
+ * Outputs: Returns the item name
+ */
+const std::string& getDesiredItemName(int atom) {
+    return desiredItems[atom];
+}
+
+/**
+ * Get the base price of a desired item
+ * What it does: Returns the entry "atom" of the desired item price table
+ * Inputs:
+ *   - atom: Index into the desired item table
+ * Outputs: Returns the base price per item
+ */
+int getDesiredItemBasePrice(int atom) {
+    return desiredItemPrices[atom];
+}
+
+/**
+ * Calculate the total price a customer pays
+ * What it does: Calculates the total transaction price by multiplying the base price per item
+ *               by the quantity, then applies a patience-based multiplier. Higher patience results
+ *               in a better price (patience multiplier = 1.0 + (patience - 1) * 0.1).
+ * Inputs:
+ *   - basePrice: Base price per item
+ *   - patience: Customer's patience level
+ *   - quantity: Number of items being sold
+ * Outputs: Returns the final total price after applying the patience multiplier
+ */
+int calculateTradePrice(int basePrice, int patience, int quantity) {
+    float patienceMultiplier = 1.0f + (patience - 1) * 0.1f;
+    return static_cast<int>(basePrice * quantity * patienceMultiplier);
+}
+
+/**
+ * Generate random customers
+ * What it does: Creates a vector of randomly generated customers for the night phase.
+ *               Each customer is assigned a random name, desired item, and patience level.
+ *               The desired quantity is calculated using the demand growth system: base quantity
+ *               plus a random factor multiplied by the current market demand for that item type.
+ *               This implements the core innovation where customer demands grow over time.
+ * Inputs:
+ *   - trends: Reference to MarketTrends object containing current demand multipliers for different item categories
+ *   - rng: Session random generator used for every roll
+ *   - count: Number of customers to generate. If negative, randomly generates between MIN_CUSTOMERS and MAX_CUSTOMERS
+ * Outputs: Returns a vector of Customer objects, each with randomly assigned attributes and
+ *          demand-influenced quantities
+ */
+std::vector<Customer> generateCustomers(MarketTrends& trends, CustomerRng& rng, int count) {
+    // Determine number of customers (1-3)
+    if (count < 0) {
+        count = rng.range(MIN_CUSTOMERS, MAX_CUSTOMERS);
+    }
+    
+    CustomerRoster roster;
+    generateBazaar(trends, rng, count, roster);
+    
+    std::vector<Customer> customers;
+    customers.reserve(count);
+    for (int i = 0; i < roster.size(); i++) {
+        customers.push_back(roster.toCustomer(i));
+    }
+    return customers;
+}
+
+/**
+ * Generate a bazaar crowd
+ * What it does: Fills the roster with "count" customers. A first pass makes every random roll
+ *               (name, item, base quantity, random factor, patience, price multiplier). Demand is
+ *               looked up once per item atom instead of once per customer, then quantities, base
+ *               prices and offers are computed in straight passes over the arrays.
+ *               desired_quantity = base_amount + (random_factor * MarketTrends.demand)
+ * Inputs:
+ *   - trends: Current market demand values
+ *   - rng: Session random generator used for every roll
+ *   - count: Number of customers to generate
+ *   - roster: Roster to fill, its previous content is discarded
+ * Outputs: None (fills roster)
+ */
+void generateBazaar(const MarketTrends& trends, CustomerRng& rng, int count, CustomerRoster& roster) {
+    roster.clear();
+    if (count <= 0) {
+        return;
+    }
+    
+    const int itemCount = getDesiredItemCount();
+    const int nameCount = static_cast<int>(customerNames.size());
+    
+    // Demand per item atom, resolved once for the whole crowd
+    std::vector<float> atomDemand(itemCount);
+    for (int a = 0; a < itemCount; a++) {
+        atomDemand[a] = trends.getDemandForItemId(desiredItemIds[a]);
+    }
+    
+    roster.name_id.resize(count);
+    roster.item_atom.resize(count);
+    roster.quantity.resize(count);
+    roster.patience.resize(count);
+    roster.base_price.resize(count);
+    roster.offer.resize(count);
+    std::vector<int> randomFactor(count);
+    std::vector<float> priceMultiplier(count);
+    
+    // Rolls, in the same order for every customer so a seed always gives the same crowd
+    for (int i = 0; i < count; i++) {
+        roster.name_id[i] = static_cast<uint8_t>(rng.range(0, nameCount - 1));
+        roster.item_atom[i] = static_cast<uint8_t>(rng.range(0, itemCount - 1));
+        roster.quantity[i] = rng.range(1, 3);            // Base quantity (1-3 items)
+        randomFactor[i] = rng.range(1, 3);               // Random factor 1-3
+        roster.patience[i] = rng.range(MIN_PATIENCE, MAX_PATIENCE);
+        priceMultiplier[i] = MIN_PRICE_MULTIPLIER + rng.unit() * (MAX_PRICE_MULTIPLIER - MIN_PRICE_MULTIPLIER);
+    }
+    
+    // Quantities with demand growth, minimum of 1
+    for (int i = 0; i < count; i++) {
+        int q = roster.quantity[i] + static_cast<int>(randomFactor[i] * atomDemand[roster.item_atom[i]]);
+        roster.quantity[i] = std::max(q, 1);
+    }
+    
+    // Base price per item adjusted by the price multiplier
+    for (int i = 0; i < count; i++) {
+        roster.base_price[i] = static_cast<int>(desiredItemPrices[roster.item_atom[i]] * priceMultiplier[i]);
+    }
+    
+    // Total offer for the full quantity
+    for (int i = 0; i < count; i++) {
+        roster.offer[i] = calculateTradePrice(roster.base_price[i], roster.patience[i], roster.quantity[i]);
+    }
+}
@@ -1,77 +1,170 @@
-#ifndef CUSTOMER_H
-#define CUSTOMER_H
-
-#include <string>
-#include <vector>
-#include "Market.h"  // For MarketTrends definition
-
-// Forward declarations
-struct Item;
-
-/**
- * Customer structure representing a NPC customer
- * Each customer wants to buy specific items with certain quantities
- */
-struct Customer {
-    std::string name;              // Customer name 
-    std::string desired_item;      // Item they want to buy 
-    int desired_quantity;          // Quantity they want to buy
-    int patience;                  // How long they can tolerate your price
-    int base_price;                // Base price they're willing to pay per item
-    
-    /**
-     * Constructor for Customer struct
-     * What it does: Initializes a Customer object with specified attributes
-     * Inputs:
-     *   - n: Customer's name
-     *   - item: Name of the item the customer wants to buy
-     *   - qty: Quantity of items the customer wants
-     *   - pat: Customer's patience level (affects price negotiation)
-     *   - price: Base price per item the customer is willing to pay
-     * Outputs: None (constructor)
-     */
-    Customer(const std::string& n, const std::string& item, int qty, int pat, int price);
-    
-    /**
-     * Default constructor for Customer struct
-     * What it does: Creates an empty Customer object with default values
-     * Inputs: None
-     * Outputs: None (constructor)
-     */
-    Customer();
-};
-
-/**
- * Generate random customers for the night phase
- * What it does: Creates a vector of randomly generated customers based on current market trends.
- *               The quantity each customer wants is influenced by the demand growth system,
- *               where later days will have customers requesting more items.
- * Inputs:
- *   - trends: Reference to MarketTrends object containing current demand values for different item types
- *   - count: Number of customers to generate (1-3). If -1, randomly generates between MIN_CUSTOMERS and MAX_CUSTOMERS
- * Outputs: Returns a vector of Customer objects with randomly assigned names, desired items,
- *          quantities (affected by demand trends), patience levels, and base prices
- */
-std::vector<Customer> generateCustomers(MarketTrends& trends, int count = -1);
-
-/**
- * Get a random customer name from a predefined list
- * What it does: Selects and returns a random customer name from a predefined pool of names
- *               representing different survivor archetypes (e.g., "Old Hunter", "Anxious Mother")
- * Inputs: None
- * Outputs: Returns a string containing a randomly selected customer name
- */
-std::string getRandomCustomerName();
-
-/**
- * Get a random desired item for a customer
- * What it does: Selects and returns a random item name from a predefined list of items
- *               that customers might want to purchase (e.g., "Canned food", "Scrap Metal")
- * Inputs: None
- * Outputs: Returns a string containing a randomly selected item name
- */
-std::string getRandomDesiredItem();
-
-#endif // CUSTOMER_H
-
-
+#ifndef CUSTOMER_H
+#define CUSTOMER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Market.h"  // For MarketTrends definition
+
+// Forward declarations
+struct Item;
+
+/**
+ * Customer structure representing a NPC customer
+ * Each customer wants to buy specific items with certain quantities
+ */
+struct Customer {
+    std::string name;              // Customer name 
+    std::string desired_item;      // Item they want to buy 
+    int desired_quantity;          // Quantity they want to buy
+    int patience;                  // How long they can tolerate your price
+    int base_price;                // Base price they're willing to pay per item
+    
+    /**
+     * Constructor for Customer struct
+     * What it does: Initializes a Customer object with specified attributes
+     * Inputs:
+     *   - n: Customer's name
+     *   - item: Name of the item the customer wants to buy
+     *   - qty: Quantity of items the customer wants
+     *   - pat: Customer's patience level (affects price negotiation)
+     *   - price: Base price per item the customer is willing to pay
+     * Outputs: None (constructor)
+     */
+    Customer(const std::string& n, const std::string& item, int qty, int pat, int price);
+    
+    /**
+     * Default constructor for Customer struct
+     * What it does: Creates an empty Customer object with default values
+     * Inputs: None
+     * Outputs: None (constructor)
+     */
+    Customer();
+};
+
+/**
+ * Structure-of-arrays roster of customers for the bazaar
+ * Names and desired items are stored as small ids into the customer tables, every other
+ * attribute lives in its own array so pricing and summaries are plain loops over numbers
+ */
+struct CustomerRoster {
+    std::vector<uint8_t> name_id;       // Index into the customer name table
+    std::vector<uint8_t> item_atom;     // Index into the desired item table
+    std::vector<int> quantity;          // Quantity each customer wants
+    std::vector<int> patience;          // Patience of each customer
+    std::vector<int> base_price;        // Base price per item
+    std::vector<int> offer;             // Total offer for the full quantity
+
+    /**
+     * Remove every customer
+     * What it does: Clears all arrays while keeping their capacity for the next night
+     * Inputs: None
+     * Outputs: None (modifies all member arrays)
+     */
+    void clear();
+
+    /**
+     * Get the number of customers
+     * What it does: Returns how many customers are in the roster
+     * Inputs: None
+     * Outputs: Returns the number of customers
+     */
+    int size() const { return static_cast<int>(quantity.size()); }
+
+    /**
+     * Build a Customer from one roster entry
+     * What it does: Expands the ids of entry "index" back to names so the entry can go through
+     *               the normal trade flow
+     * Inputs:
+     *   - index: Index of the customer in the roster
+     * Outputs: Returns a Customer with the entry's attributes
+     */
+    Customer toCustomer(int index) const;
+};
+
+/**
+ * Generate random customers for the night phase
+ * What it does: Creates a vector of randomly generated customers based on current market trends.
+ *               The quantity each customer wants is influenced by the demand growth system,
+ *               where later days will have customers requesting more items.
+ * Inputs:
+ *   - trends: Reference to MarketTrends object containing current demand values for different item types
+ *   - rng: Session random generator used for every roll
+ *   - count: Number of customers to generate (1-3). If -1, randomly generates between MIN_CUSTOMERS and MAX_CUSTOMERS
+ * Outputs: Returns a vector of Customer objects with randomly assigned names, desired items,
+ *          quantities (affected by demand trends), patience levels, and base prices
+ */
+std::vector<Customer> generateCustomers(MarketTrends& trends, CustomerRng& rng, int count = -1);
+
+/**
+ * Generate a bazaar crowd
+ * What it does: Fills a CustomerRoster with "count" customers. The rolls are made in one pass,
+ *               then demand, base prices and offers are computed in separate passes over the arrays.
+ * Inputs:
+ *   - trends: Current market demand values
+ *   - rng: Session random generator used for every roll
+ *   - count: Number of customers to generate
+ *   - roster: Roster to fill, its previous content is discarded
+ * Outputs: None (fills roster)
+ */
+void generateBazaar(const MarketTrends& trends, CustomerRng& rng, int count, CustomerRoster& roster);
+
+/**
+ * Calculate the total price a customer pays
+ * What it does: Multiplies the base price per item by the quantity and applies the patience multiplier
+ *               (patience multiplier = 1.0 + (patience - 1) * 0.1)
+ * Inputs:
+ *   - basePrice: Base price per item
+ *   - patience: Customer's patience level
+ *   - quantity: Number of items being sold
+ * Outputs: Returns the total price of the transaction
+ */
+int calculateTradePrice(int basePrice, int patience, int quantity);
+
+/**
+ * Get a random customer name from a predefined list
+ * What it does: Selects and returns a random customer name from a predefined pool of names
+ *               representing different survivor archetypes (e.g., "Old Hunter", "Anxious Mother")
+ * Inputs:
+ *   - rng: Session random generator
+ * Outputs: Returns a string containing a randomly selected customer name
+ */
+std::string getRandomCustomerName(CustomerRng& rng);
+
+/**
+ * Get a random desired item for a customer
+ * What it does: Selects and returns a random item name from a predefined list of items
+ *               that customers might want to purchase (e.g., "Canned food", "Scrap Metal")
+ * Inputs:
+ *   - rng: Session random generator
+ * Outputs: Returns a string containing a randomly selected item name
+ */
+std::string getRandomDesiredItem(CustomerRng& rng);
+
+/**
+ * Get the number of items customers can ask for
+ * What it does: Returns the size of the desired item table, i.e. the number of item atoms
+ * Inputs: None
+ * Outputs: Returns the number of desired items
+ */
+int getDesiredItemCount();
+
+/**
+ * Get a desired item name by atom
+ * What it does: Returns the name of the item with the given atom
+ * Inputs:
+ *   - atom: Index into the desired item table
+ * Outputs: Returns the item name
+ */
+const std::string& getDesiredItemName(int atom);
+
+/**
+ * Get the base price of a desired item
+ * What it does: Returns the reference price per item used when customers are generated
+ * Inputs:
+ *   - atom: Index into the desired item table
+ * Outputs: Returns the base price per item
+ */
+int getDesiredItemBasePrice(int atom);
+
+#endif // CUSTOMER_H
@@ -1,272 +1,534 @@
-#include "Market.h"
-#include "../Core/Config.h"
-#include "../Item/itemdatabase.h"
-#include "../Item/item.h"
-#include "../Player/Player.h"
-#include <iostream>
-#include <algorithm>
-#include <cstdlib>
-#include <ctime>
-
-/**
- * MarketTrends constructor
- * What it does: Initializes all demand values (food, water, medicine, metal, tool) to 1.0,
- *               representing baseline demand at the start of the game
- * Inputs: None
- * Outputs: None (constructor initializes all demand fields to 1.0)
- */
-MarketTrends::MarketTrends() 
-    : food_demand(1.0f), water_demand(1.0f), medicine_demand(1.0f), 
-      metal_demand(1.0f), tool_demand(1.0f) {
-}
-
-/**
- * Get demand for a specific item type
- * What it does: Maps an item name to its corresponding demand category and returns the current
- *               demand multiplier. Items are categorized into food, medicine, metal, or tool demands.
- * Inputs:
- *   - itemName: Name of the item to look up (e.g., "Canned food", "Bandage", "Scrap Metal")
- * Outputs: Returns a float representing the current demand multiplier for the item's category.
- *          Returns food_demand as default for unknown items
- */
-float MarketTrends::getDemandForItem(const std::string& itemName) const {
-    // Map item names to demand types
-    if (itemName == "Canned food" || itemName == "Military Rations" || itemName == "Water") {
-        return food_demand;
-    } else if (itemName == "Bandage" || itemName == "First Aid Kit") {
-        return medicine_demand;
-    } else if (itemName == "Scrap Metal" || itemName == "Electronic Component" || 
-               itemName == "Gold Ring" || itemName == "Rag") {
-        return metal_demand;
-    } else if (itemName == "Crowbar" || itemName == "Lock pick") {
-        return tool_demand;
-    }
-    // Default to food demand for unknown items
-    return food_demand;
-}
-
-/**
- * BlackMarketItem constructor
- * What it does: Initializes a BlackMarketItem with the provided name, display name, price, and description
- * Inputs:
- *   - name: Internal item identifier used for item creation
- *   - display: Display name shown to players
- *   - cost: Purchase price in money units
- *   - desc: Item description text
- * Outputs: None (constructor initializes member variables)
- */
-BlackMarketItem::BlackMarketItem(const std::string& name, const std::string& display, 
-                                 int cost, const std::string& desc)
-    : item_name(name), display_name(display), price(cost), description(desc) {
-}
-
-/**
- * Market constructor
- * What it does: Initializes a Market object by creating default MarketTrends and populating
- *               the black market stock with available items
- * Inputs: None
- * Outputs: None (constructor initializes trends and calls initializeBlackMarket)
- */
-Market::Market() {
-    trends = MarketTrends();
-    initializeBlackMarket();
-}
-
-/**
- * Market destructor
- * What it does: Cleans up Market object. Currently no dynamic memory to deallocate.
- * Inputs: None
- * Outputs: None (destructor)
- */
-Market::~Market() {
-    // No dynamic memory to clean up
-}
-
-/**
- * Initialize black market stock
- * What it does: Populates the blackMarketStock vector with predefined items that players can purchase
- *               from the black market merchant, including weapons, tools, medical supplies, and consumables
- * Inputs: None
- * Outputs: None (modifies blackMarketStock member variable by adding BlackMarketItem objects)
- */
-void Market::initializeBlackMarket() {
-    blackMarketStock.clear();
-    
-    // Add items available from black market
-    // These should match items from ItemDatabase that are sold in the store
-    blackMarketStock.push_back(BlackMarketItem(
-        "Military Rations", "Military Rations", 25,
-        "High-quality food that restores 40 HP and 25 Stamina"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "Bandage", "Bandage", 5,
-        "Basic medical supplies that restore 15 HP"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "First Aid Kit", "First Aid Kit", 30,
-        "Advanced medical supplies that restore 50 HP"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "Crowbar", "Crowbar", 25,
-        "Tool for opening sealed containers (20 durability)"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "Lock pick", "Lock pick", 45,
-        "Professional lock-picking tool (15 durability)"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "Baseball Bat", "Baseball Bat", 20,
-        "Reliable melee weapon (15 damage, 50 durability)"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "Shotgun", "Shotgun", 80,
-        "Reliable ranged weapon (45 damage, 30 durability)"
-    ));
-    
-    blackMarketStock.push_back(BlackMarketItem(
-        "Bullet", "Bullet", 2,
-        "Shotgun ammunition"
-    ));
-}
-
-/**
- * Update market trends
- * What it does: Increases all demand values (food, water, medicine, metal, tool) by the growth rate
- *               determined by the current game difficulty. This implements the core innovation where
- *               customer demands grow over time (e.g., 5% per day). The growth rate is retrieved from
- *               Config.h based on difficulty level (Easy, Normal, Hard).
- * Inputs: None
- * Outputs: None (modifies trends member variable by multiplying each demand field by the appropriate growth rate)
- */
-void Market::updateTrends() {
-    // Use DEMAND_GROWTH_RATE from Config.h based on current difficulty
-    float growthRate = NormalConfig::DEMAND_GROWTH_RATE;  // Default to normal
-    
-    // Get current difficulty from itemdatabase
-    int difficulty = getGameDifficulty();
-    switch (difficulty) {
-        case DIFFICULTY_EASY:
-            growthRate = EasyConfig::DEMAND_GROWTH_RATE;
-            break;
-        case DIFFICULTY_NORMAL:
-            growthRate = NormalConfig::DEMAND_GROWTH_RATE;
-            break;
-        case DIFFICULTY_HARD:
-            growthRate = HardConfig::DEMAND_GROWTH_RATE;
-            break;
-        default:
-            growthRate = NormalConfig::DEMAND_GROWTH_RATE;
-            break;
-    }
-    
-    trends.food_demand *= growthRate;
-    trends.water_demand *= growthRate;
-    trends.medicine_demand *= growthRate;
-    trends.metal_demand *= growthRate;
-    trends.tool_demand *= growthRate;
-}
-
-/**
- * Set market trends
- * What it does: Replaces the current market trends with new values. Primarily used when loading
- *               a saved game to restore the market state from a previous session.
- * Inputs:
- *   - newTrends: MarketTrends object containing the demand values to restore
- * Outputs: None (modifies trends member variable by assignment)
- */
-void Market::setTrends(const MarketTrends& newTrends) {
-    trends = newTrends;
-}
-
-/**
- * Display black market menu
- * What it does: Prints a formatted menu to the console showing all available black market items.
- *               For each item, displays its number, display name, price, and description.
- *               Also shows option [0] to return to the previous menu.
- * Inputs: None
- * Outputs: None (prints formatted menu to standard output)
- */
-void Market::displayBlackMarket() const {
-    std::cout << "\n=== Black Market Merchant ===" << std::endl;
-    std::cout << "Welcome to the black market! Here are all the items you need.\n" << std::endl;
-    
-    for (size_t i = 0; i < blackMarketStock.size(); i++) {
-        const BlackMarketItem& item = blackMarketStock[i];
-        std::cout << "[" << (i + 1) << "] " << item.display_name 
-                  << " - " << item.price << " Money" << std::endl;
-        std::cout << "    " << item.description << std::endl;
-    }
-    std::cout << "[0] Return" << std::endl;
-}
-
-/**
- * Purchase item from black market
- * What it does: Processes a purchase transaction for the player. First verifies the item exists in
- *               the black market stock, then checks if the player has sufficient funds. If both checks
- *               pass, creates the item using ItemDatabase::createItem(), deducts the price from player's
- *               money, adds the item to player's inventory, and displays confirmation messages.
- * Inputs:
- *   - player: Reference to Player object making the purchase
- *   - itemName: Name of the item to purchase (must match item_name in blackMarketStock)
- * Outputs: Returns true if purchase was successful (item found, sufficient funds, item created).
- *          Returns false if item not found, insufficient funds, or item creation failed.
- *          Prints error messages to console on failure.
- */
-bool Market::purchaseFromBlackMarket(Player& player, const std::string& itemName) {
-    const BlackMarketItem* item = getBlackMarketItem(itemName);
-    if (!item) {
-        std::cout << "Error: Item not found" << std::endl;
-        return false;
-    }
-    
-    // Check if player has enough money
-    if (player.money < item->price) {
-        std::cout << "Insufficient funds!" << std::endl;
-        std::cout << "Need: " << item->price << " Money" << std::endl;
-        std::cout << "Have: " << player.money << " Money" << std::endl;
-        return false;
-    }
-    
-    // Create the item using ItemDatabase
-    Item* newItem = createItem(itemName);
-    if (!newItem) {
-        std::cout << "Error: Cannot create item" << std::endl;
-        return false;
-    }
-    
-    // Deduct money
-    player.money -= item->price;
-    
-    // Add item to inventory
-    player.addItem(newItem);
-    
-    std::cout << "Purchase successful!" << std::endl;
-    std::cout << "Obtained: " << item->display_name << std::endl;
-    std::cout << "Remaining money: " << player.money << std::endl;
-    
-    return true;
-}
-
-/**
- * Get black market item by name
- * What it does: Searches through the black market stock vector to find an item matching the given name.
- *               Uses linear search to compare item_name fields.
- * Inputs:
- *   - itemName: Name of the item to search for (must match item_name exactly)
- * Outputs: Returns a pointer to the BlackMarketItem if found, nullptr if no matching item exists
- */
-const BlackMarketItem* Market::getBlackMarketItem(const std::string& itemName) const {
-    for (const auto& item : blackMarketStock) {
-        if (item.item_name == itemName) {
-            return &item;
-        }
-    }
-    return nullptr;
-}
-
+#include "Market.h"
+#include "../Core/UISystem.h"
+#include "../Core/Config.h"
+#include "../Item/itemdatabase.h"
+#include "../Item/item.h"
+#include "../Player/Player.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+#include <istream>
+#include <ostream>
+
+/**
+ * MarketTrends constructor
+ * What it does: Initializes every category's demand to 1.0, representing baseline demand at the start of the game
+ * Inputs: None
+ * Outputs: None (constructor initializes all demand buckets to 1.0)
+ */
+MarketTrends::MarketTrends() {
+    std::fill(demand, demand + CATEGORY_COUNT, 1.0f);
+}
+
+/**
+ * Get demand for an item category
+ * What it does: Indexes the demand table by category
+ * Inputs:
+ *   - category: One of the CATEGORY_* constants
+ * Outputs: Returns the demand multiplier, or 1.0 (baseline) for a category outside the table
+ */
+float MarketTrends::getDemandForCategory(int category) const {
+    if (category < 0 || category >= CATEGORY_COUNT) {
+        return 1.0f;
+    }
+    return demand[category];
+}
+
+/**
+ * Get demand for an item prototype
+ * What it does: Finds the category of the prototype in the item database and returns its demand
+ * Inputs:
+ *   - itemId: Prototype ID of the item (e.g., 4 for "Canned food")
+ * Outputs: Returns the demand multiplier of the item's category, or 1.0 (baseline) for unknown items
+ */
+float MarketTrends::getDemandForItemId(int itemId) const {
+    const Item* prototype = getItemPrototype(itemId);
+    if (!prototype) {
+        return 1.0f;
+    }
+    return getDemandForCategory(prototype->category);
+}
+
+/**
+ * Project demand several days ahead
+ * What it does: Growth compounds once per night, so N nights of growth is a single factor rate^N
+ *               applied to every category
+ * Inputs:
+ *   - growthRate: Growth per night
+ *   - days: Number of nights to project, values below 0 are treated as 0
+ * Outputs: Returns a MarketTrends holding the projected demand
+ */
+MarketTrends MarketTrends::projected(float growthRate, int days) const {
+    float factor = std::pow(growthRate, static_cast<float>(std::max(days, 0)));
+    MarketTrends result;
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        result.demand[i] = demand[i] * factor;
+    }
+    return result;
+}
+
+/**
+ * CustomerRng constructor
+ * What it does: Stores the seed, replacing zero with a fixed non-zero value
+ * Inputs:
+ *   - seed: Seed value for the session
+ * Outputs: None (constructor initializes state)
+ */
+CustomerRng::CustomerRng(uint32_t seed)
+    : state(seed ? seed : 0x9E3779B9u) {
+}
+
+/**
+ * Get the next random value
+ * What it does: Advances the xorshift32 state
+ * Inputs: None
+ * Outputs: Returns the new state
+ */
+uint32_t CustomerRng::next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/**
+ * Get a random integer in a range
+ * What it does: Maps the next random value onto [low, high]
+ * Inputs:
+ *   - low: Smallest value that can be returned
+ *   - high: Largest value that can be returned
+ * Outputs: Returns an integer in [low, high]
+ */
+int CustomerRng::range(int low, int high) {
+    uint32_t span = static_cast<uint32_t>(high - low + 1);
+    return low + static_cast<int>(next() % span);
+}
+
+/**
+ * Get a random float between 0 and 1
+ * What it does: Uses the top 24 bits of the next value as the mantissa of the result
+ * Inputs: None
+ * Outputs: Returns a float in [0, 1)
+ */
+float CustomerRng::unit() {
+    return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * BlackMarketItem constructor
+ * What it does: Initializes a BlackMarketItem with the provided prototype, names, base price, stock and
+ *               description. The current price starts at the base price and the category comes from
+ *               the item database (-1 if the prototype is unknown).
+ * Inputs:
+ *   - id: Prototype ID used for item creation
+ *   - name: Internal item identifier
+ *   - display: Display name shown to players
+ *   - cost: Base price in money units
+ *   - units: Stock the merchant carries each night
+ *   - desc: Item description text
+ * Outputs: None (constructor initializes member variables)
+ */
+BlackMarketItem::BlackMarketItem(int id, const std::string& name, const std::string& display,
+                                 int cost, int units, const std::string& desc)
+    : item_id(id), item_name(name), display_name(display), category(-1),
+      base_price(cost), price(cost), base_stock(units), stock(units), description(desc) {
+    const Item* prototype = getItemPrototype(id);
+    if (prototype) {
+        category = prototype->category;
+    }
+}
+
+/**
+ * Market constructor
+ * What it does: Initializes a Market object by creating default MarketTrends, seeding the
+ *               customer generator for the session and populating the black market stock with available items
+ * Inputs: None
+ * Outputs: None (constructor initializes trends and calls initializeBlackMarket)
+ */
+Market::Market()
+    : customerRng(static_cast<uint32_t>(time(NULL))), pendingVolume(0), pendingValue(0) {
+    trends = MarketTrends();
+    initializeBlackMarket();
+}
+
+/**
+ * Market destructor
+ * What it does: Cleans up Market object. Currently no dynamic memory to deallocate.
+ * Inputs: None
+ * Outputs: None (destructor)
+ */
+Market::~Market() {
+    // No dynamic memory to clean up
+}
+
+/**
+ * Initialize black market stock
+ * What it does: Populates the blackMarketStock vector with predefined items that players can purchase
+ *               from the black market merchant, including weapons, tools, medical supplies, and consumables
+ * Inputs: None
+ * Outputs: None (modifies blackMarketStock member variable by adding BlackMarketItem objects)
+ */
+void Market::initializeBlackMarket() {
+    blackMarketStock.clear();
+    
+    // Add items available from black market
+    // These should match items from ItemDatabase that are sold in the store
+    blackMarketStock.push_back(BlackMarketItem(
+        6, "Military Rations", "Military Rations", 25, 5,
+        "High-quality food that restores 40 HP and 25 Stamina"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        7, "Bandage", "Bandage", 5, 10,
+        "Basic medical supplies that restore 15 HP"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        8, "First Aid Kit", "First Aid Kit", 30, 3,
+        "Advanced medical supplies that restore 50 HP"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        9, "Crowbar", "Crowbar", 25, 2,
+        "Tool for opening sealed containers (20 durability)"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        10, "Lock pick", "Lock pick", 45, 1,
+        "Professional lock-picking tool (15 durability)"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        11, "Baseball Bat", "Baseball Bat", 20, 2,
+        "Reliable melee weapon (15 damage, 50 durability)"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        12, "Shotgun", "Shotgun", 80, 1,
+        "Reliable ranged weapon (45 damage, 30 durability)"
+    ));
+    
+    blackMarketStock.push_back(BlackMarketItem(
+        13, "Bullet", "Bullet", 2, 30,
+        "Shotgun ammunition"
+    ));
+    
+    // Index the catalog by prototype ID
+    int maxId = 0;
+    for (const auto& item : blackMarketStock) {
+        maxId = std::max(maxId, item.item_id);
+    }
+    blackMarketIndex.assign(maxId + 1, -1);
+    for (size_t i = 0; i < blackMarketStock.size(); i++) {
+        blackMarketIndex[blackMarketStock[i].item_id] = static_cast<int>(i);
+    }
+}
+
+/**
+ * Update market trends
+ * What it does: Increases every category's demand by the growth rate
+ *               determined by the current game difficulty. This implements the core innovation where
+ *               customer demands grow over time (e.g., 5% per day). The growth rate is retrieved from
+ *               Config.h based on difficulty level (Easy, Normal, Hard).
+ * Inputs: None
+ * Outputs: None (modifies trends member variable by multiplying each demand bucket by the appropriate growth rate)
+ */
+void Market::updateTrends() {
+    updateTrends(getGameDifficulty());
+}
+
+/**
+ * Update market trends for a given difficulty
+ * What it does: Multiplies every category's demand by the DEMAND_GROWTH_RATE of "difficulty"
+ * Inputs:
+ *   - difficulty: One of the DIFFICULTY_* values
+ * Outputs: None (modifies trends member variable)
+ */
+void Market::updateTrends(int difficulty) {
+    float growthRate = getGrowthRate(difficulty);
+    
+    for (int i = 0; i < CATEGORY_COUNT; i++) {
+        trends.demand[i] *= growthRate;
+    }
+}
+
+/**
+ * Get the demand growth rate of a difficulty
+ * What it does: Maps a difficulty level (Easy, Normal, Hard) to its DEMAND_GROWTH_RATE from Config.h
+ * Inputs:
+ *   - difficulty: One of the DIFFICULTY_* values
+ * Outputs: Returns the growth per night, Normal's rate for unknown values
+ */
+float Market::getGrowthRate(int difficulty) {
+    switch (difficulty) {
+        case DIFFICULTY_EASY:
+            return EasyConfig::DEMAND_GROWTH_RATE;
+        case DIFFICULTY_HARD:
+            return HardConfig::DEMAND_GROWTH_RATE;
+        case DIFFICULTY_NORMAL:
+        default:
+            return NormalConfig::DEMAND_GROWTH_RATE;
+    }
+}
+
+/**
+ * Project market trends several days ahead
+ * What it does: Projects the current demand with the growth rate of the current difficulty
+ * Inputs:
+ *   - days: Number of nights to project
+ * Outputs: Returns the projected MarketTrends
+ */
+MarketTrends Market::projectTrends(int days) const {
+    return trends.projected(getGrowthRate(getGameDifficulty()), days);
+}
+
+/**
+ * Project the demand of one category
+ * What it does: Multiplies the category's current demand by rate^days
+ * Inputs:
+ *   - category: One of the CATEGORY_* constants
+ *   - days: Number of nights to project
+ * Outputs: Returns the projected demand multiplier, 1.0 for unknown categories
+ */
+float Market::projectDemand(int category, int days) const {
+    if (category < 0 || category >= CATEGORY_COUNT) {
+        return 1.0f;
+    }
+    float rate = getGrowthRate(getGameDifficulty());
+    return trends.demand[category] * std::pow(rate, static_cast<float>(std::max(days, 0)));
+}
+
+/**
+ * Project market trends for every difficulty
+ * What it does: Projects the current demand once per difficulty profile
+ * Inputs:
+ *   - days: Number of nights to project
+ *   - out: Array of DIFFICULTY_COUNT trends, indexed by DIFFICULTY_* value
+ * Outputs: None (fills out)
+ */
+void Market::projectAllDifficulties(int days, MarketTrends out[DIFFICULTY_COUNT]) const {
+    for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+        out[d] = trends.projected(getGrowthRate(d), days);
+    }
+}
+
+/**
+ * Set market trends
+ * What it does: Replaces the current market trends with new values. Primarily used when loading
+ *               a saved game to restore the market state from a previous session.
+ * Inputs:
+ *   - newTrends: MarketTrends object containing the demand values to restore
+ * Outputs: None (modifies trends member variable by assignment)
+ */
+void Market::setTrends(const MarketTrends& newTrends) {
+    trends = newTrends;
+}
+
+/**
+ * Record a trade
+ * What it does: Adds the quantity and money of a sale to the current day's counters
+ * Inputs:
+ *   - quantity: Number of items traded
+ *   - money: Total money paid for them
+ * Outputs: None (modifies pendingVolume and pendingValue)
+ */
+void Market::recordTrade(int quantity, int money) {
+    pendingVolume += quantity;
+    pendingValue += money;
+}
+
+/**
+ * Close the current day
+ * What it does: Builds a history row from the demand table and the trade counters, appends it,
+ *               and starts counting the next day from zero
+ * Inputs:
+ *   - day: Day number to record
+ * Outputs: None (modifies history, pendingVolume and pendingValue)
+ */
+void Market::closeDay(int day) {
+    float row[HISTORY_COLUMN_COUNT];
+    std::copy(trends.demand, trends.demand + CATEGORY_COUNT, row);
+    row[HISTORY_VOLUME] = static_cast<float>(pendingVolume);
+    row[HISTORY_VALUE] = static_cast<float>(pendingValue);
+    history.append(day, row);
+    pendingVolume = 0;
+    pendingValue = 0;
+}
+
+/**
+ * Write the market state to a save
+ * What it does: Writes the number of categories and their demand, the trade counters of the
+ *               current day, then the history columns
+ * Inputs:
+ *   - out: Binary output stream
+ * Outputs: None (writes to out)
+ */
+void Market::serialize(std::ostream& out) const {
+    int32_t categories = CATEGORY_COUNT;
+    out.write(reinterpret_cast<const char*>(&categories), sizeof(categories));
+    out.write(reinterpret_cast<const char*>(trends.demand), sizeof(float) * CATEGORY_COUNT);
+    out.write(reinterpret_cast<const char*>(&pendingVolume), sizeof(pendingVolume));
+    out.write(reinterpret_cast<const char*>(&pendingValue), sizeof(pendingValue));
+    history.write(out);
+}
+
+/**
+ * Read the market state from a save
+ * What it does: Reads the demand table, the trade counters and the history written by serialize()
+ * Inputs:
+ *   - in: Binary input stream
+ * Outputs: Returns true if the state was read completely, false if the data is truncated or was
+ *          written with a different number of categories. Black market prices follow the loaded demand.
+ */
+bool Market::deserialize(std::istream& in) {
+    int32_t categories = 0;
+    in.read(reinterpret_cast<char*>(&categories), sizeof(categories));
+    if (!in.good() || categories != CATEGORY_COUNT) {
+        return false;
+    }
+    MarketTrends loaded;
+    in.read(reinterpret_cast<char*>(loaded.demand), sizeof(float) * CATEGORY_COUNT);
+    in.read(reinterpret_cast<char*>(&pendingVolume), sizeof(pendingVolume));
+    in.read(reinterpret_cast<char*>(&pendingValue), sizeof(pendingValue));
+    if (in.fail()) {
+        return false;
+    }
+    trends = loaded;
+    refreshBlackMarket();
+    return history.read(in);
+}
+
+/**
+ * Display black market menu
+ * What it does: Prints a formatted menu to the console showing all available black market items.
+ *               For each item, displays its number, display name, price, stock, and description.
+ *               Also shows option [0] to return to the previous menu.
+ * Inputs: None
+ * Outputs: None (prints formatted menu to standard output)
+ */
+void Market::displayBlackMarket() const {
+    UISystem::out() << "\n=== Black Market Merchant ===" << std::endl;
+    UISystem::out() << "Welcome to the black market! Here are all the items you need.\n" << std::endl;
+    
+    for (size_t i = 0; i < blackMarketStock.size(); i++) {
+        const BlackMarketItem& item = blackMarketStock[i];
+        UISystem::out() << "[" << (i + 1) << "] " << item.display_name 
+                  << " - " << item.price << " Money";
+        if (item.stock > 0) {
+            UISystem::out() << " (" << item.stock << " left)" << std::endl;
+        } else {
+            UISystem::out() << " (sold out)" << std::endl;
+        }
+        UISystem::out() << "    " << item.description << std::endl;
+    }
+    UISystem::out() << "[0] Return" << std::endl;
+}
+
+/**
+ * Refresh the black market for a new night
+ * What it does: Walks the catalog once, resetting each item's stock to its base stock and its price
+ *               to base price x demand of the item's category (at least 1 Money)
+ * Inputs: None
+ * Outputs: None (modifies price and stock of every black market item)
+ */
+void Market::refreshBlackMarket() {
+    for (auto& item : blackMarketStock) {
+        float demand = trends.getDemandForCategory(item.category);
+        item.price = std::max(1, static_cast<int>(item.base_price * demand + 0.5f));
+        item.stock = item.base_stock;
+    }
+}
+
+/**
+ * Take an item from the black market stock
+ * What it does: Finds the item through the ID index, checks stock and budget and removes one unit
+ * Inputs:
+ *   - itemId: Prototype ID of the item
+ *   - budget: Money the buyer can spend
+ *   - paid: Set to the price of the unit on success
+ * Outputs: Returns true if a unit was taken, false if the item is not sold, sold out or too expensive
+ */
+bool Market::takeFromBlackMarket(int itemId, int budget, int& paid) {
+    if (itemId < 0 || itemId >= static_cast<int>(blackMarketIndex.size()) || blackMarketIndex[itemId] < 0) {
+        return false;
+    }
+    BlackMarketItem& item = blackMarketStock[blackMarketIndex[itemId]];
+    if (item.stock <= 0 || budget < item.price) {
+        return false;
+    }
+    item.stock--;
+    paid = item.price;
+    return true;
+}
+
+/**
+ * Purchase item from black market
+ * What it does: Processes a purchase transaction for the player. Verifies the item is in the catalog,
+ *               in stock and affordable, creates the item from its prototype, takes the unit from
+ *               stock, deducts the price from player's money, adds the item to player's inventory,
+ *               and displays confirmation messages.
+ * Inputs:
+ *   - player: Reference to Player object making the purchase
+ *   - itemId: Prototype ID of the item to purchase
+ * Outputs: Returns true if purchase was successful (item found, in stock, sufficient funds, item created).
+ *          Returns false if item not found, sold out, insufficient funds, or item creation failed.
+ *          Prints error messages to console on failure.
+ */
+bool Market::purchaseFromBlackMarket(Player& player, int itemId) {
+    const BlackMarketItem* item = getBlackMarketItem(itemId);
+    if (!item) {
+        UISystem::out() << "Error: Item not found" << std::endl;
+        return false;
+    }
+    
+    if (item->stock <= 0) {
+        UISystem::out() << "Sold out! Come back tomorrow night." << std::endl;
+        return false;
+    }
+    
+    // Check if player has enough money
+    if (player.money < item->price) {
+        UISystem::out() << "Insufficient funds!" << std::endl;
+        UISystem::out() << "Need: " << item->price << " Money" << std::endl;
+        UISystem::out() << "Have: " << player.money << " Money" << std::endl;
+        return false;
+    }
+    
+    // Create the item from its prototype
+    Item* newItem = findItemById(itemId);
+    if (!newItem) {
+        UISystem::out() << "Error: Cannot create item" << std::endl;
+        return false;
+    }
+    
+    int paid = 0;
+    takeFromBlackMarket(itemId, player.money, paid);
+    
+    // Deduct money
+    player.money -= paid;
+    
+    // Add item to inventory
+    player.addItem(newItem);
+    
+    UISystem::out() << "Purchase successful!" << std::endl;
+    UISystem::out() << "Obtained: " << item->display_name << std::endl;
+    UISystem::out() << "Remaining money: " << player.money << std::endl;
+    
+    return true;
+}
+
+/**
+ * Get black market item by ID
+ * What it does: Looks the prototype ID up in the catalog index, an O(1) array access
+ * Inputs:
+ *   - itemId: Prototype ID of the item
+ * Outputs: Returns a pointer to the BlackMarketItem if it is sold, nullptr otherwise
+ */
+const BlackMarketItem* Market::getBlackMarketItem(int itemId) const {
+    if (itemId < 0 || itemId >= static_cast<int>(blackMarketIndex.size()) || blackMarketIndex[itemId] < 0) {
+        return nullptr;
+    }
+    return &blackMarketStock[blackMarketIndex[itemId]];
+}
@@ -1,181 +1,384 @@
-#ifndef MARKET_H
-#define MARKET_H
-
-#include <string>
-#include <vector>
-#include <map>
-
-// Forward declarations
-struct Item;
-class Player;
-
-// Note: Config.h should define DEMAND_GROWTH_RATE constant
-// For now, we'll use a default value if Config.h doesn't exist
-// The implementation in Market.cpp should check for Config.h and use DEMAND_GROWTH_RATE if available
-
-/**
- * MarketTrends structure to track global demand trends
- * Demand grows over time, affecting customer purchase quantities
- */
-struct MarketTrends {
-    float food_demand;        // Demand for food items (initial 1.0)
-    float water_demand;       // Demand for water items (initial 1.0)
-    float medicine_demand;    // Demand for medicine items (initial 1.0)
-    float metal_demand;       // Demand for metal/scrap items (initial 1.0)
-    float tool_demand;        // Demand for tools (initial 1.0)
-    
-    /**
-     * Constructor for MarketTrends
-     * What it does: Initializes all demand values to 1.0, representing baseline demand at game start
-     * Inputs: None
-     * Outputs: None (constructor initializes all demand fields to 1.0)
-     */
-    MarketTrends();
-    
-    /**
-     * Get demand for a specific item type
-     * What it does: Maps an item name to its corresponding demand category and returns the current demand multiplier.
-     *               This is used to calculate how many items a customer wants based on market trends.
-     * Inputs:
-     *   - itemName: Name of the item to look up
-     * Outputs: Returns a float representing the current demand multiplier for the item's category.
-     *          Returns food_demand as default for unknown items
-     */
-    float getDemandForItem(const std::string& itemName) const;
-};
-
-/**
- * Black market merchant item entry
- * Represents an item that can be purchased from the black market
- */
-struct BlackMarketItem {
-    std::string item_name;    // Item identifier
-    std::string display_name; // Display name for the item
-    int price;                // Price to purchase
-    std::string description;  // Item description
-    
-    /**
-     * Constructor for BlackMarketItem
-     * What it does: Initializes a black market item with its identifier, display name, price, and description
-     * Inputs:
-     *   - name: Internal item identifier used for item creation
-     *   - display: Display name shown to the player in the black market menu
-     *   - cost: Price in money units required to purchase this item
-     *   - desc: Description text explaining what the item does
-     * Outputs: None (constructor initializes member variables)
-     */
-    BlackMarketItem(const std::string& name, const std::string& display, 
-                    int cost, const std::string& desc);
-};
-
-/**
- * Market class managing market trends and black market merchant
- */
-class Market {
-private:
-    MarketTrends trends;                           // Current market trends
-    std::vector<BlackMarketItem> blackMarketStock; // Items available from black market
-    
-    /**
-     * Initialize black market stock
-     * What it does: Populates the blackMarketStock vector with predefined items that players can purchase,
-     *               including weapons, tools, medical supplies, and consumables
-     * Inputs: None
-     * Outputs: None (modifies blackMarketStock member variable)
-     */
-    void initializeBlackMarket();
-    
-public:
-    /**
-     * Constructor for Market class
-     * What it does: Initializes a Market object with default MarketTrends and populates the black market stock
-     * Inputs: None
-     * Outputs: None (constructor initializes trends and calls initializeBlackMarket)
-     */
-    Market();
-    
-    /**
-     * Destructor for Market class
-     * What it does: Cleans up Market object resources (currently no dynamic memory to clean)
-     * Inputs: None
-     * Outputs: None (destructor)
-     */
-    ~Market();
-    
-    /**
-     * Update market trends
-     * What it does: Increases all demand values by the growth rate (e.g., 1.05 = 5% increase per day).
-     *               This implements the core innovation where customer demands grow over time.
-     *               Uses DEMAND_GROWTH_RATE from Config.h based on current difficulty level.
-     * Inputs: None
-     * Outputs: None (modifies trends member variable by multiplying each demand field by growth rate)
-     */
-    void updateTrends();
-    
-    /**
-     * Get current market trends (non-const version)
-     * What it does: Returns a reference to the current MarketTrends object for modification
-     * Inputs: None
-     * Outputs: Returns a reference to the trends member variable
-     */
-    MarketTrends& getTrends() { return trends; }
-    
-    /**
-     * Get current market trends (const version)
-     * What it does: Returns a const reference to the current MarketTrends object for read-only access
-     * Inputs: None
-     * Outputs: Returns a const reference to the trends member variable
-     */
-    const MarketTrends& getTrends() const { return trends; }
-    
-    /**
-     * Set market trends
-     * What it does: Replaces the current market trends with new values. Used primarily for loading saved games.
-     * Inputs:
-     *   - newTrends: MarketTrends object containing the new demand values to set
-     * Outputs: None (modifies trends member variable)
-     */
-    void setTrends(const MarketTrends& newTrends);
-    
-    /**
-     * Get black market stock
-     * What it does: Returns a const reference to the vector of items available in the black market
-     * Inputs: None
-     * Outputs: Returns a const reference to the blackMarketStock vector
-     */
-    const std::vector<BlackMarketItem>& getBlackMarketStock() const { return blackMarketStock; }
-    
-    /**
-     * Display black market menu
-     * What it does: Prints a formatted menu showing all available black market items with their prices
-     *               and descriptions to the console
-     * Inputs: None
-     * Outputs: None (prints to standard output)
-     */
-    void displayBlackMarket() const;
-    
-    /**
-     * Purchase item from black market
-     * What it does: Attempts to purchase an item from the black market for the player.
-     *               Checks if player has sufficient funds, creates the item using ItemDatabase,
-     *               deducts money from player, and adds item to player inventory.
-     * Inputs:
-     *   - player: Reference to Player object making the purchase
-     *   - itemName: Name of the item to purchase (must match an item in black market stock)
-     * Outputs: Returns true if purchase was successful, false if item not found, insufficient funds,
-     *          or item creation failed
-     */
-    bool purchaseFromBlackMarket(Player& player, const std::string& itemName);
-    
-    /**
-     * Get black market item by name
-     * What it does: Searches the black market stock for an item matching the given name
-     * Inputs:
-     *   - itemName: Name of the item to search for
-     * Outputs: Returns a pointer to the BlackMarketItem if found, nullptr otherwise
-     */
-    const BlackMarketItem* getBlackMarketItem(const std::string& itemName) const;
-};
-
-#endif // MARKET_H
-
+#ifndef MARKET_H
+#define MARKET_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
+#include <iosfwd>
+#include "../Item/item.h"  // For CATEGORY_COUNT
+#include "../Core/Config.h"   // For DIFFICULTY_COUNT
+#include "MarketHistory.h"
+
+// Forward declarations
+struct Item;
+class Player;
+
+// Note: Config.h should define DEMAND_GROWTH_RATE constant
+// For now, we'll use a default value if Config.h doesn't exist
+// The implementation in Market.cpp should check for Config.h and use DEMAND_GROWTH_RATE if available
+
+/**
+ * MarketTrends structure to track global demand trends
+ * Demand grows over time, affecting customer purchase quantities.
+ * There is one demand bucket per item category, indexed by the CATEGORY_* constants.
+ */
+struct MarketTrends {
+    float demand[CATEGORY_COUNT];  // Demand per item category (initial 1.0)
+    
+    /**
+     * Constructor for MarketTrends
+     * What it does: Initializes all demand values to 1.0, representing baseline demand at game start
+     * Inputs: None
+     * Outputs: None (constructor initializes every demand bucket to 1.0)
+     */
+    MarketTrends();
+    
+    /**
+     * Get demand for an item category
+     * What it does: Returns the current demand multiplier of the category
+     * Inputs:
+     *   - category: One of the CATEGORY_* constants
+     * Outputs: Returns the demand multiplier, or 1.0 for a category outside the table
+     */
+    float getDemandForCategory(int category) const;
+    
+    /**
+     * Get demand for an item prototype
+     * What it does: Looks up the category of the prototype and returns its demand multiplier.
+     *               This is used to calculate how many items a customer wants based on market trends.
+     * Inputs:
+     *   - itemId: Prototype ID of the item
+     * Outputs: Returns the demand multiplier of the item's category, or 1.0 for unknown items
+     */
+    float getDemandForItemId(int itemId) const;
+    
+    /**
+     * Project demand several days ahead
+     * What it does: Applies "days" nights of growth at once: every category is multiplied by growthRate^days
+     * Inputs:
+     *   - growthRate: Growth per night (e.g., 1.05)
+     *   - days: Number of nights to project, 0 returns the current demand
+     * Outputs: Returns a MarketTrends holding the projected demand
+     */
+    MarketTrends projected(float growthRate, int days) const;
+};
+
+/**
+ * Random number generator used for customer generation
+ * A small xorshift generator owned by the session's Market, so every night's crowd
+ * comes from one seeded stream instead of the global rand() state
+ */
+struct CustomerRng {
+    uint32_t state;                // Current generator state, never zero
+
+    /**
+     * Constructor for CustomerRng
+     * What it does: Seeds the generator. A zero seed is replaced because xorshift never leaves zero.
+     * Inputs:
+     *   - seed: Seed value for the session
+     * Outputs: None (constructor)
+     */
+    explicit CustomerRng(uint32_t seed = 1);
+
+    /**
+     * Get the next random value
+     * What it does: Advances the xorshift state and returns it
+     * Inputs: None
+     * Outputs: Returns a 32-bit pseudo-random value
+     */
+    uint32_t next();
+
+    /**
+     * Get a random integer in a range
+     * What it does: Returns a value between low and high, both included
+     * Inputs:
+     *   - low: Smallest value that can be returned
+     *   - high: Largest value that can be returned
+     * Outputs: Returns an integer in [low, high]
+     */
+    int range(int low, int high);
+
+    /**
+     * Get a random float between 0 and 1
+     * What it does: Converts the next 24 random bits to a float in [0, 1)
+     * Inputs: None
+     * Outputs: Returns a float in [0, 1)
+     */
+    float unit();
+};
+
+/**
+ * Black market merchant item entry
+ * Represents an item that can be purchased from the black market
+ */
+struct BlackMarketItem {
+    int item_id;              // Prototype ID in the item database
+    std::string item_name;    // Item identifier
+    std::string display_name; // Display name for the item
+    int category;             // Item category, drives the price through MarketTrends
+    int base_price;           // Price when demand is 1.0
+    int price;                // Current price, updated once per night
+    int base_stock;           // Stock the merchant restocks to
+    int stock;                // Units left tonight
+    std::string description;  // Item description
+    
+    /**
+     * Constructor for BlackMarketItem
+     * What it does: Initializes a black market item with its prototype, names, price, stock and description.
+     *               The category is taken from the item database so the price can follow demand.
+     * Inputs:
+     *   - id: Prototype ID used for item creation
+     *   - name: Internal item identifier
+     *   - display: Display name shown to the player in the black market menu
+     *   - cost: Base price in money units
+     *   - units: Stock the merchant carries each night
+     *   - desc: Description text explaining what the item does
+     * Outputs: None (constructor initializes member variables)
+     */
+    BlackMarketItem(int id, const std::string& name, const std::string& display,
+                    int cost, int units, const std::string& desc);
+};
+
+/**
+ * Market class managing market trends and black market merchant
+ */
+class Market {
+private:
+    MarketTrends trends;                           // Current market trends
+    CustomerRng customerRng;                       // Session generator for customers
+    MarketHistory history;                         // One row per finished night
+    int pendingVolume;                             // Items traded since the last closed day
+    int pendingValue;                              // Money those items were traded for
+    std::vector<BlackMarketItem> blackMarketStock; // Items available from black market, in menu order
+    std::vector<int> blackMarketIndex;             // Prototype ID -> slot in blackMarketStock, -1 if not sold
+    
+    /**
+     * Initialize black market stock
+     * What it does: Populates the blackMarketStock vector with predefined items that players can purchase,
+     *               including weapons, tools, medical supplies, and consumables, and builds the ID index
+     * Inputs: None
+     * Outputs: None (modifies blackMarketStock member variable)
+     */
+    void initializeBlackMarket();
+    
+public:
+    /**
+     * Constructor for Market class
+     * What it does: Initializes a Market object with default MarketTrends and populates the black market stock
+     * Inputs: None
+     * Outputs: None (constructor initializes trends and calls initializeBlackMarket)
+     */
+    Market();
+    
+    /**
+     * Destructor for Market class
+     * What it does: Cleans up Market object resources (currently no dynamic memory to clean)
+     * Inputs: None
+     * Outputs: None (destructor)
+     */
+    ~Market();
+    
+    /**
+     * Update market trends
+     * What it does: Increases all demand values by the growth rate (e.g., 1.05 = 5% increase per day).
+     *               This implements the core innovation where customer demands grow over time.
+     *               Uses DEMAND_GROWTH_RATE from Config.h based on current difficulty level.
+     * Inputs: None
+     * Outputs: None (modifies trends member variable by multiplying each demand bucket by growth rate)
+     */
+    void updateTrends();
+    
+    /**
+     * Update market trends for a given difficulty
+     * What it does: Same as updateTrends() but with an explicit difficulty instead of the global one,
+     *               so several simulated markets with different difficulties can run side by side
+     * Inputs:
+     *   - difficulty: One of the DIFFICULTY_* values
+     * Outputs: None (multiplies each demand bucket by that difficulty's growth rate)
+     */
+    void updateTrends(int difficulty);
+    
+    /**
+     * Get the demand growth rate of a difficulty
+     * What it does: Returns DEMAND_GROWTH_RATE from Config.h for the difficulty level
+     * Inputs:
+     *   - difficulty: One of the DIFFICULTY_* values, unknown values use Normal
+     * Outputs: Returns the growth per night
+     */
+    static float getGrowthRate(int difficulty);
+    
+    /**
+     * Project market trends several days ahead
+     * What it does: Computes the demand of every category "days" nights from now at the current
+     *               difficulty's growth rate, without simulating the nights in between
+     * Inputs:
+     *   - days: Number of nights to project
+     * Outputs: Returns the projected MarketTrends
+     */
+    MarketTrends projectTrends(int days) const;
+    
+    /**
+     * Project the demand of one category
+     * What it does: Same as projectTrends() for a single category
+     * Inputs:
+     *   - category: One of the CATEGORY_* constants
+     *   - days: Number of nights to project
+     * Outputs: Returns the projected demand multiplier, 1.0 for unknown categories
+     */
+    float projectDemand(int category, int days) const;
+    
+    /**
+     * Project market trends for every difficulty
+     * What it does: Fills one projection per difficulty profile from the current demand
+     * Inputs:
+     *   - days: Number of nights to project
+     *   - out: Array of DIFFICULTY_COUNT trends, indexed by DIFFICULTY_* value
+     * Outputs: None (fills out)
+     */
+    void projectAllDifficulties(int days, MarketTrends out[DIFFICULTY_COUNT]) const;
+    
+    /**
+     * Get current market trends (non-const version)
+     * What it does: Returns a reference to the current MarketTrends object for modification
+     * Inputs: None
+     * Outputs: Returns a reference to the trends member variable
+     */
+    MarketTrends& getTrends() { return trends; }
+    
+    /**
+     * Get current market trends (const version)
+     * What it does: Returns a const reference to the current MarketTrends object for read-only access
+     * Inputs: None
+     * Outputs: Returns a const reference to the trends member variable
+     */
+    const MarketTrends& getTrends() const { return trends; }
+    
+    /**
+     * Set market trends
+     * What it does: Replaces the current market trends with new values. Used primarily for loading saved games.
+     * Inputs:
+     *   - newTrends: MarketTrends object containing the new demand values to set
+     * Outputs: None (modifies trends member variable)
+     */
+    void setTrends(const MarketTrends& newTrends);
+    
+    /**
+     * Get the customer random generator
+     * What it does: Returns the session's generator so every night's customers come from one seeded stream
+     * Inputs: None
+     * Outputs: Returns a reference to the customerRng member variable
+     */
+    CustomerRng& getCustomerRng() { return customerRng; }
+    
+    /**
+     * Record a trade
+     * What it does: Adds a sale to the volume and value of the current day
+     * Inputs:
+     *   - quantity: Number of items traded
+     *   - money: Total money paid for them
+     * Outputs: None (modifies pendingVolume and pendingValue)
+     */
+    void recordTrade(int quantity, int money);
+    
+    /**
+     * Close the current day
+     * What it does: Appends the day's demand per category, volume and value to the history,
+     *               then resets the trade counters. Call before updateTrends() so the row holds
+     *               the demand that was in effect during the day.
+     * Inputs:
+     *   - day: Day number to record
+     * Outputs: None (modifies history, pendingVolume and pendingValue)
+     */
+    void closeDay(int day);
+    
+    /**
+     * Get the market history
+     * What it does: Returns the recorded per-day history for range queries
+     * Inputs: None
+     * Outputs: Returns a const reference to the history member variable
+     */
+    const MarketHistory& getHistory() const { return history; }
+    
+    /**
+     * Write the market state to a save
+     * What it does: Writes the demand per category, the current day's trade counters and the history
+     * Inputs:
+     *   - out: Binary output stream
+     * Outputs: None (writes to out)
+     */
+    void serialize(std::ostream& out) const;
+    
+    /**
+     * Read the market state from a save
+     * What it does: Restores what serialize() wrote
+     * Inputs:
+     *   - in: Binary input stream
+     * Outputs: Returns true if the state was read completely, false otherwise
+     */
+    bool deserialize(std::istream& in);
+    
+    /**
+     * Get black market stock
+     * What it does: Returns a const reference to the vector of items available in the black market
+     * Inputs: None
+     * Outputs: Returns a const reference to the blackMarketStock vector
+     */
+    const std::vector<BlackMarketItem>& getBlackMarketStock() const { return blackMarketStock; }
+    
+    /**
+     * Display black market menu
+     * What it does: Prints a formatted menu showing all available black market items with their prices
+     *               and descriptions to the console
+     * Inputs: None
+     * Outputs: None (prints to standard output)
+     */
+    void displayBlackMarket() const;
+    
+    /**
+     * Refresh the black market for a new night
+     * What it does: One batched pass over the catalog that restocks every item and sets its price to
+     *               base price x current demand of its category. Call after updateTrends().
+     * Inputs: None
+     * Outputs: None (modifies price and stock of every black market item)
+     */
+    void refreshBlackMarket();
+    
+    /**
+     * Take an item from the black market stock
+     * What it does: Checks the budget and stock of the item and, if both allow, removes one unit
+     *               from stock. No item is created and nothing is printed, so simulated buyers can
+     *               use it directly. O(1) through the ID index.
+     * Inputs:
+     *   - itemId: Prototype ID of the item
+     *   - budget: Money the buyer can spend
+     *   - paid: Set to the price of the unit on success
+     * Outputs: Returns true if a unit was taken, false if the item is not sold, sold out or too expensive
+     */
+    bool takeFromBlackMarket(int itemId, int budget, int& paid);
+    
+    /**
+     * Purchase item from black market
+     * What it does: Attempts to purchase an item from the black market for the player.
+     *               Checks stock and funds, creates the item from its prototype,
+     *               deducts money from player, and adds item to player inventory.
+     * Inputs:
+     *   - player: Reference to Player object making the purchase
+     *   - itemId: Prototype ID of the item to purchase (must be in the black market catalog)
+     * Outputs: Returns true if purchase was successful, false if item not found, sold out,
+     *          insufficient funds, or item creation failed
+     */
+    bool purchaseFromBlackMarket(Player& player, int itemId);
+    
+    /**
+     * Get black market item by ID
+     * What it does: Looks the prototype ID up in the catalog index
+     * Inputs:
+     *   - itemId: Prototype ID of the item
+     * Outputs: Returns a pointer to the BlackMarketItem if sold, nullptr otherwise
+     */
+    const BlackMarketItem* getBlackMarketItem(int itemId) const;
+};
+
+#endif // MARKET_H
+
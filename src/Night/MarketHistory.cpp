@@ -0,0 +1,215 @@
+#include "MarketHistory.h"
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <limits>
+
+/**
+ * MarketHistory constructor
+ * What it does: Starts with no chunks and no rows
+ * Inputs: None
+ * Outputs: None (constructor)
+ */
+MarketHistory::MarketHistory() : rows(0) {
+}
+
+/**
+ * Clear the history
+ * What it does: Removes every chunk
+ * Inputs: None
+ * Outputs: None (modifies chunks and rows)
+ */
+void MarketHistory::clear() {
+    chunks.clear();
+    rows = 0;
+}
+
+/**
+ * Fold one value into a stats accumulator
+ * What it does: Updates min, max, sum and count
+ * Inputs:
+ *   - stats: Accumulator to update
+ *   - value: Value to add
+ * Outputs: None (modifies stats)
+ */
+void MarketHistory::accumulate(HistoryStats& stats, float value) {
+    stats.minimum = std::min(stats.minimum, value);
+    stats.maximum = std::max(stats.maximum, value);
+    stats.sum += value;
+    stats.count++;
+}
+
+/**
+ * Append a day
+ * What it does: Starts a new chunk when the last one is full, clones the last chunk if another
+ *               copy of the history shares it, writes the row into each column and folds the
+ *               values into the chunk's summaries
+ * Inputs:
+ *   - day: Day number of the row
+ *   - values: HISTORY_COLUMN_COUNT values in column order
+ * Outputs: None (modifies chunks and rows)
+ */
+void MarketHistory::append(int day, const float* values) {
+    if (chunks.empty() || chunks.back()->count == HISTORY_CHUNK_DAYS) {
+        chunks.push_back(std::make_shared<Chunk>());
+        Chunk& fresh = *chunks.back();
+        fresh.count = 0;
+        for (int c = 0; c < HISTORY_COLUMN_COUNT; c++) {
+            fresh.minimum[c] = std::numeric_limits<float>::max();
+            fresh.maximum[c] = std::numeric_limits<float>::lowest();
+            fresh.sum[c] = 0.0;
+        }
+    } else if (chunks.back().use_count() > 1) {
+        chunks.back() = std::make_shared<Chunk>(*chunks.back());
+    }
+
+    Chunk& chunk = *chunks.back();
+    int slot = chunk.count++;
+    chunk.day[slot] = day;
+    for (int c = 0; c < HISTORY_COLUMN_COUNT; c++) {
+        float value = values[c];
+        chunk.values[c][slot] = value;
+        chunk.minimum[c] = std::min(chunk.minimum[c], value);
+        chunk.maximum[c] = std::max(chunk.maximum[c], value);
+        chunk.sum[c] += value;
+    }
+    rows++;
+}
+
+/**
+ * Get the day of a row
+ * What it does: Splits the row index into chunk and slot
+ * Inputs:
+ *   - row: Row index, 0 is the oldest day
+ * Outputs: Returns the day number
+ */
+int MarketHistory::dayAt(int row) const {
+    return chunks[row / HISTORY_CHUNK_DAYS]->day[row % HISTORY_CHUNK_DAYS];
+}
+
+/**
+ * Get one value
+ * What it does: Splits the row index into chunk and slot and reads the column
+ * Inputs:
+ *   - row: Row index, 0 is the oldest day
+ *   - column: Column index
+ * Outputs: Returns the stored value
+ */
+float MarketHistory::valueAt(int row, int column) const {
+    return chunks[row / HISTORY_CHUNK_DAYS]->values[column][row % HISTORY_CHUNK_DAYS];
+}
+
+/**
+ * Aggregate a column over a range of rows
+ * What it does: Walks the chunks touched by the range. A chunk entirely inside the range contributes
+ *               its summary; the first and last chunks are scanned slot by slot.
+ * Inputs:
+ *   - column: Column index
+ *   - firstRow: First row of the range, clamped to the history
+ *   - lastRow: Last row of the range, clamped to the history
+ * Outputs: Returns the aggregate; count is 0 for an empty range
+ */
+HistoryStats MarketHistory::aggregate(int column, int firstRow, int lastRow) const {
+    HistoryStats stats;
+    stats.minimum = std::numeric_limits<float>::max();
+    stats.maximum = std::numeric_limits<float>::lowest();
+    stats.sum = 0.0;
+    stats.count = 0;
+
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, rows - 1);
+    if (column < 0 || column >= HISTORY_COLUMN_COUNT || firstRow > lastRow) {
+        return stats;
+    }
+
+    int firstChunk = firstRow / HISTORY_CHUNK_DAYS;
+    int lastChunk = lastRow / HISTORY_CHUNK_DAYS;
+    for (int k = firstChunk; k <= lastChunk; k++) {
+        const Chunk& chunk = *chunks[k];
+        int begin = (k == firstChunk) ? firstRow % HISTORY_CHUNK_DAYS : 0;
+        int end = (k == lastChunk) ? lastRow % HISTORY_CHUNK_DAYS : chunk.count - 1;
+
+        if (begin == 0 && end == chunk.count - 1) {
+            stats.minimum = std::min(stats.minimum, chunk.minimum[column]);
+            stats.maximum = std::max(stats.maximum, chunk.maximum[column]);
+            stats.sum += chunk.sum[column];
+            stats.count += chunk.count;
+            continue;
+        }
+        const float* values = chunk.values[column];
+        for (int s = begin; s <= end; s++) {
+            accumulate(stats, values[s]);
+        }
+    }
+    return stats;
+}
+
+/**
+ * Get the moving average of a column
+ * What it does: Aggregates the last "window" rows and returns their mean
+ * Inputs:
+ *   - column: Column index
+ *   - window: Number of most recent days to average
+ * Outputs: Returns the average, 0 if there are no rows
+ */
+float MarketHistory::movingAverage(int column, int window) const {
+    return aggregate(column, rows - window, rows - 1).mean();
+}
+
+/**
+ * Write the history to a stream
+ * What it does: Writes the row count, the day column, then each value column. Each column is written
+ *               chunk by chunk, so the values of one column end up contiguous in the file.
+ * Inputs:
+ *   - out: Binary output stream
+ * Outputs: None (writes to out)
+ */
+void MarketHistory::write(std::ostream& out) const {
+    int32_t count = rows;
+    out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& chunk : chunks) {
+        out.write(reinterpret_cast<const char*>(chunk->day), sizeof(int32_t) * chunk->count);
+    }
+    for (int c = 0; c < HISTORY_COLUMN_COUNT; c++) {
+        for (const auto& chunk : chunks) {
+            out.write(reinterpret_cast<const char*>(chunk->values[c]), sizeof(float) * chunk->count);
+        }
+    }
+}
+
+/**
+ * Read the history from a stream
+ * What it does: Reads the columns written by write() and appends the rows again, which rebuilds
+ *               the chunk summaries
+ * Inputs:
+ *   - in: Binary input stream
+ * Outputs: Returns true if the history was read completely, false otherwise (the history is then empty)
+ */
+bool MarketHistory::read(std::istream& in) {
+    clear();
+    int32_t count = 0;
+    in.read(reinterpret_cast<char*>(&count), sizeof(count));
+    // A save covers at most a few thousand nights; anything bigger is a corrupt file
+    if (!in.good() || count < 0 || count > 100000) {
+        return false;
+    }
+
+    std::vector<int32_t> days(count);
+    std::vector<float> columns(static_cast<size_t>(count) * HISTORY_COLUMN_COUNT);
+    if (count > 0) {
+        in.read(reinterpret_cast<char*>(days.data()), sizeof(int32_t) * count);
+        in.read(reinterpret_cast<char*>(columns.data()), sizeof(float) * columns.size());
+    }
+    if (in.fail()) {
+        return false;
+    }
+
+    float row[HISTORY_COLUMN_COUNT];
+    for (int r = 0; r < count; r++) {
+        for (int c = 0; c < HISTORY_COLUMN_COUNT; c++) {
+            row[c] = columns[static_cast<size_t>(c) * count + r];
+        }
+        append(days[r], row);
+    }
+    return true;
+}
@@ -0,0 +1,166 @@
+#ifndef MARKETHISTORY_H
+#define MARKETHISTORY_H
+
+#include <vector>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include "../Item/item.h"  // For CATEGORY_COUNT
+
+// Columns recorded for every day: one demand column per item category,
+// then the number of items traded and the money they were traded for
+const int HISTORY_VOLUME = CATEGORY_COUNT;
+const int HISTORY_VALUE = CATEGORY_COUNT + 1;
+const int HISTORY_COLUMN_COUNT = CATEGORY_COUNT + 2;
+
+// Days stored per chunk
+const int HISTORY_CHUNK_DAYS = 64;
+
+/**
+ * Aggregate of one column over a range of days
+ */
+struct HistoryStats {
+    float minimum;   // Smallest value in the range
+    float maximum;   // Largest value in the range
+    double sum;      // Sum of the values
+    int count;       // Number of days in the range
+
+    /**
+     * Get the mean of the range
+     * What it does: Divides the sum by the number of days
+     * Inputs: None
+     * Outputs: Returns the mean, 0 for an empty range
+     */
+    float mean() const { return count > 0 ? static_cast<float>(sum / count) : 0.0f; }
+};
+
+/**
+ * MarketHistory class storing one row per night as fixed-width columns
+ * Rows are grouped in chunks of HISTORY_CHUNK_DAYS. Each chunk keeps its columns contiguous
+ * plus a running min/max/sum per column, so appending is O(1) and a range aggregate only
+ * scans the partial chunks at both ends of the range.
+ * Chunks are shared between copies of a history: copying copies one pointer per chunk, and a
+ * copy that appends clones only the partial chunk it writes to (copy-on-write). Copies that share
+ * chunks must not be appended to from different threads at the same time.
+ */
+class MarketHistory {
+private:
+    struct Chunk {
+        int32_t day[HISTORY_CHUNK_DAYS];                            // Day of each row
+        float values[HISTORY_COLUMN_COUNT][HISTORY_CHUNK_DAYS];     // Column-major values
+        float minimum[HISTORY_COLUMN_COUNT];                        // Per-column summary
+        float maximum[HISTORY_COLUMN_COUNT];
+        double sum[HISTORY_COLUMN_COUNT];
+        int count;                                                  // Rows used
+    };
+
+    std::vector<std::shared_ptr<Chunk> > chunks;   // Full chunks followed by at most one partial chunk
+    int rows;                    // Total number of rows
+
+    /**
+     * Fold one value into a stats accumulator
+     * What it does: Updates min, max, sum and count with value
+     * Inputs:
+     *   - stats: Accumulator to update
+     *   - value: Value to add
+     * Outputs: None (modifies stats)
+     */
+    static void accumulate(HistoryStats& stats, float value);
+
+public:
+    /**
+     * Constructor for MarketHistory
+     * What it does: Creates an empty history
+     * Inputs: None
+     * Outputs: None (constructor)
+     */
+    MarketHistory();
+
+    /**
+     * Remove every row
+     * What it does: Empties the history
+     * Inputs: None
+     * Outputs: None (modifies chunks and rows)
+     */
+    void clear();
+
+    /**
+     * Append a day
+     * What it does: Adds one row at the end of the history and updates the chunk summaries
+     * Inputs:
+     *   - day: Day number of the row
+     *   - values: HISTORY_COLUMN_COUNT values in column order
+     * Outputs: None (modifies chunks and rows)
+     */
+    void append(int day, const float* values);
+
+    /**
+     * Get the number of rows
+     * What it does: Returns how many days are recorded
+     * Inputs: None
+     * Outputs: Returns the row count
+     */
+    int size() const { return rows; }
+
+    /**
+     * Get the day of a row
+     * What it does: Returns the day number stored in row
+     * Inputs:
+     *   - row: Row index, 0 is the oldest day
+     * Outputs: Returns the day number
+     */
+    int dayAt(int row) const;
+
+    /**
+     * Get one value
+     * What it does: Returns the value of column in row
+     * Inputs:
+     *   - row: Row index, 0 is the oldest day
+     *   - column: Column index (a category, HISTORY_VOLUME or HISTORY_VALUE)
+     * Outputs: Returns the stored value
+     */
+    float valueAt(int row, int column) const;
+
+    /**
+     * Aggregate a column over a range of rows
+     * What it does: Computes min, max, sum and count of column over rows [firstRow, lastRow].
+     *               Whole chunks inside the range use their summaries; only the ends are scanned.
+     * Inputs:
+     *   - column: Column index
+     *   - firstRow: First row of the range, clamped to the history
+     *   - lastRow: Last row of the range, clamped to the history
+     * Outputs: Returns the aggregate; count is 0 for an empty range
+     */
+    HistoryStats aggregate(int column, int firstRow, int lastRow) const;
+
+    /**
+     * Get the moving average of a column
+     * What it does: Averages column over the last "window" rows
+     * Inputs:
+     *   - column: Column index
+     *   - window: Number of most recent days to average
+     * Outputs: Returns the average, 0 if there are no rows
+     */
+    float movingAverage(int column, int window) const;
+
+    /**
+     * Write the history to a stream
+     * What it does: Writes the row count, the day column and then every value column as
+     *               contiguous fixed-width arrays
+     * Inputs:
+     *   - out: Binary output stream
+     * Outputs: None (writes to out)
+     */
+    void write(std::ostream& out) const;
+
+    /**
+     * Read the history from a stream
+     * What it does: Replaces the history with the rows written by write()
+     * Inputs:
+     *   - in: Binary input stream
+     * Outputs: Returns true if the history was read completely, false otherwise
+     */
+    bool read(std::istream& in);
+};
+
+#endif // MARKETHISTORY_H
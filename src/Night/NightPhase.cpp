@@ -1,421 +1,780 @@
-#include "NightPhase.h"
-#include "Customer.h"
-#include "Market.h"
-#include "../Core/Config.h"
-#include "../Item/item.h"
-#include "../Item/itemdatabase.h"
-#include "../Player/Player.h"
-#include "../Save/SaveSystem.h"
-#include <iostream>
-#include <algorithm>
-#include <cstdlib>
-#include <ctime>
-#include <iomanip>
-#include <limits>
-
-/**
- * Constructor for NightPhase
- * What it does: Initializes a NightPhase object with pointers to Player and Market objects
- * Inputs:
- *   - player: Pointer to Player object
- *   - market: Pointer to Market object
- * Outputs: None (constructor initializes m_player and m_market member variables)
- */
-NightPhase::NightPhase(Player* player, Market* market) 
-    : m_player(player), m_market(market) {
-}
-
-/**
- * Default constructor for NightPhase
- * What it does: Creates a NightPhase object with null pointers for player and market.
- *               Used when calling static methods without an instance.
- * Inputs: None
- * Outputs: None (constructor initializes m_player and m_market to nullptr)
- */
-NightPhase::NightPhase() 
-    : m_player(nullptr), m_market(nullptr) {
-}
-
-/**
- * Execute the night phase (static method)
- * What it does: Main entry point for the night phase. If market pointer is null, creates a temporary
- *               static Market object. Then creates a NightPhase instance and calls executeNightPhase()
- *               to run the night phase game loop.
- * Inputs:
- *   - player: Reference to Player object
- *   - market: Pointer to Market object (can be nullptr, will use temporary Market if needed)
- *   - day: Current day number
- * Outputs: None (delegates to executeNightPhase() which handles all night phase logic)
- */
-void NightPhase::executeNight(Player& player, Market* market, int day) {
-    if (!market) {
-        // If market is nullptr, create a temporary one
-        // In actual game, market should be properly initialized
-        static Market tempMarket;
-        market = &tempMarket;
-    }
-    
-    NightPhase nightPhase(&player, market);
-    nightPhase.executeNightPhase(day);
-}
-
-/**
- * Execute the night phase (instance method)
- * What it does: Runs the main night phase game loop. Validates player and market pointers, generates
- *               customers for the night, displays welcome message, then enters a loop that displays menu,
- *               processes player input, handles menu choices (view customers, trade, black market, inventory,
- *               end night, save & exit), validates input, and manages night phase state. Continues until
- *               player ends night or triggers game over.
- * Inputs:
- *   - day: Current day number (displayed in welcome message and passed to processEndOfNight())
- * Outputs: None (modifies player state through trades and purchases, may exit program on save & exit,
- *          may trigger game over if insufficient funds)
- */
-void NightPhase::executeNightPhase(int day) {
-    if (!m_player || !m_market) {
-        std::cout << "Error: Player or Market not initialized" << std::endl;
-        return;
-    }
-    
-    std::cout << "\n=== Night Phase - Day " << day << " ===" << std::endl;
-    std::cout << "Welcome back to your safe house!" << std::endl;
-    
-    // Generate customers
-    MarketTrends& trends = m_market->getTrends();
-    std::vector<Customer> customers = generateCustomers(trends);
-    
-    bool nightPhaseActive = true;
-    int invalidInputCount = 0;
-    const int MAX_INVALID_INPUTS = 5;
-
-    while (nightPhaseActive) {
-        displayMenu();
-
-        int choice;
-        std::cout << "\nPlease choose: ";
-
-        // Input validation
-        if (!(std::cin >> choice)) {
-            std::cin.clear(); // Clear error state
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // Ignore bad input
-            std::cout << "Invalid input! Please enter a number." << std::endl;
-            invalidInputCount++;
-
-            if (invalidInputCount >= MAX_INVALID_INPUTS) {
-                std::cout << "Too many invalid inputs. Ending night phase." << std::endl;
-                break;
-            }
-            continue;
-        }
-
-        switch (choice) {
-            case 1:
-                // View customers
-                displayCustomers(customers);
-                invalidInputCount = 0; // Reset invalid input count
-                break;
-
-            case 2:
-                // Trade with customer
-                if (customers.empty()) {
-                    std::cout << "No customers" << std::endl;
-                } else {
-                    std::cout << "\nSelect customer to trade with:" << std::endl;
-                    for (size_t i = 0; i < customers.size(); i++) {
-                        std::cout << "[" << (i + 1) << "] " << customers[i].name << std::endl;
-                    }
-                    std::cout << "[0] Return" << std::endl;
-
-                    int customerChoice;
-                    std::cout << "Choice: ";
-
-                    if (!(std::cin >> customerChoice)) {
-                        std::cin.clear();
-                        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-                        std::cout << "Invalid input!" << std::endl;
-                    } else if (customerChoice > 0 && customerChoice <= static_cast<int>(customers.size())) {
-                        handleCustomerTrade(customers[customerChoice - 1]);
-                    }
-                }
-                invalidInputCount = 0;
-                break;
-
-            case 3:
-                // Black market
-                handleBlackMarket();
-                invalidInputCount = 0;
-                break;
-
-            case 4:
-                // View inventory
-                m_player->displayInventory();
-                invalidInputCount = 0;
-                break;
-
-            case 5:
-                // End night phase
-                if (processEndOfNight(day)) {
-                    nightPhaseActive = false;
-                } else {
-                    std::cout << "Game Over! Insufficient funds to pay fee" << std::endl;
-                    return;
-                }
-                break;
-
-            case 6:
-                SaveSystem::saveGame(*m_player, day);
-                std::cout << "Game saved. Exiting..." << std::endl;
-                std::exit(0);
-                break;
-
-            default:
-                std::cout << "Invalid choice" << std::endl;
-                invalidInputCount++;
-
-                if (invalidInputCount >= MAX_INVALID_INPUTS) {
-                    std::cout << "Too many invalid inputs. Ending night phase." << std::endl;
-                    nightPhaseActive = false;
-                }
-                break;
-        }
-    }
-}
-
-/**
- * Display customer list and their demands
- * What it does: Prints a formatted list of all customers to the console, showing each customer's
- *               number, name, desired item and quantity, offered total price, and patience level.
- *               If no customers exist, displays "No customers" message.
- * Inputs:
- *   - customers: Vector of Customer objects to display
- * Outputs: None (prints formatted customer information to standard output)
- */
-void NightPhase::displayCustomers(const std::vector<Customer>& customers) const {
-    std::cout << "\n=== Customer List ===" << std::endl;
-    
-    if (customers.empty()) {
-        std::cout << "No customers" << std::endl;
-        return;
-    }
-    
-    for (size_t i = 0; i < customers.size(); i++) {
-        const Customer& c = customers[i];
-        std::cout << "\n[" << (i + 1) << "] " << c.name << std::endl;
-        std::cout << "   Wants to buy: " << c.desired_item 
-                  << " x" << c.desired_quantity << std::endl;
-        std::cout << "   Offers: " << calculateTradePrice(c, c.desired_quantity) 
-                  << " Money" << std::endl;
-        std::cout << "   Patience: " << c.patience << std::endl;
-    }
-}
-
-/**
- * Handle trading with a specific customer
- * What it does: Processes a complete trade transaction with a customer. Displays trade details
- *               (customer name, desired item and quantity), checks if player has sufficient items,
- *               calculates and displays total price, prompts player for confirmation, removes items
- *               from player inventory if confirmed, adds money to player, and displays success message.
- * Inputs:
- *   - customer: Customer object containing name, desired_item, desired_quantity, patience, and base_price
- * Outputs: Returns true if trade was successful (player had items and confirmed trade).
- *          Returns false if player lacks sufficient items or cancelled the trade.
- *          Modifies player inventory (removes items) and player money (adds payment).
- *          Prints trade information and results to console.
- */
-bool NightPhase::handleCustomerTrade(const Customer& customer) {
-    std::cout << "\n=== Trade ===" << std::endl;
-    std::cout << "Customer: " << customer.name << std::endl;
-    std::cout << "Wants to buy: " << customer.desired_item 
-              << " x" << customer.desired_quantity << std::endl;
-    
-    // Check if player has the item
-    if (!playerHasItem(customer.desired_item, customer.desired_quantity)) {
-        std::cout << "You don't have enough items!" << std::endl;
-        return false;
-    }
-    
-    int totalPrice = calculateTradePrice(customer, customer.desired_quantity);
-    std::cout << "Total price: " << totalPrice << " Money" << std::endl;
-    
-    std::cout << "\nAgree to trade? [1] Yes [2] No: ";
-    int choice;
-    std::cin >> choice;
-    
-    if (choice != 1) {
-        std::cout << "Trade cancelled" << std::endl;
-        return false;
-    }
-    
-    // Remove items from player inventory
-    std::string itemName = customer.desired_item;
-    m_player->removeItem(itemName, customer.desired_quantity);
-    
-    // Add money to player
-    m_player->money += totalPrice;
-    
-    std::cout << "Trade successful!" << std::endl;
-    std::cout << "Earned: " << totalPrice << " Money" << std::endl;
-    
-    return true;
-}
-
-/**
- * Calculate final price based on customer patience and base price
- * What it does: Calculates the total transaction price by multiplying customer's base price per item
- *               by the quantity, then applies a patience-based multiplier. Higher patience results
- *               in a better price (patience multiplier = 1.0 + (patience - 1) * 0.1).
- * Inputs:
- *   - customer: Customer object containing base_price and patience values
- *   - quantity: Number of items being sold in the transaction
- * Outputs: Returns an integer representing the final total price for the transaction after applying
- *          patience multiplier
- */
-int NightPhase::calculateTradePrice(const Customer& customer, int quantity) const {
-    // Base price calculation
-    int basePrice = customer.base_price * quantity;
-    
-    // Adjust based on patience (higher patience = better price)
-    float patienceMultiplier = 1.0f + (customer.patience - 1) * 0.1f;
-    
-    return static_cast<int>(basePrice * patienceMultiplier);
-}
-
-/**
- * Check if player has enough items to sell
- * What it does: Verifies whether the player's inventory contains at least the required quantity
- *               of the specified item by calling Player::getItemCount() and comparing with required quantity.
- * Inputs:
- *   - itemName: Name of the item to check for (must match item names in player inventory)
- *   - quantity: Minimum quantity required for the trade
- * Outputs: Returns true if player has at least the required quantity of the item.
- *          Returns false if player has insufficient items or player pointer is null
- */
-bool NightPhase::playerHasItem(const std::string& itemName, int quantity) const {
-    if (!m_player) return false;
-    // Check if player has enough items
-    std::string name = itemName;
-    int count = m_player->getItemCount(name);
-    return count >= quantity;
-}
-
-/**
- * Display night phase menu
- * What it does: Prints the main menu options for the night phase to the console, including:
- *               [1] View Customers, [2] Trade with Customer, [3] Black Market, [4] View Inventory,
- *               [5] End Night, [6] Save & Exit
- * Inputs: None
- * Outputs: None (prints formatted menu to standard output)
- */
-void NightPhase::displayMenu() const {
-    std::cout << "\n=== Night Menu ===" << std::endl;
-    std::cout << "[1] View Customers" << std::endl;
-    std::cout << "[2] Trade with Customer" << std::endl;
-    std::cout << "[3] Black Market" << std::endl;
-    std::cout << "[4] View Inventory" << std::endl;
-    std::cout << "[5] End Night" << std::endl;
-    std::cout << "[6] Save & Exit" << std::endl;
-}
-
-/**
- * Handle black market access
- * What it does: Manages the black market interaction loop. Displays black market menu with available
- *               items, processes player input for item selection, prompts for purchase confirmation,
- *               and calls Market::purchaseFromBlackMarket() to complete transactions. Continues looping
- *               until player selects option [0] to return to the main night menu.
- * Inputs: None
- * Outputs: None (modifies player inventory and money through Market::purchaseFromBlackMarket() calls.
- *          Prints black market menu and transaction results to console)
- */
-void NightPhase::handleBlackMarket() {
-    if (!m_market) {
-        std::cout << "Error: Market not initialized" << std::endl;
-        return;
-    }
-    
-    bool inBlackMarket = true;
-    
-    while (inBlackMarket) {
-        m_market->displayBlackMarket();
-        
-        int choice;
-        std::cout << "\nChoice: ";
-        std::cin >> choice;
-        
-        if (choice == 0) {
-            inBlackMarket = false;
-            continue;
-        }
-        
-        const std::vector<BlackMarketItem>& stock = m_market->getBlackMarketStock();
-        if (choice > 0 && choice <= static_cast<int>(stock.size())) {
-            const BlackMarketItem& item = stock[choice - 1];
-            
-            std::cout << "\nBuy " << item.display_name << "?" << std::endl;
-            std::cout << "Price: " << item.price << " Money" << std::endl;
-            std::cout << "[1] Yes [2] No: ";
-            
-            int confirm;
-            std::cin >> confirm;
-            
-            if (confirm == 1) {
-                if (m_player) {
-                    m_market->purchaseFromBlackMarket(*m_player, item.item_name);
-                }
-            }
-        } else {
-            std::cout << "Invalid choice" << std::endl;
-        }
-    }
-}
-
-/**
- * Process end of night phase
- * What it does: Handles all end-of-night operations. Updates market trends (increases demand values
- *               by growth rate), displays updated demand values to console, charges the daily fee from
- *               player's money, checks if player has sufficient funds to continue, and implements
- *               game over condition if funds are insufficient. This is called when player selects
- *               "End Night" option.
- * Inputs:
- *   - day: Current day number (used for display purposes, though not currently shown in output)
- * Outputs: Returns true if player can continue to next day (sufficient funds for daily fee).
- *          Returns false if game over (insufficient funds to pay daily fee).
- *          Modifies market trends (calls Market::updateTrends()) and player money (deducts DAILY_FEE).
- *          Prints end-of-night information to console.
- */
-bool NightPhase::processEndOfNight(int day) {
-    if (!m_market) {
-        return false;
-    }
-    
-    std::cout << "\n=== End of Night ===" << std::endl;
-    
-    // Update market trends
-    m_market->updateTrends();
-    MarketTrends& trends = m_market->getTrends();
-    
-    std::cout << "Market demand updated:" << std::endl;
-    std::cout << "  Food demand: " << std::fixed << std::setprecision(2) 
-              << trends.food_demand << std::endl;
-    std::cout << "  Medicine demand: " << trends.medicine_demand << std::endl;
-    std::cout << "  Metal demand: " << trends.metal_demand << std::endl;
-    
-    // Charge daily fee
-    #ifndef DAILY_FEE
-    #define DAILY_FEE 10  // Default daily fee if not defined in Config.h
-    #endif
-    std::cout << "\nDaily fee required: " << DAILY_FEE << " Money" << std::endl;
-    
-    // Check if player has enough money
-    int playerMoney = m_player->money;
-    if (playerMoney < DAILY_FEE) {
-        return false;  // Game over
-    }
-    
-    // Deduct fee
-    m_player->money -= DAILY_FEE;
-    std::cout << "Fee paid. Remaining money: " << m_player->money << std::endl;
-    
-    std::cout << "Preparing for next day..." << std::endl;
-    return true;
-}
-
+#include "NightPhase.h"
+#include "Customer.h"
+#include "Market.h"
+#include "TradePlanner.h"
+#include "../Core/Config.h"
+#include "../Item/item.h"
+#include "../Item/itemdatabase.h"
+#include "../Player/Player.h"
+#include "../Save/SaveSystem.h"
+#include "../Core/UISystem.h"
+#include "../Core/GameSession.h"
+#include <iostream>
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+
+/**
+ * Constructor for NightPhase
+ * What it does: Initializes a NightPhase object with pointers to Player and Market objects
+ * Inputs:
+ *   - player: Pointer to Player object
+ *   - market: Pointer to Market object
+ * Outputs: None (constructor initializes m_player and m_market member variables)
+ */
+NightPhase::NightPhase(Player* player, Market* market) 
+    : m_player(player), m_market(market), m_exchangeOpen(false) {
+}
+
+/**
+ * Default constructor for NightPhase
+ * What it does: Creates a NightPhase object with null pointers for player and market.
+ *               Used when calling static methods without an instance.
+ * Inputs: None
+ * Outputs: None (constructor initializes m_player and m_market to nullptr)
+ */
+NightPhase::NightPhase() 
+    : m_player(nullptr), m_market(nullptr), m_exchangeOpen(false) {
+}
+
+/**
+ * Execute the night phase (static method)
+ * What it does: Main entry point for the night phase. If market pointer is null, uses the night
+ *               market of the current game session. Then creates a NightPhase instance and calls executeNightPhase()
+ *               to run the night phase game loop.
+ * Inputs:
+ *   - player: Reference to Player object
+ *   - market: Pointer to Market object (can be nullptr, will use the game session's night market)
+ *   - day: Current day number
+ * Outputs: Returns false if the player saved and quit, true when the night is over
+ */
+bool NightPhase::executeNight(Player& player, Market* market, int day) {
+    if (!market) {
+        // If market is nullptr, use the game session's spare one
+        // In actual game, market should be properly initialized
+        market = &GameSession::current().getNightMarket();
+    }
+    
+    NightPhase nightPhase(&player, market);
+    return nightPhase.executeNightPhase(day);
+}
+
+/**
+ * Execute the night phase (instance method)
+ * What it does: Runs the main night phase game loop. Validates player and market pointers, generates
+ *               customers for the night, displays welcome message, then enters a loop that displays menu,
+ *               processes player input, handles menu choices (view customers, trade, black market, inventory,
+ *               end night, save & exit), validates input, and manages night phase state. Continues until
+ *               player ends night or triggers game over.
+ * Inputs:
+ *   - day: Current day number (displayed in welcome message and passed to processEndOfNight())
+ * Outputs: Returns false if the player chose save & exit, true otherwise (modifies player state
+ *          through trades and purchases, may trigger game over if insufficient funds)
+ */
+bool NightPhase::executeNightPhase(int day) {
+    if (!m_player || !m_market) {
+        UISystem::out() << "Error: Player or Market not initialized" << std::endl;
+        return true;
+    }
+    
+    UISystem::out() << "\n=== Night Phase - Day " << day << " ===" << std::endl;
+    UISystem::out() << "Welcome back to your safe house!" << std::endl;
+    
+    // Generate customers
+    MarketTrends& trends = m_market->getTrends();
+    std::vector<Customer> customers = generateCustomers(trends, m_market->getCustomerRng());
+    m_bazaar.clear();
+    m_exchangeOpen = false;
+    
+    bool nightPhaseActive = true;
+    int invalidInputCount = 0;
+    const int MAX_INVALID_INPUTS = 5;
+
+    while (nightPhaseActive) {
+        displayMenu();
+
+        int choice;
+        UISystem::out() << "\nPlease choose: ";
+
+        // Input validation
+        if (!InputSystem::readNumber(choice)) {
+            UISystem::out() << "Invalid input! Please enter a number." << std::endl;
+            invalidInputCount++;
+
+            if (invalidInputCount >= MAX_INVALID_INPUTS) {
+                UISystem::out() << "Too many invalid inputs. Ending night phase." << std::endl;
+                break;
+            }
+            continue;
+        }
+
+        switch (choice) {
+            case 1:
+                // View customers
+                displayCustomers(customers);
+                invalidInputCount = 0; // Reset invalid input count
+                break;
+
+            case 2:
+                // Trade with customer
+                if (customers.empty()) {
+                    UISystem::out() << "No customers" << std::endl;
+                } else {
+                    UISystem::out() << "\nSelect customer to trade with:" << std::endl;
+                    for (size_t i = 0; i < customers.size(); i++) {
+                        UISystem::out() << "[" << (i + 1) << "] " << customers[i].name << std::endl;
+                    }
+                    UISystem::out() << "[0] Return" << std::endl;
+
+                    int customerChoice;
+                    UISystem::out() << "Choice: ";
+
+                    if (!InputSystem::readNumber(customerChoice)) {
+                        UISystem::out() << "Invalid input!" << std::endl;
+                    } else if (customerChoice > 0 && customerChoice <= static_cast<int>(customers.size())) {
+                        handleCustomerTrade(customers[customerChoice - 1]);
+                    }
+                }
+                invalidInputCount = 0;
+                break;
+
+            case 3:
+                // Black market
+                handleBlackMarket();
+                invalidInputCount = 0;
+                break;
+
+            case 4:
+                // View inventory
+                m_player->displayInventory();
+                invalidInputCount = 0;
+                break;
+
+            case 5:
+                // End night phase
+                if (processEndOfNight(day)) {
+                    nightPhaseActive = false;
+                } else {
+                    UISystem::out() << "Game Over! Insufficient funds to pay fee" << std::endl;
+                    return true;
+                }
+                break;
+
+            case 6:
+                if (SaveSystem::saveGame(*m_player, day, m_market).get()) {
+                    UISystem::out() << "Game saved. Exiting..." << std::endl;
+                } else {
+                    UISystem::out() << "Error: game could not be saved. Exiting..." << std::endl;
+                }
+                return false;
+
+            case 7:
+                // Bazaar
+                handleBazaar();
+                invalidInputCount = 0;
+                break;
+
+            case 8:
+                // Trading floor
+                handleTradingFloor();
+                invalidInputCount = 0;
+                break;
+
+            case 9:
+                // Market history
+                displayMarketHistory();
+                invalidInputCount = 0;
+                break;
+
+            case 10:
+                // Suggested trades
+                displayTradePlan(customers);
+                invalidInputCount = 0;
+                break;
+
+            case 11:
+                // Save to slot
+                saveToSlot(day);
+                invalidInputCount = 0;
+                break;
+
+            default:
+                UISystem::out() << "Invalid choice" << std::endl;
+                invalidInputCount++;
+
+                if (invalidInputCount >= MAX_INVALID_INPUTS) {
+                    UISystem::out() << "Too many invalid inputs. Ending night phase." << std::endl;
+                    nightPhaseActive = false;
+                }
+                break;
+        }
+
+        // Autosave trades and purchases; nothing is written if nothing changed
+        SaveSystem::journalGame(*m_player, day, m_market);
+    }
+    return true;
+}
+
+/**
+ * Display customer list and their demands
+ * What it does: Prints a formatted list of all customers to the console, showing each customer's
+ *               number, name, desired item and quantity, offered total price, and patience level.
+ *               If no customers exist, displays "No customers" message.
+ * Inputs:
+ *   - customers: Vector of Customer objects to display
+ * Outputs: None (prints formatted customer information to standard output)
+ */
+void NightPhase::displayCustomers(const std::vector<Customer>& customers) const {
+    UISystem::out() << "\n=== Customer List ===" << std::endl;
+    
+    if (customers.empty()) {
+        UISystem::out() << "No customers" << std::endl;
+        return;
+    }
+    
+    for (size_t i = 0; i < customers.size(); i++) {
+        const Customer& c = customers[i];
+        UISystem::out() << "\n[" << (i + 1) << "] " << c.name << std::endl;
+        UISystem::out() << "   Wants to buy: " << c.desired_item 
+                  << " x" << c.desired_quantity << std::endl;
+        UISystem::out() << "   Offers: " << calculateTradePrice(c.base_price, c.patience, c.desired_quantity) 
+                  << " Money" << std::endl;
+        UISystem::out() << "   Patience: " << c.patience << std::endl;
+    }
+}
+
+/**
+ * Handle trading with a specific customer
+ * What it does: Processes a complete trade transaction with a customer. Displays trade details
+ *               (customer name, desired item and quantity), checks if player has sufficient items,
+ *               calculates and displays total price, prompts player for confirmation, removes items
+ *               from player inventory if confirmed, adds money to player, and displays success message.
+ * Inputs:
+ *   - customer: Customer object containing name, desired_item, desired_quantity, patience, and base_price
+ * Outputs: Returns true if trade was successful (player had items and confirmed trade).
+ *          Returns false if player lacks sufficient items or cancelled the trade.
+ *          Modifies player inventory (removes items) and player money (adds payment).
+ *          Prints trade information and results to console.
+ */
+bool NightPhase::handleCustomerTrade(const Customer& customer) {
+    UISystem::out() << "\n=== Trade ===" << std::endl;
+    UISystem::out() << "Customer: " << customer.name << std::endl;
+    UISystem::out() << "Wants to buy: " << customer.desired_item 
+              << " x" << customer.desired_quantity << std::endl;
+    
+    // Check if player has the item
+    if (!playerHasItem(customer.desired_item, customer.desired_quantity)) {
+        UISystem::out() << "You don't have enough items!" << std::endl;
+        return false;
+    }
+    
+    int totalPrice = calculateTradePrice(customer.base_price, customer.patience, customer.desired_quantity);
+    UISystem::out() << "Total price: " << totalPrice << " Money" << std::endl;
+    
+    UISystem::out() << "\nAgree to trade? [1] Yes [2] No: ";
+    int choice = 0;
+    InputSystem::readNumber(choice);
+    
+    if (choice != 1) {
+        UISystem::out() << "Trade cancelled" << std::endl;
+        return false;
+    }
+    
+    // Remove items from player inventory
+    std::string itemName = customer.desired_item;
+    m_player->removeItem(itemName, customer.desired_quantity);
+    
+    // Add money to player
+    m_player->money += totalPrice;
+    if (m_market) {
+        m_market->recordTrade(customer.desired_quantity, totalPrice);
+    }
+    
+    UISystem::out() << "Trade successful!" << std::endl;
+    UISystem::out() << "Earned: " << totalPrice << " Money" << std::endl;
+    
+    return true;
+}
+
+/**
+ * Check if player has enough items to sell
+ * What it does: Verifies whether the player's inventory contains at least the required quantity
+ *               of the specified item by calling Player::getItemCount() and comparing with required quantity.
+ * Inputs:
+ *   - itemName: Name of the item to check for (must match item names in player inventory)
+ *   - quantity: Minimum quantity required for the trade
+ * Outputs: Returns true if player has at least the required quantity of the item.
+ *          Returns false if player has insufficient items or player pointer is null
+ */
+bool NightPhase::playerHasItem(const std::string& itemName, int quantity) const {
+    if (!m_player) return false;
+    // Check if player has enough items
+    std::string name = itemName;
+    int count = m_player->getItemCount(name);
+    return count >= quantity;
+}
+
+/**
+ * Display night phase menu
+ * What it does: Prints the main menu options for the night phase to the console, including:
+ *               [1] View Customers, [2] Trade with Customer, [3] Black Market, [4] View Inventory,
+ *               [5] End Night, [6] Save & Exit, [7] Bazaar, [8] Trading Floor, [9] Market History,
+ *               [10] Suggested Trades, [11] Save to Slot
+ * Inputs: None
+ * Outputs: None (prints formatted menu to standard output)
+ */
+void NightPhase::displayMenu() const {
+    UISystem::out() << "\n=== Night Menu ===" << std::endl;
+    UISystem::out() << "[1] View Customers" << std::endl;
+    UISystem::out() << "[2] Trade with Customer" << std::endl;
+    UISystem::out() << "[3] Black Market" << std::endl;
+    UISystem::out() << "[4] View Inventory" << std::endl;
+    UISystem::out() << "[5] End Night" << std::endl;
+    UISystem::out() << "[6] Save & Exit" << std::endl;
+    UISystem::out() << "[7] Bazaar" << std::endl;
+    UISystem::out() << "[8] Trading Floor" << std::endl;
+    UISystem::out() << "[9] Market History" << std::endl;
+    UISystem::out() << "[10] Suggested Trades" << std::endl;
+    UISystem::out() << "[11] Save to Slot" << std::endl;
+}
+
+/**
+ * Handle black market access
+ * What it does: Manages the black market interaction loop. Displays black market menu with available
+ *               items, processes player input for item selection, prompts for purchase confirmation,
+ *               and calls Market::purchaseFromBlackMarket() to complete transactions. Continues looping
+ *               until player selects option [0] to return to the main night menu.
+ * Inputs: None
+ * Outputs: None (modifies player inventory and money through Market::purchaseFromBlackMarket() calls.
+ *          Prints black market menu and transaction results to console)
+ */
+void NightPhase::handleBlackMarket() {
+    if (!m_market) {
+        UISystem::out() << "Error: Market not initialized" << std::endl;
+        return;
+    }
+    
+    bool inBlackMarket = true;
+    
+    while (inBlackMarket) {
+        m_market->displayBlackMarket();
+        
+        int choice = -1;
+        UISystem::out() << "\nChoice: ";
+        InputSystem::readNumber(choice);
+        
+        if (choice == 0) {
+            inBlackMarket = false;
+            continue;
+        }
+        
+        const std::vector<BlackMarketItem>& stock = m_market->getBlackMarketStock();
+        if (choice > 0 && choice <= static_cast<int>(stock.size())) {
+            const BlackMarketItem& item = stock[choice - 1];
+            
+            UISystem::out() << "\nBuy " << item.display_name << "?" << std::endl;
+            UISystem::out() << "Price: " << item.price << " Money" << std::endl;
+            UISystem::out() << "[1] Yes [2] No: ";
+            
+            int confirm = 0;
+            InputSystem::readNumber(confirm);
+            
+            if (confirm == 1) {
+                if (m_player) {
+                    m_market->purchaseFromBlackMarket(*m_player, item.item_id);
+                }
+            }
+        } else {
+            UISystem::out() << "Invalid choice" << std::endl;
+        }
+    }
+}
+
+/**
+ * Generate the bazaar crowd if needed
+ * What it does: Generates tonight's crowd from the market trends and the session generator the first
+ *               time it is needed; later calls keep the same crowd
+ * Inputs: None
+ * Outputs: None (modifies m_bazaar)
+ */
+void NightPhase::prepareBazaar() {
+    #ifndef BAZAAR_CUSTOMERS
+    #define BAZAAR_CUSTOMERS 2000  // Default crowd size if not defined in Config.h
+    #endif
+    if (m_bazaar.size() == 0) {
+        generateBazaar(m_market->getTrends(), m_market->getCustomerRng(), BAZAAR_CUSTOMERS, m_bazaar);
+    }
+}
+
+/**
+ * Handle the bazaar
+ * What it does: Generates the night's crowd on the first visit, then prints how many customers want
+ *               each item, the total quantity asked and the best price per item. The best offer of every
+ *               item the player owns is listed and can be traded through handleCustomerTrade(); a
+ *               customer who traded leaves the crowd.
+ * Inputs: None
+ * Outputs: None (modifies player inventory and money through handleCustomerTrade(),
+ *          prints the bazaar summary to console)
+ */
+void NightPhase::handleBazaar() {
+    prepareBazaar();
+    
+    // Summary per item atom in one pass over the roster
+    const int itemCount = getDesiredItemCount();
+    std::vector<int> customerCount(itemCount, 0);
+    std::vector<int> totalQuantity(itemCount, 0);
+    std::vector<int> bestCustomer(itemCount, -1);
+    std::vector<float> bestUnitPrice(itemCount, 0.0f);
+    for (int i = 0; i < m_bazaar.size(); i++) {
+        if (m_bazaar.quantity[i] <= 0) {
+            continue;  // Already traded
+        }
+        int atom = m_bazaar.item_atom[i];
+        customerCount[atom]++;
+        totalQuantity[atom] += m_bazaar.quantity[i];
+        float unitPrice = static_cast<float>(m_bazaar.offer[i]) / m_bazaar.quantity[i];
+        if (unitPrice > bestUnitPrice[atom]) {
+            bestUnitPrice[atom] = unitPrice;
+            bestCustomer[atom] = i;
+        }
+    }
+    
+    UISystem::out() << "\n=== Bazaar ===" << std::endl;
+    UISystem::out() << std::left << std::setw(22) << "Item" << std::setw(11) << "Customers"
+              << std::setw(10) << "Wanted" << "Best price" << std::endl;
+    for (int a = 0; a < itemCount; a++) {
+        UISystem::out() << std::setw(22) << getDesiredItemName(a) << std::setw(11) << customerCount[a]
+                  << std::setw(10) << totalQuantity[a] << std::fixed << std::setprecision(1)
+                  << bestUnitPrice[a] << std::endl;
+    }
+    UISystem::out() << std::right;
+    
+    // Best offer for every item the player can sell
+    std::vector<int> offers;
+    for (int a = 0; a < itemCount; a++) {
+        int c = bestCustomer[a];
+        if (c >= 0 && playerHasItem(getDesiredItemName(a), m_bazaar.quantity[c])) {
+            offers.push_back(c);
+        }
+    }
+    if (offers.empty()) {
+        UISystem::out() << "\nNobody in the crowd wants what you carry." << std::endl;
+        return;
+    }
+    
+    UISystem::out() << "\nBest offers for your items:" << std::endl;
+    for (size_t i = 0; i < offers.size(); i++) {
+        int c = offers[i];
+        UISystem::out() << "[" << (i + 1) << "] " << getDesiredItemName(m_bazaar.item_atom[c])
+                  << " x" << m_bazaar.quantity[c] << " for " << m_bazaar.offer[c] << " Money" << std::endl;
+    }
+    UISystem::out() << "[0] Return" << std::endl;
+    UISystem::out() << "Choice: ";
+    
+    int choice;
+    if (!InputSystem::readNumber(choice)) {
+        UISystem::out() << "Invalid input!" << std::endl;
+        return;
+    }
+    if (choice > 0 && choice <= static_cast<int>(offers.size())) {
+        int c = offers[choice - 1];
+        if (handleCustomerTrade(m_bazaar.toCustomer(c))) {
+            m_bazaar.quantity[c] = 0;  // The customer leaves the crowd
+        }
+    }
+}
+
+/**
+ * Apply fills to the bazaar crowd
+ * What it does: For every fill bought by a customer, lowers the quantity they still want and
+ *               recomputes their total offer for the rest
+ * Inputs:
+ *   - fills: Fills returned by the matching engine
+ * Outputs: None (modifies m_bazaar)
+ */
+void NightPhase::applyFillsToBazaar(const std::vector<Fill>& fills) {
+    for (const Fill& fill : fills) {
+        if (fill.buyer < 0 || fill.buyer >= m_bazaar.size()) {
+            continue;
+        }
+        int c = fill.buyer;
+        m_bazaar.quantity[c] = std::max(0, m_bazaar.quantity[c] - fill.quantity);
+        m_bazaar.offer[c] = calculateTradePrice(m_bazaar.base_price[c], m_bazaar.patience[c], m_bazaar.quantity[c]);
+    }
+}
+
+/**
+ * Open the trading floor
+ * What it does: Every bazaar customer posts a bid at their price per item for the quantity they still
+ *               want. Then NPC sellers post 2-5 asks per item at 100-150% of the item's base price;
+ *               asks that cross resting bids trade at once. The books are kept for the rest of the night.
+ * Inputs: None
+ * Outputs: None (modifies m_exchange, m_bazaar and m_exchangeOpen)
+ */
+void NightPhase::openTradingFloor() {
+    prepareBazaar();
+    
+    const int itemCount = getDesiredItemCount();
+    m_exchange.reset(itemCount);
+    std::vector<Fill> fills;
+    
+    for (int i = 0; i < m_bazaar.size(); i++) {
+        if (m_bazaar.quantity[i] <= 0) {
+            continue;
+        }
+        int unitPrice = calculateTradePrice(m_bazaar.base_price[i], m_bazaar.patience[i], 1);
+        m_exchange.postBid(m_bazaar.item_atom[i], i, unitPrice, m_bazaar.quantity[i], fills);
+    }
+    
+    CustomerRng& rng = m_market->getCustomerRng();
+    for (int a = 0; a < itemCount; a++) {
+        int sellers = rng.range(2, 5);
+        for (int s = 0; s < sellers; s++) {
+            int price = static_cast<int>(getDesiredItemBasePrice(a) * (1.0f + 0.5f * rng.unit()));
+            m_exchange.postAsk(a, NPC_SELLER, std::max(price, 1), rng.range(5, 30), fills);
+        }
+    }
+    
+    applyFillsToBazaar(fills);
+    for (const Fill& fill : fills) {
+        m_market->recordTrade(fill.quantity, fill.price * fill.quantity);
+    }
+    m_exchangeOpen = true;
+}
+
+/**
+ * Handle the trading floor
+ * What it does: Opens the floor on the first visit of the night, prints each item's best bid, bid depth
+ *               and best ask, then asks which item to sell, how many and the lowest price per item the
+ *               player accepts. The sell order is matched against the bids with price-time priority,
+ *               partial fills included; each fill is paid at the buyer's price. The unfilled quantity
+ *               is cancelled.
+ * Inputs: None
+ * Outputs: None (modifies player inventory and money, prints the books and fills to console)
+ */
+void NightPhase::handleTradingFloor() {
+    if (!m_exchangeOpen) {
+        openTradingFloor();
+    }
+    
+    const int itemCount = m_exchange.getBookCount();
+    UISystem::out() << "\n=== Trading Floor ===" << std::endl;
+    UISystem::out() << std::left << "    " << std::setw(22) << "Item" << std::setw(10) << "Best bid"
+              << std::setw(10) << "Wanted" << std::setw(10) << "Best ask" << "You own" << std::endl;
+    for (int a = 0; a < itemCount; a++) {
+        const OrderBook& book = m_exchange.getBook(a);
+        const Order* bid = book.bestBid();
+        const Order* ask = book.bestAsk();
+        std::string name = getDesiredItemName(a);
+        UISystem::out() << "[" << (a + 1) << "] " << std::setw(22) << getDesiredItemName(a)
+                  << std::setw(10) << (bid ? std::to_string(bid->price) : "-")
+                  << std::setw(10) << book.bidDepth()
+                  << std::setw(10) << (ask ? std::to_string(ask->price) : "-")
+                  << m_player->getItemCount(name) << std::endl;
+    }
+    UISystem::out() << std::right << "[0] Return" << std::endl;
+    
+    int item, quantity, price;
+    UISystem::out() << "Item to sell: ";
+    if (!InputSystem::readNumber(item) || item <= 0 || item > itemCount) {
+        return;
+    }
+    const int atom = item - 1;
+    std::string itemName = getDesiredItemName(atom);
+    int owned = m_player->getItemCount(itemName);
+    if (owned <= 0) {
+        UISystem::out() << "You don't have any " << itemName << "!" << std::endl;
+        return;
+    }
+    
+    UISystem::out() << "Quantity (1-" << owned << "): ";
+    if (!InputSystem::readNumber(quantity) || quantity <= 0 || quantity > owned) {
+        UISystem::out() << "Invalid quantity" << std::endl;
+        return;
+    }
+    UISystem::out() << "Lowest price per item: ";
+    if (!InputSystem::readNumber(price) || price < 0) {
+        UISystem::out() << "Invalid price" << std::endl;
+        return;
+    }
+    
+    std::vector<Fill> fills;
+    int unfilled = m_exchange.postAsk(atom, PLAYER_TRADER, price, quantity, fills, true);
+    applyFillsToBazaar(fills);
+    
+    int sold = 0;
+    int earned = 0;
+    for (const Fill& fill : fills) {
+        sold += fill.quantity;
+        earned += fill.price * fill.quantity;
+        UISystem::out() << "  Sold " << fill.quantity << " to " << m_bazaar.toCustomer(fill.buyer).name
+                  << " at " << fill.price << std::endl;
+    }
+    
+    if (sold == 0) {
+        UISystem::out() << "No buyer accepts that price." << std::endl;
+        return;
+    }
+    m_player->removeItem(itemName, sold);
+    m_player->money += earned;
+    m_market->recordTrade(sold, earned);
+    UISystem::out() << "Sold " << sold << " " << itemName << " for " << earned << " Money" << std::endl;
+    if (unfilled > 0) {
+        UISystem::out() << unfilled << " left unsold" << std::endl;
+    }
+}
+
+/**
+ * Display the suggested trades
+ * What it does: Runs the trade planner on tonight's customers and the player's inventory and prints
+ *               which customers to serve, what each pays and the total revenue of the plan
+ * Inputs:
+ *   - customers: Tonight's customers
+ * Outputs: None (prints the plan to standard output)
+ */
+void NightPhase::displayTradePlan(const std::vector<Customer>& customers) const {
+    TradePlan plan = planTrades(customers, *m_player);
+    
+    UISystem::out() << "\n=== Suggested Trades ===" << std::endl;
+    if (plan.customers.empty()) {
+        UISystem::out() << "You can't fill any customer's order tonight." << std::endl;
+        return;
+    }
+    for (int index : plan.customers) {
+        const Customer& c = customers[index];
+        UISystem::out() << "[" << (index + 1) << "] " << c.name << ": " << c.desired_item
+                  << " x" << c.desired_quantity << " for "
+                  << calculateTradePrice(c.base_price, c.patience, c.desired_quantity) << " Money" << std::endl;
+    }
+    UISystem::out() << "Total: " << plan.itemsSold << " items for " << plan.revenue << " Money" << std::endl;
+}
+
+/**
+ * Display market history
+ * What it does: Prints the projected demand HISTORY_DISPLAY_DAYS nights ahead, then the last
+ *               HISTORY_DISPLAY_DAYS recorded nights (food, medicine and scrap demand,
+ *               items traded and average price), followed by the 7-day moving average and the
+ *               all-time minimum and maximum of the traded volume and value
+ * Inputs: None
+ * Outputs: None (prints the history to standard output)
+ */
+void NightPhase::displayMarketHistory() const {
+    #ifndef HISTORY_DISPLAY_DAYS
+    #define HISTORY_DISPLAY_DAYS 7  // Default number of nights shown if not defined in Config.h
+    #endif
+    const MarketHistory& history = m_market->getHistory();
+    UISystem::out() << "\n=== Market History ===" << std::endl;
+    
+    MarketTrends forecast = m_market->projectTrends(HISTORY_DISPLAY_DAYS);
+    UISystem::out() << "Demand in " << HISTORY_DISPLAY_DAYS << " nights: " << std::fixed << std::setprecision(2)
+              << "Food " << forecast.getDemandForCategory(CATEGORY_FOOD)
+              << ", Medicine " << forecast.getDemandForCategory(CATEGORY_MEDICINE)
+              << ", Scrap " << forecast.getDemandForCategory(CATEGORY_SCRAP) << "\n" << std::endl;
+    if (history.size() == 0) {
+        UISystem::out() << "No nights recorded yet" << std::endl;
+        return;
+    }
+    
+    UISystem::out() << std::left << std::setw(6) << "Day" << std::setw(8) << "Food" << std::setw(10) << "Medicine"
+              << std::setw(8) << "Scrap" << std::setw(8) << "Sold" << "Avg price" << std::endl;
+    UISystem::out() << std::fixed << std::setprecision(2);
+    for (int row = std::max(0, history.size() - HISTORY_DISPLAY_DAYS); row < history.size(); row++) {
+        float volume = history.valueAt(row, HISTORY_VOLUME);
+        float value = history.valueAt(row, HISTORY_VALUE);
+        UISystem::out() << std::setw(6) << history.dayAt(row)
+                  << std::setw(8) << history.valueAt(row, CATEGORY_FOOD)
+                  << std::setw(10) << history.valueAt(row, CATEGORY_MEDICINE)
+                  << std::setw(8) << history.valueAt(row, CATEGORY_SCRAP)
+                  << std::setw(8) << static_cast<int>(volume)
+                  << (volume > 0 ? value / volume : 0.0f) << std::endl;
+    }
+    UISystem::out() << std::right;
+    
+    HistoryStats volume = history.aggregate(HISTORY_VOLUME, 0, history.size() - 1);
+    HistoryStats value = history.aggregate(HISTORY_VALUE, 0, history.size() - 1);
+    UISystem::out() << "\n7-day average: " << history.movingAverage(HISTORY_VOLUME, 7) << " items, "
+              << history.movingAverage(HISTORY_VALUE, 7) << " Money" << std::endl;
+    UISystem::out() << "Items sold per night: " << static_cast<int>(volume.minimum) << " to "
+              << static_cast<int>(volume.maximum) << std::endl;
+    UISystem::out() << "Money traded per night: " << static_cast<int>(value.minimum) << " to "
+              << static_cast<int>(value.maximum) << std::endl;
+}
+
+/**
+ * Process end of night phase
+ * What it does: Handles all end-of-night operations. Updates market trends (increases demand values
+ *               by growth rate), displays updated demand values to console, charges the daily fee from
+ *               player's money, checks if player has sufficient funds to continue, and implements
+ *               game over condition if funds are insufficient. This is called when player selects
+ *               "End Night" option.
+ * Inputs:
+ *   - day: Current day number, recorded with the night in the market history
+ * Outputs: Returns true if player can continue to next day (sufficient funds for daily fee).
+ *          Returns false if game over (insufficient funds to pay daily fee).
+ *          Modifies market trends (calls Market::updateTrends()), reprices and restocks the black market
+ *          (Market::refreshBlackMarket()) and player money (deducts DAILY_FEE).
+ *          Prints end-of-night information to console.
+ */
+bool NightPhase::processEndOfNight(int day) {
+    if (!m_market) {
+        return false;
+    }
+    
+    UISystem::out() << "\n=== End of Night ===" << std::endl;
+    
+    // Record tonight in the market history, then update market trends
+    m_market->closeDay(day);
+    m_market->updateTrends();
+    m_market->refreshBlackMarket();
+    MarketTrends& trends = m_market->getTrends();
+    
+    UISystem::out() << "Market demand updated:" << std::endl;
+    UISystem::out() << "  Food demand: " << std::fixed << std::setprecision(2) 
+              << trends.getDemandForCategory(CATEGORY_FOOD) << std::endl;
+    UISystem::out() << "  Medicine demand: " << trends.getDemandForCategory(CATEGORY_MEDICINE) << std::endl;
+    UISystem::out() << "  Metal demand: " << trends.getDemandForCategory(CATEGORY_SCRAP) << std::endl;
+    
+    // Charge daily fee
+    #ifndef DAILY_FEE
+    #define DAILY_FEE 10  // Default daily fee if not defined in Config.h
+    #endif
+    UISystem::out() << "\nDaily fee required: " << DAILY_FEE << " Money" << std::endl;
+    
+    // Check if player has enough money
+    int playerMoney = m_player->money;
+    if (playerMoney < DAILY_FEE) {
+        return false;  // Game over
+    }
+    
+    // Deduct fee
+    m_player->money -= DAILY_FEE;
+    UISystem::out() << "Fee paid. Remaining money: " << m_player->money << std::endl;
+    
+    UISystem::out() << "Preparing for next day..." << std::endl;
+    return true;
+}
+
+/**
+ * Save to a save slot
+ * What it does: Prompts for a slot number (1 to the store's slot count, 0 to cancel), saves the
+ *               game into it with SaveSystem::saveToSlot() and waits for the write to finish
+ * Inputs:
+ *   - day: Current day number
+ * Outputs: None (prints whether the save succeeded)
+ */
+void NightPhase::saveToSlot(int day) {
+    int slotCount = SaveSystem::getSlotCount();
+    int slot = 0;
+    UISystem::out() << "Save to slot (1-" << slotCount << ", 0 to cancel): ";
+    if (!InputSystem::readNumber(slot) || slot < 0 || slot > slotCount) {
+        UISystem::out() << "Invalid slot!" << std::endl;
+        return;
+    }
+    if (slot == 0) return;
+
+    if (SaveSystem::saveToSlot(slot - 1, *m_player, day, m_market).get()) {
+        UISystem::out() << "Game saved to slot " << slot << "." << std::endl;
+    } else {
+        UISystem::out() << "Error: game could not be saved." << std::endl;
+    }
+}
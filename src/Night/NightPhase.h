@@ -1,164 +1,232 @@
-#ifndef NIGHTPHASE_H
-#define NIGHTPHASE_H
-
-#include <vector>
-#include <string>
-#include "Customer.h"  // For Customer struct definition
-#include "Market.h"    // For Market class definition
-
-// Forward declarations
-class Player;
-
-/**
- * NightPhase class handling all night phase operations
- * Manages customer trading, black market access, and end-of-day updates
- */
-class NightPhase {
-private:
-    Player* m_player;      // Pointer to player
-    Market* m_market;      // Pointer to market
-    
-    /**
-     * Display customer list and their demands
-     * What it does: Prints a formatted list of all customers showing their name, desired item and quantity,
-     *               offered price, and patience level to the console
-     * Inputs:
-     *   - customers: Vector of Customer objects to display
-     * Outputs: None (prints formatted customer information to standard output)
-     */
-    void displayCustomers(const std::vector<Customer>& customers) const;
-    
-    /**
-     * Handle trading with a specific customer
-     * What it does: Processes a trade transaction with a customer. Displays trade details, checks if
-     *               player has sufficient items, calculates total price, prompts for confirmation,
-     *               removes items from player inventory, and adds money to player if trade is accepted.
-     * Inputs:
-     *   - customer: Customer object representing the NPC to trade with
-     * Outputs: Returns true if trade was successful (player had items and confirmed trade).
-     *          Returns false if player lacks sufficient items or cancelled the trade.
-     *          Prints trade information and results to console.
-     */
-    bool handleCustomerTrade(const Customer& customer);
-    
-    /**
-     * Calculate final price based on customer patience and base price
-     * What it does: Calculates the total price for a trade by multiplying base price per item by quantity,
-     *               then applies a multiplier based on customer patience (higher patience = better price)
-     * Inputs:
-     *   - customer: Customer object containing base_price and patience values
-     *   - quantity: Number of items being sold in the transaction
-     * Outputs: Returns an integer representing the final total price for the transaction
-     */
-    int calculateTradePrice(const Customer& customer, int quantity) const;
-    
-    /**
-     * Check if player has enough items to sell
-     * What it does: Verifies whether the player's inventory contains at least the required quantity
-     *               of the specified item by calling Player::getItemCount()
-     * Inputs:
-     *   - itemName: Name of the item to check for
-     *   - quantity: Minimum quantity required
-     * Outputs: Returns true if player has at least the required quantity of the item.
-     *          Returns false if player has insufficient items or player pointer is null
-     */
-    bool playerHasItem(const std::string& itemName, int quantity) const;
-    
-    /**
-     * Display night phase menu
-     * What it does: Prints the main menu options for the night phase to the console,
-     *               including options to view customers, trade, access black market, view inventory,
-     *               end night, and save & exit
-     * Inputs: None
-     * Outputs: None (prints menu to standard output)
-     */
-    void displayMenu() const;
-    
-    /**
-     * Handle black market access
-     * What it does: Manages the black market interaction loop. Displays black market menu,
-     *               processes player input for item selection, prompts for purchase confirmation,
-     *               and calls Market::purchaseFromBlackMarket() to complete transactions.
-     *               Continues until player selects option to return.
-     * Inputs: None
-     * Outputs: None (modifies player inventory and money through Market::purchaseFromBlackMarket())
-     */
-    void handleBlackMarket();
-    
-    /**
-     * Process end of night phase
-     * What it does: Handles end-of-night operations including updating market trends (demand growth),
-     *               displaying updated demand values, charging the daily fee, and checking if player
-     *               has sufficient funds to continue. Implements game over condition if funds insufficient.
-     * Inputs:
-     *   - day: Current day number (used for display purposes)
-     * Outputs: Returns true if player can continue to next day (sufficient funds for daily fee).
-     *          Returns false if game over (insufficient funds). Modifies market trends and player money.
-     */
-    bool processEndOfNight(int day);
-    
-public:
-    /**
-     * Constructor for NightPhase
-     * What it does: Initializes a NightPhase object with pointers to Player and Market objects
-     * Inputs:
-     *   - player: Pointer to Player object
-     *   - market: Pointer to Market object
-     * Outputs: None (constructor initializes member pointers)
-     */
-    NightPhase(Player* player, Market* market);
-    
-    /**
-     * Default constructor for NightPhase
-     * What it does: Creates a NightPhase object with null pointers. Used for static method calls.
-     * Inputs: None
-     * Outputs: None (constructor initializes member pointers to nullptr)
-     */
-    NightPhase();
-    
-    /**
-     * Execute the night phase (static method)
-     * What it does: Main entry point for the night phase. Creates a temporary Market if none provided,
-     *               instantiates NightPhase, and calls executeNightPhase() to run the night phase loop.
-     *               This static method allows calling without creating a NightPhase instance first.
-     * Inputs:
-     *   - player: Reference to Player object
-     *   - market: Pointer to Market object (can be nullptr, will create temporary Market if needed)
-     *   - day: Current day number
-     * Outputs: None (calls executeNightPhase() which handles the night phase logic)
-     */
-    static void executeNight(Player& player, Market* market, int day);
-    
-    /**
-     * Execute the night phase (instance method)
-     * What it does: Runs the main night phase game loop. Generates customers, displays menu,
-     *               processes player choices (view customers, trade, black market, inventory, end night, save),
-     *               handles input validation, and manages the night phase state until player ends night
-     *               or triggers game over condition.
-     * Inputs:
-     *   - day: Current day number (used for display and passed to processEndOfNight())
-     * Outputs: None (modifies player state through trades and purchases, may exit game on save & exit)
-     */
-    void executeNightPhase(int day);
-    
-    /**
-     * Set player pointer
-     * What it does: Updates the internal player pointer to point to the provided Player object
-     * Inputs:
-     *   - player: Pointer to Player object
-     * Outputs: None (modifies m_player member variable)
-     */
-    void setPlayer(Player* player) { m_player = player; }
-    
-    /**
-     * Set market pointer
-     * What it does: Updates the internal market pointer to point to the provided Market object
-     * Inputs:
-     *   - market: Pointer to Market object
-     * Outputs: None (modifies m_market member variable)
-     */
-    void setMarket(Market* market) { m_market = market; }
-};
-
-#endif // NIGHTPHASE_H
-
+#ifndef NIGHTPHASE_H
+#define NIGHTPHASE_H
+
+#include <vector>
+#include <string>
+#include "Customer.h"  // For Customer struct definition
+#include "Market.h"    // For Market class definition
+#include "OrderBook.h"  // For MatchingEngine class definition
+
+// Forward declarations
+class Player;
+
+/**
+ * NightPhase class handling all night phase operations
+ * Manages customer trading, black market access, and end-of-day updates
+ */
+class NightPhase {
+private:
+    Player* m_player;      // Pointer to player
+    Market* m_market;      // Pointer to market
+    CustomerRoster m_bazaar; // Tonight's bazaar crowd, generated on first visit
+    MatchingEngine m_exchange; // Order books of the trading floor
+    bool m_exchangeOpen;   // True once tonight's order books are filled
+    
+    /**
+     * Display customer list and their demands
+     * What it does: Prints a formatted list of all customers showing their name, desired item and quantity,
+     *               offered price, and patience level to the console
+     * Inputs:
+     *   - customers: Vector of Customer objects to display
+     * Outputs: None (prints formatted customer information to standard output)
+     */
+    void displayCustomers(const std::vector<Customer>& customers) const;
+    
+    /**
+     * Handle trading with a specific customer
+     * What it does: Processes a trade transaction with a customer. Displays trade details, checks if
+     *               player has sufficient items, calculates total price, prompts for confirmation,
+     *               removes items from player inventory, and adds money to player if trade is accepted.
+     * Inputs:
+     *   - customer: Customer object representing the NPC to trade with
+     * Outputs: Returns true if trade was successful (player had items and confirmed trade).
+     *          Returns false if player lacks sufficient items or cancelled the trade.
+     *          Prints trade information and results to console.
+     */
+    bool handleCustomerTrade(const Customer& customer);
+    
+    /**
+     * Check if player has enough items to sell
+     * What it does: Verifies whether the player's inventory contains at least the required quantity
+     *               of the specified item by calling Player::getItemCount()
+     * Inputs:
+     *   - itemName: Name of the item to check for
+     *   - quantity: Minimum quantity required
+     * Outputs: Returns true if player has at least the required quantity of the item.
+     *          Returns false if player has insufficient items or player pointer is null
+     */
+    bool playerHasItem(const std::string& itemName, int quantity) const;
+    
+    /**
+     * Display night phase menu
+     * What it does: Prints the main menu options for the night phase to the console,
+     *               including options to view customers, trade, access black market, view inventory,
+     *               end night, save & exit, visit the bazaar and the trading floor, view the market
+     *               history and the suggested trades
+     * Inputs: None
+     * Outputs: None (prints menu to standard output)
+     */
+    void displayMenu() const;
+    
+    /**
+     * Handle black market access
+     * What it does: Manages the black market interaction loop. Displays black market menu,
+     *               processes player input for item selection, prompts for purchase confirmation,
+     *               and calls Market::purchaseFromBlackMarket() to complete transactions.
+     *               Continues until player selects option to return.
+     * Inputs: None
+     * Outputs: None (modifies player inventory and money through Market::purchaseFromBlackMarket())
+     */
+    void handleBlackMarket();
+    
+    /**
+     * Handle the bazaar
+     * What it does: Generates a crowd of BAZAAR_CUSTOMERS customers the first time it is opened in a night,
+     *               shows a demand summary for every item and the best offers for items the player owns,
+     *               and lets the player trade with one of those customers
+     * Inputs: None
+     * Outputs: None (modifies player inventory and money through handleCustomerTrade())
+     */
+    void handleBazaar();
+    
+    /**
+     * Generate the bazaar crowd if needed
+     * What it does: Fills m_bazaar with BAZAAR_CUSTOMERS customers unless it was already generated tonight
+     * Inputs: None
+     * Outputs: None (modifies m_bazaar)
+     */
+    void prepareBazaar();
+    
+    /**
+     * Open the trading floor
+     * What it does: Resets the order books, posts a bid for every bazaar customer and a few asks
+     *               from NPC sellers for every item, and applies the fills those orders produce
+     * Inputs: None
+     * Outputs: None (modifies m_exchange, m_bazaar and m_exchangeOpen)
+     */
+    void openTradingFloor();
+    
+    /**
+     * Handle the trading floor
+     * What it does: Shows the best bid, bid depth and best ask of every item, lets the player post a
+     *               sell order for an item they own and pays them for every fill. Unfilled quantity
+     *               is cancelled so nothing is sold while the player is away.
+     * Inputs: None
+     * Outputs: None (modifies player inventory and money, prints the books and fills)
+     */
+    void handleTradingFloor();
+    
+    /**
+     * Apply fills to the bazaar crowd
+     * What it does: Reduces the quantity each customer still wants by what they bought
+     * Inputs:
+     *   - fills: Fills returned by the matching engine
+     * Outputs: None (modifies m_bazaar)
+     */
+    void applyFillsToBazaar(const std::vector<Fill>& fills);
+    
+    /**
+     * Display market history
+     * What it does: Prints the demand and trading of the last recorded nights together with
+     *               moving averages and min/max taken from the market's history
+     * Inputs: None
+     * Outputs: None (prints to standard output)
+     */
+    void displayMarketHistory() const;
+    
+    /**
+     * Display the suggested trades
+     * What it does: Prints the revenue-maximising set of customers computed by planTrades()
+     * Inputs:
+     *   - customers: Tonight's customers
+     * Outputs: None (prints to standard output)
+     */
+    void displayTradePlan(const std::vector<Customer>& customers) const;
+
+    /**
+     * Save to a save slot
+     * What it does: Asks for a slot number and saves the game into that slot of the slot store
+     * Inputs:
+     *   - day: Current day number
+     * Outputs: None (prints whether the save succeeded)
+     */
+    void saveToSlot(int day);
+    
+    /**
+     * Process end of night phase
+     * What it does: Handles end-of-night operations including recording the night in the market history,
+     *               updating market trends (demand growth),
+     *               displaying updated demand values, charging the daily fee, and checking if player
+     *               has sufficient funds to continue. Implements game over condition if funds insufficient.
+     * Inputs:
+     *   - day: Current day number (recorded in the market history)
+     * Outputs: Returns true if player can continue to next day (sufficient funds for daily fee).
+     *          Returns false if game over (insufficient funds). Modifies market trends and player money.
+     */
+    bool processEndOfNight(int day);
+    
+public:
+    /**
+     * Constructor for NightPhase
+     * What it does: Initializes a NightPhase object with pointers to Player and Market objects
+     * Inputs:
+     *   - player: Pointer to Player object
+     *   - market: Pointer to Market object
+     * Outputs: None (constructor initializes member pointers)
+     */
+    NightPhase(Player* player, Market* market);
+    
+    /**
+     * Default constructor for NightPhase
+     * What it does: Creates a NightPhase object with null pointers. Used for static method calls.
+     * Inputs: None
+     * Outputs: None (constructor initializes member pointers to nullptr)
+     */
+    NightPhase();
+    
+    /**
+     * Execute the night phase (static method)
+     * What it does: Main entry point for the night phase. Uses the game session's Market if none provided,
+     *               instantiates NightPhase, and calls executeNightPhase() to run the night phase loop.
+     *               This static method allows calling without creating a NightPhase instance first.
+     * Inputs:
+     *   - player: Reference to Player object
+     *   - market: Pointer to Market object (can be nullptr, will use the game session's night market)
+     *   - day: Current day number
+     * Outputs: Returns false if the player saved and quit, true when the night is over
+     */
+    static bool executeNight(Player& player, Market* market, int day);
+    
+    /**
+     * Execute the night phase (instance method)
+     * What it does: Runs the main night phase game loop. Generates customers, displays menu,
+     *               processes player choices (view customers, trade, black market, inventory, end night, save),
+     *               handles input validation, and manages the night phase state until player ends night
+     *               or triggers game over condition.
+     * Inputs:
+     *   - day: Current day number (used for display and passed to processEndOfNight())
+     * Outputs: Returns false if the player chose save & exit, true otherwise
+     */
+    bool executeNightPhase(int day);
+    
+    /**
+     * Set player pointer
+     * What it does: Updates the internal player pointer to point to the provided Player object
+     * Inputs:
+     *   - player: Pointer to Player object
+     * Outputs: None (modifies m_player member variable)
+     */
+    void setPlayer(Player* player) { m_player = player; }
+    
+    /**
+     * Set market pointer
+     * What it does: Updates the internal market pointer to point to the provided Market object
+     * Inputs:
+     *   - market: Pointer to Market object
+     * Outputs: None (modifies m_market member variable)
+     */
+    void setMarket(Market* market) { m_market = market; }
+};
+
+#endif // NIGHTPHASE_H
+
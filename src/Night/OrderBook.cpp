@@ -0,0 +1,181 @@
+#include "OrderBook.h"
+#include <algorithm>
+
+namespace {
+// Heap orderings: std heaps keep the "largest" element at the front,
+// so "less" means "has lower priority"
+struct BidPriority {
+    bool operator()(const Order& a, const Order& b) const {
+        if (a.price != b.price) return a.price < b.price;
+        return a.sequence > b.sequence;
+    }
+};
+
+struct AskPriority {
+    bool operator()(const Order& a, const Order& b) const {
+        if (a.price != b.price) return a.price > b.price;
+        return a.sequence > b.sequence;
+    }
+};
+
+/**
+ * Cross an incoming order against one side of the book
+ * What it does: Takes the front of the resting heap while its price is acceptable, fills the smaller
+ *               of the two quantities at the resting price, and pops resting orders that are used up
+ * Inputs:
+ *   - resting: Heap of the opposite side
+ *   - priority: Ordering of that heap
+ *   - incoming: The incoming order, its quantity is reduced as it fills
+ *   - isBid: True if the incoming order is a bid
+ *   - item: Item atom, copied into the fills
+ *   - fills: Fills are appended here
+ * Outputs: None (modifies resting, incoming and fills)
+ */
+template <typename Priority>
+void cross(std::vector<Order>& resting, Priority priority, Order& incoming, bool isBid,
+           int item, std::vector<Fill>& fills) {
+    while (incoming.quantity > 0 && !resting.empty()) {
+        Order& best = resting.front();
+        bool priceOk = isBid ? best.price <= incoming.price : best.price >= incoming.price;
+        if (!priceOk) {
+            break;
+        }
+
+        int traded = std::min(best.quantity, incoming.quantity);
+        Fill fill;
+        fill.item = item;
+        fill.buyer = isBid ? incoming.trader : best.trader;
+        fill.seller = isBid ? best.trader : incoming.trader;
+        fill.price = best.price;
+        fill.quantity = traded;
+        fills.push_back(fill);
+
+        incoming.quantity -= traded;
+        best.quantity -= traded;  // Only the quantity changes, the heap order still holds
+        if (best.quantity == 0) {
+            std::pop_heap(resting.begin(), resting.end(), priority);
+            resting.pop_back();
+        }
+    }
+}
+}
+
+/**
+ * Clear the book
+ * What it does: Removes every bid and ask
+ * Inputs: None
+ * Outputs: None (modifies bids and asks)
+ */
+void OrderBook::clear() {
+    bids.clear();
+    asks.clear();
+}
+
+/**
+ * Match an incoming order and rest the remainder
+ * What it does: Crosses the order against the opposite heap, then pushes any remainder onto its own
+ *               side's heap (unless immediateOrCancel is set)
+ * Inputs:
+ *   - item: Item atom of this book
+ *   - isBid: True for a buy order, false for a sell order
+ *   - order: The incoming order
+ *   - fills: Fills are appended here
+ *   - immediateOrCancel: If true, the remainder is dropped
+ * Outputs: Returns the quantity left unfilled
+ */
+int OrderBook::submit(int item, bool isBid, Order order, std::vector<Fill>& fills, bool immediateOrCancel) {
+    if (isBid) {
+        cross(asks, AskPriority(), order, true, item, fills);
+    } else {
+        cross(bids, BidPriority(), order, false, item, fills);
+    }
+
+    if (order.quantity > 0 && !immediateOrCancel) {
+        if (isBid) {
+            bids.push_back(order);
+            std::push_heap(bids.begin(), bids.end(), BidPriority());
+        } else {
+            asks.push_back(order);
+            std::push_heap(asks.begin(), asks.end(), AskPriority());
+        }
+    }
+    return order.quantity;
+}
+
+/**
+ * Get the total quantity wanted by buyers
+ * What it does: Sums the open quantity of the bids
+ * Inputs: None
+ * Outputs: Returns the number of items bid for
+ */
+int OrderBook::bidDepth() const {
+    int depth = 0;
+    for (const Order& order : bids) {
+        depth += order.quantity;
+    }
+    return depth;
+}
+
+/**
+ * MatchingEngine constructor
+ * What it does: Starts with no books and sequence 0
+ * Inputs: None
+ * Outputs: None (constructor)
+ */
+MatchingEngine::MatchingEngine() : nextSequence(0) {
+}
+
+/**
+ * Reset the engine
+ * What it does: Resizes the book table to itemCount and clears every book
+ * Inputs:
+ *   - itemCount: Number of item atoms
+ * Outputs: None (modifies books and nextSequence)
+ */
+void MatchingEngine::reset(int itemCount) {
+    books.resize(itemCount);
+    for (OrderBook& book : books) {
+        book.clear();
+    }
+    nextSequence = 0;
+}
+
+/**
+ * Post a buy order
+ * What it does: Stamps the order with the next sequence number and submits it to the item's book
+ * Inputs:
+ *   - item: Item atom
+ *   - trader: Trader id of the buyer
+ *   - price: Highest price per item the buyer accepts
+ *   - quantity: Number of items wanted
+ *   - fills: Fills are appended here
+ * Outputs: Returns the quantity left unfilled, or the full quantity if the item is unknown
+ */
+int MatchingEngine::postBid(int item, int trader, int price, int quantity, std::vector<Fill>& fills) {
+    if (item < 0 || item >= getBookCount() || quantity <= 0) {
+        return quantity;
+    }
+    Order order = {trader, price, quantity, nextSequence++};
+    return books[item].submit(item, true, order, fills, false);
+}
+
+/**
+ * Post a sell order
+ * What it does: Stamps the order with the next sequence number and submits it to the item's book
+ * Inputs:
+ *   - item: Item atom
+ *   - trader: Trader id of the seller
+ *   - price: Lowest price per item the seller accepts
+ *   - quantity: Number of items offered
+ *   - fills: Fills are appended here
+ *   - immediateOrCancel: If true, the unfilled remainder is dropped
+ * Outputs: Returns the quantity left unfilled, or the full quantity if the item is unknown
+ */
+int MatchingEngine::postAsk(int item, int trader, int price, int quantity, std::vector<Fill>& fills,
+                            bool immediateOrCancel) {
+    if (item < 0 || item >= getBookCount() || quantity <= 0) {
+        return quantity;
+    }
+    Order order = {trader, price, quantity, nextSequence++};
+    return books[item].submit(item, false, order, fills, immediateOrCancel);
+}
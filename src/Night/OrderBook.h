@@ -0,0 +1,174 @@
+#ifndef ORDERBOOK_H
+#define ORDERBOOK_H
+
+#include <vector>
+#include <cstdint>
+
+// Trader ids that are not customers; customers use their index in the bazaar roster
+const int PLAYER_TRADER = -1;
+const int NPC_SELLER = -2;
+
+/**
+ * Order structure representing one resting bid or ask
+ * Price is per item, quantity is what is still open
+ */
+struct Order {
+    int trader;          // Who posted the order
+    int price;           // Price per item
+    int quantity;        // Items still open
+    uint64_t sequence;   // Arrival order, earlier orders win ties on price
+};
+
+/**
+ * Fill structure describing one match between a buyer and a seller
+ */
+struct Fill {
+    int item;            // Item atom the fill is for
+    int buyer;           // Trader id of the buyer
+    int seller;          // Trader id of the seller
+    int price;           // Price per item, the resting order's price
+    int quantity;        // Items traded
+};
+
+/**
+ * OrderBook class holding the bids and asks of one item
+ * Bids and asks are binary heaps with price-time priority, so posting an order and
+ * taking the best order of the other side are O(log n)
+ */
+class OrderBook {
+private:
+    std::vector<Order> bids;   // Max-heap on price, then earliest sequence
+    std::vector<Order> asks;   // Min-heap on price, then earliest sequence
+
+public:
+    /**
+     * Remove every order
+     * What it does: Clears both sides of the book, keeping the allocated capacity
+     * Inputs: None
+     * Outputs: None (modifies bids and asks)
+     */
+    void clear();
+
+    /**
+     * Match an incoming order and rest the remainder
+     * What it does: Crosses the order against the best orders of the other side while prices allow,
+     *               producing one fill per resting order touched (partial fills included). Whatever is
+     *               left is added to the book unless immediateOrCancel is set.
+     * Inputs:
+     *   - item: Item atom of this book, copied into the fills
+     *   - isBid: True for a buy order, false for a sell order
+     *   - order: The incoming order
+     *   - fills: Fills produced by the match are appended here
+     *   - immediateOrCancel: If true, the unfilled remainder is dropped instead of resting
+     * Outputs: Returns the quantity left unfilled
+     */
+    int submit(int item, bool isBid, Order order, std::vector<Fill>& fills, bool immediateOrCancel);
+
+    /**
+     * Get the best bid
+     * What it does: Returns the highest resting bid
+     * Inputs: None
+     * Outputs: Returns a pointer to the best bid, nullptr if there are no bids
+     */
+    const Order* bestBid() const { return bids.empty() ? nullptr : &bids.front(); }
+
+    /**
+     * Get the best ask
+     * What it does: Returns the lowest resting ask
+     * Inputs: None
+     * Outputs: Returns a pointer to the best ask, nullptr if there are no asks
+     */
+    const Order* bestAsk() const { return asks.empty() ? nullptr : &asks.front(); }
+
+    /**
+     * Get the total quantity wanted by buyers
+     * What it does: Sums the open quantity of every resting bid
+     * Inputs: None
+     * Outputs: Returns the number of items bid for
+     */
+    int bidDepth() const;
+
+    /**
+     * Get the number of resting orders
+     * What it does: Returns the number of bids plus the number of asks
+     * Inputs: None
+     * Outputs: Returns the order count
+     */
+    int orderCount() const { return static_cast<int>(bids.size() + asks.size()); }
+};
+
+/**
+ * MatchingEngine class owning one order book per item atom
+ * It hands out sequence numbers so time priority holds across every book
+ */
+class MatchingEngine {
+private:
+    std::vector<OrderBook> books;   // Indexed by item atom
+    uint64_t nextSequence;          // Sequence number of the next order
+
+public:
+    /**
+     * Constructor for MatchingEngine
+     * What it does: Creates an engine without books
+     * Inputs: None
+     * Outputs: None (constructor)
+     */
+    MatchingEngine();
+
+    /**
+     * Reset the engine
+     * What it does: Makes sure there is one empty book per item atom and restarts the sequence
+     * Inputs:
+     *   - itemCount: Number of item atoms
+     * Outputs: None (modifies books and nextSequence)
+     */
+    void reset(int itemCount);
+
+    /**
+     * Post a buy order
+     * What it does: Matches a bid against the asks of the item and rests the remainder
+     * Inputs:
+     *   - item: Item atom
+     *   - trader: Trader id of the buyer
+     *   - price: Highest price per item the buyer accepts
+     *   - quantity: Number of items wanted
+     *   - fills: Fills produced are appended here
+     * Outputs: Returns the quantity left unfilled
+     */
+    int postBid(int item, int trader, int price, int quantity, std::vector<Fill>& fills);
+
+    /**
+     * Post a sell order
+     * What it does: Matches an ask against the bids of the item, the remainder rests unless
+     *               immediateOrCancel is set
+     * Inputs:
+     *   - item: Item atom
+     *   - trader: Trader id of the seller
+     *   - price: Lowest price per item the seller accepts
+     *   - quantity: Number of items offered
+     *   - fills: Fills produced are appended here
+     *   - immediateOrCancel: If true, the unfilled remainder is dropped
+     * Outputs: Returns the quantity left unfilled
+     */
+    int postAsk(int item, int trader, int price, int quantity, std::vector<Fill>& fills,
+                bool immediateOrCancel = false);
+
+    /**
+     * Get the book of an item
+     * What it does: Returns the order book for an item atom
+     * Inputs:
+     *   - item: Item atom
+     * Outputs: Returns a const reference to the book
+     */
+    const OrderBook& getBook(int item) const { return books[item]; }
+
+    /**
+     * Get the number of books
+     * What it does: Returns the number of item atoms the engine trades
+     * Inputs: None
+     * Outputs: Returns the number of books
+     */
+    int getBookCount() const { return static_cast<int>(books.size()); }
+};
+
+#endif // ORDERBOOK_H
@@ -0,0 +1,94 @@
+#include "TradePlanner.h"
+#include "../Player/Player.h"
+#include <algorithm>
+
+/**
+ * Plan the most profitable set of trades
+ * What it does: Groups the customers by desired item. For each item, best[c] is the highest revenue
+ *               reachable with c items of stock; customers are added one at a time (iterating c
+ *               downwards so each is used at most once) and take[i][c] remembers whether customer i
+ *               was part of the best answer for c. The served customers are recovered by walking
+ *               take[] back from the full stock.
+ * Inputs:
+ *   - customers: Tonight's customers
+ *   - stock: Number of items the player owns, keyed by item name
+ * Outputs: Returns the plan with the highest total revenue
+ */
+TradePlan planTrades(const std::vector<Customer>& customers, const std::map<std::string, int>& stock) {
+    TradePlan plan;
+    plan.revenue = 0;
+    plan.itemsSold = 0;
+
+    std::map<std::string, std::vector<int> > byItem;
+    for (size_t i = 0; i < customers.size(); i++) {
+        if (customers[i].desired_quantity > 0) {
+            byItem[customers[i].desired_item].push_back(static_cast<int>(i));
+        }
+    }
+
+    std::vector<int> best;
+    std::vector<char> take;
+    for (const auto& group : byItem) {
+        std::map<std::string, int>::const_iterator owned = stock.find(group.first);
+        if (owned == stock.end() || owned->second <= 0) {
+            continue;
+        }
+        const std::vector<int>& members = group.second;
+
+        // No point in tracking more stock than every customer together wants
+        int wanted = 0;
+        for (int index : members) {
+            wanted += customers[index].desired_quantity;
+        }
+        const int capacity = std::min(owned->second, wanted);
+        const int n = static_cast<int>(members.size());
+
+        best.assign(capacity + 1, 0);
+        take.assign(static_cast<size_t>(n) * (capacity + 1), 0);
+        for (int i = 0; i < n; i++) {
+            const Customer& c = customers[members[i]];
+            int weight = c.desired_quantity;
+            int value = calculateTradePrice(c.base_price, c.patience, weight);
+            char* row = &take[static_cast<size_t>(i) * (capacity + 1)];
+            for (int left = capacity; left >= weight; left--) {
+                if (best[left - weight] + value > best[left]) {
+                    best[left] = best[left - weight] + value;
+                    row[left] = 1;
+                }
+            }
+        }
+
+        int left = capacity;
+        for (int i = n - 1; i >= 0; i--) {
+            if (take[static_cast<size_t>(i) * (capacity + 1) + left]) {
+                const Customer& c = customers[members[i]];
+                plan.customers.push_back(members[i]);
+                plan.itemsSold += c.desired_quantity;
+                left -= c.desired_quantity;
+            }
+        }
+        plan.revenue += best[capacity];
+    }
+
+    std::sort(plan.customers.begin(), plan.customers.end());
+    return plan;
+}
+
+/**
+ * Plan the most profitable set of trades for a player
+ * What it does: Builds the stock table from Player::getItemCount() for each wanted item
+ * Inputs:
+ *   - customers: Tonight's customers
+ *   - player: Player whose inventory is sold from
+ * Outputs: Returns the plan with the highest total revenue
+ */
+TradePlan planTrades(const std::vector<Customer>& customers, Player& player) {
+    std::map<std::string, int> stock;
+    for (const Customer& c : customers) {
+        if (stock.find(c.desired_item) == stock.end()) {
+            std::string name = c.desired_item;
+            stock[c.desired_item] = player.getItemCount(name);
+        }
+    }
+    return planTrades(customers, stock);
+}
@@ -0,0 +1,46 @@
+#ifndef TRADEPLANNER_H
+#define TRADEPLANNER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "Customer.h"
+
+// Forward declarations
+class Player;
+
+/**
+ * TradePlan structure describing which customers to serve
+ */
+struct TradePlan {
+    std::vector<int> customers;   // Indices into the customer list, in list order
+    int revenue;                  // Total money earned by serving them
+    int itemsSold;                // Total number of items handed over
+};
+
+/**
+ * Plan the most profitable set of trades
+ * What it does: Customers who want the same item compete for the player's stock of that item, and
+ *               a customer is either served in full or not at all. Items are independent, so each
+ *               item is solved as a 0/1 knapsack: the state is the count of that item still in
+ *               stock, the weight of a customer is their desired quantity and the value is their
+ *               calculateTradePrice() outcome. Cost is O(customers x stock) per item.
+ * Inputs:
+ *   - customers: Tonight's customers
+ *   - stock: Number of items the player owns, keyed by item name
+ * Outputs: Returns the plan with the highest total revenue
+ */
+TradePlan planTrades(const std::vector<Customer>& customers, const std::map<std::string, int>& stock);
+
+/**
+ * Plan the most profitable set of trades for a player
+ * What it does: Counts the player's inventory for every item the customers want, then calls
+ *               planTrades() with those counts
+ * Inputs:
+ *   - customers: Tonight's customers
+ *   - player: Player whose inventory is sold from
+ * Outputs: Returns the plan with the highest total revenue
+ */
+TradePlan planTrades(const std::vector<Customer>& customers, Player& player);
+
+#endif // TRADEPLANNER_H
@@ -1,22 +1,86 @@
 // Player.cpp
 #include "Player.h"
+#include "../Core/UISystem.h"
 #include "../Item/item.h"  
+#include "../Item/itemdatabase.h"
 #include <iostream>
 #include <algorithm>
 #include <string>
 
 using namespace std;
 
+// Copies an inventory
+// What it does: Makes a copy of every item, so the copy can be changed on its own
+// Inputs: other - Inventory to copy
+// Outputs: None (copy constructor)
+InventoryData::InventoryData(const InventoryData& other) {
+    items.reserve(other.items.size());
+    for (Item* item : other.items) {
+        items.push_back(item ? new Item(*item) : nullptr);
+    }
+}
+
+// Frees an inventory
+// What it does: Deletes every item it owns
+// Inputs: None
+// Outputs: None (destructor)
+InventoryData::~InventoryData() {
+    for (Item* item : items) {
+        delete item;
+    }
+}
+
+// Gets the inventory for changing
+// What it does: Copies the inventory first if another Player shares it, so changes and item
+//               pointers handed out from here only affect this Player
+// Inputs: None
+// Outputs: vector<Item*>& - This Player's own inventory
+vector<Item*>& Player::ownInventory() {
+    if (inventory.use_count() > 1) {
+        inventory = make_shared<InventoryData>(*inventory);
+    }
+    return inventory->items;
+}
+
+// Gets the combat player for changing
+// What it does: Copies the combat player first if another Player shares it
+// Inputs: None
+// Outputs: CombatPlayer* - This Player's own combat player, or nullptr if there is none
+CombatPlayer* Player::getCombatPlayer() {
+    if (combatPlayer && combatPlayer.use_count() > 1) {
+        shared_ptr<CombatPlayer> copy = make_shared<CombatPlayer>(combatPlayer->getName());
+        copy->restoreState(combatPlayer->getState());
+        combatPlayer = copy;
+    }
+    return combatPlayer.get();
+}
+
 // Adds an item to player's inventory
 // What it does: Adds item pointer to inventory vector if not null
 // Inputs: item - Pointer to Item object to add
 // Outputs: None
 void Player::addItem(Item* item) {
     if (item != nullptr) {
-        inventory.push_back(item);
+        ownInventory().push_back(item);
     }
 }
 
+// Adds a stack of identical items to player's inventory
+// What it does: Reserves room once, then adds count copies of the prototype with the given ID
+// Inputs: prototypeId - Item ID of the prototype to copy
+//         count - Number of items to add
+// Outputs: int - Number of items added (0 if the ID is unknown)
+int Player::addItems(int prototypeId, int count) {
+    if (count <= 0 || getItemPrototype(prototypeId) == nullptr) return 0;
+
+    vector<Item*>& items = ownInventory();
+    items.reserve(items.size() + count);
+    for (int i = 0; i < count; i++) {
+        items.push_back(createItemFromPrototype(prototypeId));
+    }
+    return count;
+}
+
 // Removes specified quantity of items from inventory
 // What it does: Searches for items by name and removes specified quantity
 // Inputs: itemName - Name of item to remove
@@ -26,13 +90,14 @@ bool Player::removeItem(string& itemName, int quantity) {
     if (quantity <= 0) return false;
     
     int removedCount = 0;
-    auto it = inventory.begin();
+    vector<Item*>& items = ownInventory();
+    auto it = items.begin();
     
-    while (it != inventory.end() && removedCount < quantity) {
+    while (it != items.end() && removedCount < quantity) {
         if ((*it)->name == itemName) {
             // Delete dynamically allocated memory
             delete *it;
-            it = inventory.erase(it);
+            it = items.erase(it);
             removedCount++;
         } else {
             ++it;
@@ -47,7 +112,7 @@ bool Player::removeItem(string& itemName, int quantity) {
 // Inputs: itemName - Name of item to check for
 // Outputs: bool - True if item exists in inventory, false otherwise
 bool Player::hasItem(const string& itemName) {
-    for (Item* item : inventory) {
+    for (Item* item : inventory->items) {
         if (item->name == itemName) {
             return true;
         }
@@ -61,7 +126,7 @@ bool Player::hasItem(const string& itemName) {
 // Outputs: int - Number of items with matching name
 int Player::getItemCount(string& itemName) {
     int count = 0;
-    for (Item* item : inventory) {
+    for (Item* item : inventory->items) {
         if (item->name == itemName) {
             count++;
         }
@@ -75,7 +140,7 @@ int Player::getItemCount(string& itemName) {
 // Outputs: Item* - Pointer to best weapon, or nullptr if no weapons
 Item* Player::getBestWeapon() {
     Item* bestWeapon = nullptr;
-    for (Item* item : inventory) {
+    for (Item* item : ownInventory()) {
         if (item && item->category == CATEGORY_WEAPON) {
             if (!bestWeapon || item->damage > bestWeapon->damage) {
                 bestWeapon = item;
@@ -91,10 +156,11 @@ Item* Player::getBestWeapon() {
 // Outputs: bool - True if item was found and removed, false otherwise
 bool Player::removeSpecificItem(Item* target) {
     if (!target) return false;
-    for (auto it = inventory.begin(); it != inventory.end(); ++it) {
+    vector<Item*>& items = ownInventory();
+    for (auto it = items.begin(); it != items.end(); ++it) {
         if (*it == target) {
             delete *it;
-            inventory.erase(it);
+            items.erase(it);
             return true;
         }
     }
@@ -106,18 +172,18 @@ bool Player::removeSpecificItem(Item* target) {
 // Inputs: None
 // Outputs: None
 void Player::displayInventory() {
-    cout << "=== BASICS ===" << endl;
-    cout << "HP: " << hp << " | STAMINA: " << stamina << " | MONEY: " << money << endl;
-    cout << "BACKPACK:" << endl;
+    UISystem::out() << "=== BASICS ===" << endl;
+    UISystem::out() << "HP: " << hp << " | STAMINA: " << stamina << " | MONEY: " << money << endl;
+    UISystem::out() << "BACKPACK:" << endl;
 
-    if (inventory.empty()) {
-        cout << "EMPTY" << endl;
+    if (inventory->items.empty()) {
+        UISystem::out() << "EMPTY" << endl;
         return;
     }
 
     // Count quantities of same items
     vector<pair<string, int>> itemCounts;
-    for (Item* item : inventory) {
+    for (Item* item : inventory->items) {
         bool found = false;
         for (auto& pair : itemCounts) {
             if (pair.first == item->name) {
@@ -134,7 +200,7 @@ void Player::displayInventory() {
     // Display items
     for (auto& pair : itemCounts) {
         // Here you can add method to get item base value
-        cout << "  " << pair.first << " x" << pair.second << endl;
+        UISystem::out() << "  " << pair.first << " x" << pair.second << endl;
     }
 }
 
@@ -174,15 +240,12 @@ void Player::consumeStamina(int amount) {
 }
 
 // Clears all items from inventory
-// What it does: Deletes all dynamically allocated items and clears inventory vector
+// What it does: Starts an empty inventory; the old items are deleted unless another Player still
+//               shares them
 // Inputs: None
 // Outputs: None
 void Player::clearInventory() {
-    // Clean up all dynamically allocated items
-    for (Item* item : inventory) {
-        delete item;
-    }
-    inventory.clear();
+    inventory = make_shared<InventoryData>();
 }
 
 // Initializes combat player component
@@ -190,7 +253,7 @@ void Player::clearInventory() {
 // Inputs: name - Name for the combat player
 // Outputs: None
 void Player::initializeCombatPlayer(const string& name) {
-    combatPlayer = std::unique_ptr<CombatPlayer>(new CombatPlayer(name));
+    combatPlayer = make_shared<CombatPlayer>(name);
 }
 
 // Increases harmony stat for combat player
@@ -198,7 +261,7 @@ void Player::initializeCombatPlayer(const string& name) {
 // Inputs: None
 // Outputs: None
 void Player::increaseHarmony() {
-    if (combatPlayer) combatPlayer->increaseHarmony();
+    if (CombatPlayer* combat = getCombatPlayer()) combat->increaseHarmony();
 }
 
 // Increases combo counter for combat player
@@ -206,7 +269,7 @@ void Player::increaseHarmony() {
 // Inputs: None
 // Outputs: None
 void Player::increaseCombo() {
-    if (combatPlayer) combatPlayer->increaseCombo();
+    if (CombatPlayer* combat = getCombatPlayer()) combat->increaseCombo();
 }
 
 // Resets combo counter for combat player
@@ -214,7 +277,7 @@ void Player::increaseCombo() {
 // Inputs: None
 // Outputs: None
 void Player::resetCombo() {
-    if (combatPlayer) combatPlayer->resetCombo();
+    if (CombatPlayer* combat = getCombatPlayer()) combat->resetCombo();
 }
 
 // Gets current combo count
@@ -222,7 +285,8 @@ void Player::resetCombo() {
 // Inputs: None
 // Outputs: int - Current combo count
 int Player::getCombo() {
-    return combatPlayer ? combatPlayer->getCombo() : 0;
+    CombatPlayer* combat = getCombatPlayer();
+    return combat ? combat->getCombo() : 0;
 }
 
 // Gets current harmony level
@@ -230,7 +294,8 @@ int Player::getCombo() {
 // Inputs: None
 // Outputs: int - Current harmony level
 int Player::getHarmony() {
-    return combatPlayer ? combatPlayer->getHarmony() : 0;
+    CombatPlayer* combat = getCombatPlayer();
+    return combat ? combat->getHarmony() : 0;
 }
 
 // Checks if player has extra turns available
@@ -238,7 +303,8 @@ int Player::getHarmony() {
 // Inputs: None
 // Outputs: bool - True if extra turns available, false otherwise
 bool Player::hasExtraTurns() {
-    return combatPlayer ? combatPlayer->hasExtraTurns() : false;
+    CombatPlayer* combat = getCombatPlayer();
+    return combat ? combat->hasExtraTurns() : false;
 }
 
 // Uses one extra turn
@@ -246,7 +312,7 @@ bool Player::hasExtraTurns() {
 // Inputs: None
 // Outputs: None
 void Player::useExtraTurn() {
-    if (combatPlayer) combatPlayer->useExtraTurn();
+    if (CombatPlayer* combat = getCombatPlayer()) combat->useExtraTurn();
 }
 
 // Resets turn state for combat player
@@ -254,5 +320,5 @@ void Player::useExtraTurn() {
 // Inputs: None
 // Outputs: None
 void Player::resetTurn() {
-    if (combatPlayer) combatPlayer->resetTurn();
+    if (CombatPlayer* combat = getCombatPlayer()) combat->resetTurn();
 }
\ No newline at end of file
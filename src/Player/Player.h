@@ -9,18 +9,38 @@
 #include <memory>
 using namespace std;
 
+// Items owned by a Player, shared by copies of it until one of them changes its inventory
+struct InventoryData {
+    vector<Item*> items;
+
+    InventoryData() {}
+    InventoryData(const InventoryData& other); // Copies every item
+    InventoryData& operator=(const InventoryData&) = delete;
+    ~InventoryData();                          // Deletes the items
+};
+
+// Copying a Player is cheap: the copy shares the inventory and combat player, and whichever
+// side changes one of them first gets its own copy of it (copy-on-write)
 class Player {
 private:
-    vector<Item*> inventory;
-    unique_ptr<CombatPlayer> combatPlayer;
+    shared_ptr<InventoryData> inventory = make_shared<InventoryData>();
+    shared_ptr<CombatPlayer> combatPlayer;
+
+    // Inventory for changing, copied first if another Player shares it
+    vector<Item*>& ownInventory();
 
 public:
     int hp = 100;
     int stamina = 50;
     int money = 0; // Initial value
 
+    Player() {}
+    Player(const Player& other) = default;
+    Player& operator=(const Player& other) = default;
+
     // Item management
     void addItem(Item* item);
+    int addItems(int prototypeId, int count);
     bool removeItem(string& itemName, int quantity = 1);
     bool hasItem(const string& itemName);
     int getItemCount(string& itemName);
@@ -34,15 +54,17 @@ public:
     void restoreStamina(int amount);
     void consumeStamina(int amount);
 
-    // Get item list
-    vector<Item*>& getInventory() { return inventory; }
+    // Get item list; the mutable version makes the inventory this Player's own
+    vector<Item*>& getInventory() { return ownInventory(); }
+    const vector<Item*>& getInventory() const { return inventory->items; }
 
     // Clear inventory (for game reset)
     void clearInventory();
 
     // Combat system methods - delegated to CombatPlayer
     void initializeCombatPlayer(const string& name);
-    CombatPlayer* getCombatPlayer() { return combatPlayer.get(); }
+    CombatPlayer* getCombatPlayer(); // Copied first if another Player shares it
+    const CombatPlayer* getCombatPlayer() const { return combatPlayer.get(); }
     void increaseHarmony();
     void increaseCombo();
     void resetCombo();
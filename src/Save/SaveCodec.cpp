@@ -0,0 +1,390 @@
+#include "SaveCodec.h"
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+namespace SaveCodec {
+
+namespace {
+const int MIN_MATCH = 4;            // Shortest back-reference worth encoding
+const int MAX_OFFSET = 65535;       // Offsets are stored in 16 bits
+const int HASH_BITS = 12;           // 4096-entry match finder
+
+// Byte-at-a-time CRC32C table, reflected polynomial 0x82F63B78
+struct Crc32cTable {
+    uint32_t entries[256];
+    Crc32cTable() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+// Reads 4 bytes at p as one value for hashing
+uint32_t read32(const char* p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// Hashes 4 bytes into a match finder slot
+uint32_t hash4(const char* p) {
+    return (read32(p) * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// Appends an LZ length: the part over 15 as a run of 255s and a final byte
+void putLength(string& out, size_t length) {
+    while (length >= 255) {
+        out.push_back(static_cast<char>(255));
+        length -= 255;
+    }
+    out.push_back(static_cast<char>(length));
+}
+
+// Reads the extra bytes of an LZ length
+bool getLength(const string& in, size_t& pos, size_t& length) {
+    unsigned char byte;
+    do {
+        if (pos >= in.size()) return false;
+        byte = static_cast<unsigned char>(in[pos++]);
+        length += byte;
+        if (length > in.size() * 255 + 255) return false;
+    } while (byte == 255);
+    return true;
+}
+
+// Appends one sequence: literals, then (unless last) a back-reference
+void putSequence(string& out, const char* literals, size_t literalLength, size_t offset, size_t matchLength) {
+    size_t matchCode = matchLength ? matchLength - MIN_MATCH : 0;
+    unsigned char token = static_cast<unsigned char>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                                     (matchCode < 15 ? matchCode : 15));
+    out.push_back(static_cast<char>(token));
+    if (literalLength >= 15) putLength(out, literalLength - 15);
+    out.append(literals, literalLength);
+    if (matchLength == 0) return;
+    out.push_back(static_cast<char>(offset & 0xFF));
+    out.push_back(static_cast<char>(offset >> 8));
+    if (matchCode >= 15) putLength(out, matchCode - 15);
+}
+}
+
+// Computes CRC32C
+// What it does: Table-driven CRC32C over the bytes, initial value and final xor 0xFFFFFFFF
+// Inputs: data - Bytes to checksum
+//         size - Number of bytes
+// Outputs: uint32_t - Checksum
+uint32_t crc32c(const char* data, size_t size) {
+    static const Crc32cTable table;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table.entries[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Computes CRC32C of a string
+// What it does: See crc32c(const char*, size_t)
+// Inputs: bytes - Bytes to checksum
+// Outputs: uint32_t - Checksum
+uint32_t crc32c(const string& bytes) {
+    return crc32c(bytes.data(), bytes.size());
+}
+
+// Compresses a block
+// What it does: Walks the input once; at each position the hash table gives the last position
+//               with the same 4 bytes. A hit within 64 KiB is extended as far as it matches and
+//               emitted as a back-reference, otherwise the byte stays a literal.
+// Inputs: input - Bytes to compress
+// Outputs: string - Compressed block
+string compress(const string& input) {
+    string out;
+    out.reserve(input.size() / 2 + 16);
+    const char* data = input.data();
+    const size_t size = input.size();
+    vector<int> table(1 << HASH_BITS, -1);
+
+    size_t anchor = 0;
+    size_t pos = 0;
+    while (pos + MIN_MATCH <= size) {
+        uint32_t slot = hash4(data + pos);
+        int candidate = table[slot];
+        table[slot] = static_cast<int>(pos);
+        if (candidate < 0 || pos - candidate > static_cast<size_t>(MAX_OFFSET) ||
+            read32(data + candidate) != read32(data + pos)) {
+            pos++;
+            continue;
+        }
+
+        size_t length = MIN_MATCH;
+        while (pos + length < size && data[candidate + length] == data[pos + length]) {
+            length++;
+        }
+        putSequence(out, data + anchor, pos - anchor, pos - candidate, length);
+        pos += length;
+        anchor = pos;
+    }
+    putSequence(out, data + anchor, size - anchor, 0, 0);
+    return out;
+}
+
+// Decompresses a block
+// What it does: Replays the sequences, checking every length and offset against the input and
+//               the expected output size, so corrupt data fails instead of reading out of bounds
+// Inputs: input - Compressed block
+//         rawSize - Expected output size
+//         output - Receives the data
+// Outputs: bool - True if the block decoded to exactly rawSize bytes
+bool decompress(const string& input, size_t rawSize, string& output) {
+    output.clear();
+    output.reserve(rawSize);
+    size_t pos = 0;
+    while (pos < input.size()) {
+        unsigned char token = static_cast<unsigned char>(input[pos++]);
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !getLength(input, pos, literalLength)) return false;
+        if (literalLength > input.size() - pos || literalLength > rawSize - output.size()) return false;
+        output.append(input, pos, literalLength);
+        pos += literalLength;
+        if (pos == input.size()) break;  // Last sequence has no match
+
+        if (input.size() - pos < 2) return false;
+        size_t offset = static_cast<unsigned char>(input[pos]) |
+                        (static_cast<size_t>(static_cast<unsigned char>(input[pos + 1])) << 8);
+        pos += 2;
+        size_t matchLength = token & 0x0F;
+        if (matchLength == 15 && !getLength(input, pos, matchLength)) return false;
+        matchLength += MIN_MATCH;
+        if (offset == 0 || offset > output.size() || matchLength > rawSize - output.size()) return false;
+
+        // Byte by byte: the match may overlap the bytes it produces
+        size_t from = output.size() - offset;
+        for (size_t i = 0; i < matchLength; i++) {
+            output.push_back(output[from + i]);
+        }
+    }
+    return output.size() == rawSize;
+}
+
+// Appends one byte
+void ByteWriter::putU8(uint8_t value) {
+    bytes.push_back(static_cast<char>(value));
+}
+
+// Appends a 32-bit unsigned value, least significant byte first
+void ByteWriter::putU32(uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        bytes.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+// Appends a 32-bit signed value as its two's complement bits
+void ByteWriter::putI32(int32_t value) {
+    putU32(static_cast<uint32_t>(value));
+}
+
+// Appends a signed 64-bit field, low word first
+void ByteWriter::putI64(int64_t value) {
+    uint64_t bits = static_cast<uint64_t>(value);
+    putU32(static_cast<uint32_t>(bits));
+    putU32(static_cast<uint32_t>(bits >> 32));
+}
+
+// Appends a length-prefixed string
+void ByteWriter::putString(const string& value) {
+    putU32(static_cast<uint32_t>(value.size()));
+    bytes += value;
+}
+
+// Appends raw bytes
+void ByteWriter::putBytes(const string& value) {
+    bytes += value;
+}
+
+// Appends an unsigned LEB128 varint
+void ByteWriter::putVarU(uint64_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<char>(value));
+}
+
+// Appends a signed value as a zigzag varint: 0, -1, 1, -2 ... become 0, 1, 2, 3 ...
+void ByteWriter::putVarI(int64_t value) {
+    putVarU((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Creates a reader over a byte range
+ByteReader::ByteReader(const char* data, size_t length) : bytes(data), size(length), pos(0), ok(true) {
+}
+
+// Creates a reader over a string, which must outlive the reader
+ByteReader::ByteReader(const string& data) : bytes(data.data()), size(data.size()), pos(0), ok(true) {
+}
+
+// Checks that count more bytes are available, failing the reader otherwise
+bool ByteReader::need(size_t count) {
+    if (!ok || size - pos < count) {
+        ok = false;
+        return false;
+    }
+    return true;
+}
+
+// Reads one byte
+bool ByteReader::getU8(uint8_t& value) {
+    if (!need(1)) return false;
+    value = static_cast<uint8_t>(bytes[pos++]);
+    return true;
+}
+
+// Reads a 32-bit unsigned little-endian value
+bool ByteReader::getU32(uint32_t& value) {
+    if (!need(4)) return false;
+    value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(bytes[pos++])) << (8 * i);
+    }
+    return true;
+}
+
+// Reads a 32-bit signed little-endian value
+bool ByteReader::getI32(int32_t& value) {
+    uint32_t bits;
+    if (!getU32(bits)) return false;
+    value = static_cast<int32_t>(bits);
+    return true;
+}
+
+// Reads a signed 64-bit field
+bool ByteReader::getI64(int64_t& value) {
+    uint32_t low, high;
+    if (!getU32(low) || !getU32(high)) return false;
+    value = static_cast<int64_t>((static_cast<uint64_t>(high) << 32) | low);
+    return true;
+}
+
+// Reads a length-prefixed string no longer than maxLength
+bool ByteReader::getString(string& value, size_t maxLength) {
+    uint32_t length;
+    if (!getU32(length)) return false;
+    if (length > maxLength) {
+        ok = false;
+        return false;
+    }
+    return getBytes(value, length);
+}
+
+// Reads an unsigned LEB128 varint of at most 10 bytes
+bool ByteReader::getVarU(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte;
+        if (!getU8(byte)) return false;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    ok = false;
+    return false;
+}
+
+// Reads a zigzag varint
+bool ByteReader::getVarI(int64_t& value) {
+    uint64_t bits;
+    if (!getVarU(bits)) return false;
+    value = static_cast<int64_t>(bits >> 1) ^ -static_cast<int64_t>(bits & 1);
+    return true;
+}
+
+// Skips count bytes
+bool ByteReader::skip(size_t count) {
+    if (!need(count)) return false;
+    pos += count;
+    return true;
+}
+
+// Reads count raw bytes
+bool ByteReader::getBytes(string& value, size_t count) {
+    if (!need(count)) return false;
+    value.assign(bytes + pos, count);
+    pos += count;
+    return true;
+}
+
+
+// Appends a varint field
+void FieldWriter::putInt(uint32_t tag, int64_t value) {
+    out.putVarU((static_cast<uint64_t>(tag) << 2) | WIRE_VARINT);
+    out.putVarI(value);
+}
+
+// Appends a fixed 32-bit field
+void FieldWriter::putFixed32(uint32_t tag, uint32_t value) {
+    out.putVarU((static_cast<uint64_t>(tag) << 2) | WIRE_FIXED32);
+    out.putU32(value);
+}
+
+// Appends a length-delimited field
+void FieldWriter::putBytes(uint32_t tag, const string& value) {
+    out.putVarU((static_cast<uint64_t>(tag) << 2) | WIRE_BYTES);
+    out.putVarU(value.size());
+    out.putBytes(value);
+}
+
+// Appends a nested field list
+void FieldWriter::putMessage(uint32_t tag, const FieldWriter& message) {
+    putBytes(tag, message.data());
+}
+
+// Creates a field reader over a byte range, which must outlive the reader
+FieldReader::FieldReader(const char* data, size_t length) : in(data, length) {
+}
+
+// Reads the next field
+// What it does: Reads the key, then the value of its wire type; length-delimited values are not
+//               copied, the field points at them
+// Inputs: field - Receives the field
+// Outputs: bool - True if a field was read
+bool FieldReader::next(Field& field) {
+    if (!in.good() || in.remaining() == 0) return false;
+    uint64_t key;
+    if (!in.getVarU(key) || (key >> 2) > 0xFFFFFFFFu) return false;
+    field.tag = static_cast<uint32_t>(key >> 2);
+    field.value = 0;
+    field.data = nullptr;
+    field.size = 0;
+    switch (key & 3) {
+        case WIRE_VARINT:
+            field.wire = WIRE_VARINT;
+            return in.getVarI(field.value);
+        case WIRE_FIXED32: {
+            uint32_t fixed;
+            field.wire = WIRE_FIXED32;
+            if (!in.getU32(fixed)) return false;
+            field.value = fixed;
+            return true;
+        }
+        case WIRE_BYTES: {
+            uint64_t length;
+            field.wire = WIRE_BYTES;
+            if (!in.getVarU(length) || length > in.remaining()) {
+                in.skip(in.remaining() + 1);  // Mark the reader failed
+                return false;
+            }
+            field.data = in.current();
+            field.size = static_cast<size_t>(length);
+            return in.skip(field.size);
+        }
+        default:
+            in.skip(in.remaining() + 1);
+            return false;
+    }
+}
+
+}
@@ -0,0 +1,161 @@
+#ifndef SAVECODEC_H
+#define SAVECODEC_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Building blocks of the sectioned save format: fixed little-endian fields, varints,
+ *        tagged fields, CRC32C and an in-tree LZ77 block compressor in the style of LZ4.
+ */
+namespace SaveCodec {
+
+/**
+ * @brief CRC32C (Castagnoli) of a byte range
+ * @param data Input: Bytes to checksum
+ * @param size Input: Number of bytes
+ * @return uint32_t: Checksum
+ */
+uint32_t crc32c(const char* data, size_t size);
+
+/**
+ * @brief CRC32C (Castagnoli) of a string
+ * @param bytes Input: Bytes to checksum
+ * @return uint32_t: Checksum
+ */
+uint32_t crc32c(const std::string& bytes);
+
+/**
+ * @brief Compress a block
+ * @details Sequences of (literal run, back-reference) as in LZ4: a token byte holds the literal
+ *          length and match length in its two nibbles (15 means more length bytes follow), then
+ *          the literals, then a 16-bit offset. Matches are found with a 4-byte hash table, so
+ *          compression is one pass and decompression is a plain copy loop.
+ * @param input Input: Bytes to compress
+ * @return std::string: Compressed block
+ */
+std::string compress(const std::string& input);
+
+/**
+ * @brief Decompress a block made by compress()
+ * @param input Input: Compressed block
+ * @param rawSize Input: Size of the original data
+ * @param output Output: Receives the original data
+ * @return bool: False if the block is malformed or does not decode to exactly rawSize bytes
+ */
+bool decompress(const std::string& input, size_t rawSize, std::string& output);
+
+/**
+ * @brief Appends fixed-size little-endian fields to a byte string
+ */
+class ByteWriter {
+private:
+    std::string bytes;
+
+public:
+    void putU8(uint8_t value);
+    void putU32(uint32_t value);
+    void putI32(int32_t value);
+    void putI64(int64_t value);
+    void putString(const std::string& value);  // u32 length, then the bytes
+    void putBytes(const std::string& value);   // Raw bytes, no length
+    void putVarU(uint64_t value);               // LEB128: 7 bits per byte, high bit = more
+    void putVarI(int64_t value);                // Zigzag, then LEB128, so small negatives stay short
+    const std::string& data() const { return bytes; }
+    std::string& data() { return bytes; }
+};
+
+/**
+ * @brief Reads fields written by ByteWriter; every read is bounds-checked and returns false
+ *        once the data runs out, after which all further reads fail too
+ */
+class ByteReader {
+private:
+    const char* bytes;
+    size_t size;
+    size_t pos;
+    bool ok;
+
+    bool need(size_t count);
+
+public:
+    ByteReader(const char* data, size_t length);
+    explicit ByteReader(const std::string& data);
+
+    bool getU8(uint8_t& value);
+    bool getU32(uint32_t& value);
+    bool getI32(int32_t& value);
+    bool getI64(int64_t& value);
+    bool getString(std::string& value, size_t maxLength);
+    bool getBytes(std::string& value, size_t count);
+    bool getVarU(uint64_t& value);
+    bool getVarI(int64_t& value);
+    bool skip(size_t count);
+    const char* current() const { return bytes + pos; }
+    bool good() const { return ok; }
+    size_t position() const { return pos; }
+    size_t remaining() const { return size - pos; }
+};
+
+/**
+ * @brief Wire types of tagged fields
+ */
+enum WireType {
+    WIRE_VARINT = 0,  // Zigzag varint
+    WIRE_FIXED32 = 1, // 4 bytes little-endian
+    WIRE_BYTES = 2    // Varint length, then the bytes (strings and nested field lists)
+};
+
+/**
+ * @brief Writes self-describing fields: each is a varint key (tag << 2 | wire type) and a value.
+ *        A reader that does not know a tag can still skip it, so fields can be added without a
+ *        new format version. Repeated fields are written by using the same tag again.
+ */
+class FieldWriter {
+private:
+    ByteWriter out;
+
+public:
+    void putInt(uint32_t tag, int64_t value);
+    void putFixed32(uint32_t tag, uint32_t value);
+    void putBytes(uint32_t tag, const std::string& value);
+    void putMessage(uint32_t tag, const FieldWriter& message);
+    const std::string& data() const { return out.data(); }
+};
+
+/**
+ * @brief One field read by FieldReader
+ */
+struct Field {
+    uint32_t tag;
+    WireType wire;
+    int64_t value;     // WIRE_VARINT and WIRE_FIXED32
+    const char* data;  // WIRE_BYTES: points into the reader's input
+    size_t size;
+
+    std::string text() const { return std::string(data, size); }
+};
+
+/**
+ * @brief Reads fields written by FieldWriter, in order
+ */
+class FieldReader {
+private:
+    ByteReader in;
+
+public:
+    FieldReader(const char* data, size_t length);
+
+    /**
+     * @brief Read the next field
+     * @param field Output: Receives the field
+     * @return bool: False at the end of the input or on malformed data (then good() is false)
+     */
+    bool next(Field& field);
+    bool good() const { return in.good(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,263 @@
+#include "SaveStore.h"
+#include "SaveCodec.h"
+#include <fstream>
+
+using namespace std;
+
+namespace {
+// Header page: "SAVESTOR", version, slot count, region size, CRC32C of the preceding fields
+const char STORE_MAGIC[] = "SAVESTOR";
+const int32_t STORE_VERSION = 1;
+const uint64_t STORE_PAGE = 4096;
+const size_t STORE_HEADER_FIELDS = 8 + 3 * 4;
+
+// Index copy: generation, one entry per slot, CRC32C of the preceding fields
+const size_t INDEX_ENTRY_SIZE = 32;
+const size_t INDEX_FIXED_SIZE = 4 + 4;  // Generation and CRC
+
+const uint32_t STORE_MAX_SLOTS = 65536;
+const uint32_t STORE_MAX_SLOT_SIZE = 64u << 20;
+
+// Reads part of a file
+// What it does: Reads up to size bytes at offset; fewer at the end of the file
+// Inputs: file - Open file
+//         offset - Byte offset to read at
+//         size - Bytes wanted
+// Outputs: string - The bytes read
+string readAt(ifstream& file, uint64_t offset, size_t size) {
+    string bytes(size, '\0');
+    file.clear();
+    file.seekg(static_cast<streamoff>(offset));
+    file.read(&bytes[0], static_cast<streamsize>(size));
+    bytes.resize(file.gcount() > 0 ? static_cast<size_t>(file.gcount()) : 0);
+    return bytes;
+}
+}
+
+// Creates an empty store
+// What it does: Sets the geometry used if no store file exists yet; every slot is empty
+// Inputs: count - Number of slots
+//         size - Bytes per slot region
+// Outputs: None (constructor)
+SaveStore::SaveStore(int count, uint32_t size)
+    : slotCount(static_cast<uint32_t>(count)), slotSize(size), generation(0), headerWritten(false),
+      entries(static_cast<size_t>(count), SlotEntry()) {
+}
+
+// Gets the size of one index copy
+// What it does: Rounds the generation, entries and CRC up to whole pages
+// Inputs: None
+// Outputs: uint64_t - Index copy size in bytes
+uint64_t SaveStore::indexSize() const {
+    uint64_t bytes = INDEX_FIXED_SIZE + static_cast<uint64_t>(slotCount) * INDEX_ENTRY_SIZE;
+    return (bytes + STORE_PAGE - 1) / STORE_PAGE * STORE_PAGE;
+}
+
+// Gets the offset of a slot region
+// What it does: Regions follow the header page and both index copies, two per slot
+// Inputs: slot - Slot number
+//         half - Region of the slot, 0 or 1
+// Outputs: uint64_t - Offset in the file
+uint64_t SaveStore::regionOffset(int slot, int half) const {
+    return STORE_PAGE + 2 * indexSize() + (static_cast<uint64_t>(slot) * 2 + half) * slotSize;
+}
+
+// Encodes the index
+// What it does: Writes the generation, every slot entry and a CRC32C, padded to indexSize()
+// Inputs: None
+// Outputs: string - One index copy
+string SaveStore::encodeIndex() const {
+    SaveCodec::ByteWriter index;
+    index.putU32(generation);
+    for (const SlotEntry& entry : entries) {
+        index.putU8(entry.used ? 1 : 0);
+        index.putU8(entry.half);
+        index.putU8(0);
+        index.putU8(0);
+        index.putI32(entry.day);
+        index.putI32(entry.hp);
+        index.putI32(entry.money);
+        index.putI32(entry.difficulty);
+        index.putI64(entry.timestamp);
+        index.putU32(entry.size);
+    }
+    index.putU32(SaveCodec::crc32c(index.data()));
+    index.data().resize(static_cast<size_t>(indexSize()), '\0');
+    return index.data();
+}
+
+// Decodes one index copy
+// What it does: Checks the CRC32C, then reads the generation and every slot entry
+// Inputs: data - Bytes of the copy
+//         size - Number of bytes
+//         copyGeneration - Receives the generation
+//         copyEntries - Receives the slot entries
+// Outputs: bool - True if the copy is intact and every entry fits a region
+bool SaveStore::decodeIndex(const char* data, size_t size, uint32_t& copyGeneration,
+                            vector<SlotEntry>& copyEntries) const {
+    size_t fields = 4 + slotCount * INDEX_ENTRY_SIZE;
+    uint32_t crc = 0;
+    SaveCodec::ByteReader trailer(data, size);
+    if (!trailer.skip(fields) || !trailer.getU32(crc) || crc != SaveCodec::crc32c(data, fields)) {
+        return false;
+    }
+
+    SaveCodec::ByteReader index(data, fields);
+    index.getU32(copyGeneration);
+    copyEntries.assign(slotCount, SlotEntry());
+    for (SlotEntry& entry : copyEntries) {
+        uint8_t used = 0, padding = 0;
+        index.getU8(used);
+        index.getU8(entry.half);
+        index.getU8(padding);
+        index.getU8(padding);
+        index.getI32(entry.day);
+        index.getI32(entry.hp);
+        index.getI32(entry.money);
+        index.getI32(entry.difficulty);
+        index.getI64(entry.timestamp);
+        index.getU32(entry.size);
+        entry.used = used != 0;
+        if (entry.half > 1 || entry.size > slotSize) return false;
+    }
+    return index.good();
+}
+
+// Reads the index of a store file
+// What it does: Reads the header page for the geometry, then both index copies, and keeps the
+//               intact copy with the higher generation. Slot regions are not read.
+// Inputs: path - Store file
+// Outputs: bool - True if an index was read; false leaves an empty store with the geometry given
+//                 to the constructor (or the file's, if only the index is missing)
+bool SaveStore::readIndex(const string& path) {
+    generation = 0;
+    headerWritten = false;
+    entries.assign(slotCount, SlotEntry());
+
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+
+    string header = readAt(file, 0, STORE_HEADER_FIELDS + 4);
+    SaveCodec::ByteReader reader(header);
+    string magic;
+    int32_t version = 0;
+    uint32_t count = 0, size = 0, crc = 0;
+    reader.getBytes(magic, 8);
+    reader.getI32(version);
+    reader.getU32(count);
+    reader.getU32(size);
+    if (!reader.getU32(crc) || crc != SaveCodec::crc32c(header.data(), STORE_HEADER_FIELDS) ||
+        magic != STORE_MAGIC || version != STORE_VERSION || count == 0 || count > STORE_MAX_SLOTS ||
+        size == 0 || size > STORE_MAX_SLOT_SIZE) {
+        return false;
+    }
+    slotCount = count;
+    slotSize = size;
+    headerWritten = true;
+    entries.assign(slotCount, SlotEntry());
+
+    bool found = false;
+    for (int copy = 0; copy < 2; copy++) {
+        string bytes = readAt(file, STORE_PAGE + copy * indexSize(), static_cast<size_t>(indexSize()));
+        uint32_t copyGeneration = 0;
+        vector<SlotEntry> copyEntries;
+        if (decodeIndex(bytes.data(), bytes.size(), copyGeneration, copyEntries) &&
+            copyGeneration % 2 == static_cast<uint32_t>(copy) && (!found || copyGeneration > generation)) {
+            generation = copyGeneration;
+            entries.swap(copyEntries);
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Lists the used slots
+// What it does: Copies the summary of every used slot from the index
+// Inputs: None
+// Outputs: vector<SlotInfo> - Used slots in slot order
+vector<SlotInfo> SaveStore::listSlots() const {
+    vector<SlotInfo> slots;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const SlotEntry& entry = entries[i];
+        if (!entry.used) continue;
+        SlotInfo info = { static_cast<int>(i), entry.day, entry.hp, entry.money, entry.difficulty,
+                          entry.timestamp };
+        slots.push_back(info);
+    }
+    return slots;
+}
+
+// Finds a slot's snapshot
+// What it does: Looks up the active region and size of a used slot
+// Inputs: slot - Slot number
+//         offset - Receives the snapshot's offset
+//         size - Receives the snapshot's size
+// Outputs: bool - False if the slot is out of range or empty
+bool SaveStore::locate(int slot, uint64_t& offset, uint32_t& size) const {
+    if (slot < 0 || slot >= static_cast<int>(slotCount) || !entries[slot].used) return false;
+    offset = regionOffset(slot, entries[slot].half);
+    size = entries[slot].size;
+    return true;
+}
+
+// Publishes the entries as the next generation
+// What it does: Adds the header page if the file has none yet, then the index copy that the
+//               current generation does not occupy
+// Inputs: writes - Receives the writes
+// Outputs: None
+void SaveStore::planIndex(vector<Write>& writes) {
+    if (!headerWritten) {
+        SaveCodec::ByteWriter header;
+        header.putBytes(string(STORE_MAGIC, 8));
+        header.putI32(STORE_VERSION);
+        header.putU32(slotCount);
+        header.putU32(slotSize);
+        header.putU32(SaveCodec::crc32c(header.data()));
+        Write page = { 0, header.data() };
+        writes.push_back(page);
+        headerWritten = true;
+    }
+    generation++;
+    Write index = { STORE_PAGE + (generation % 2) * indexSize(), encodeIndex() };
+    writes.push_back(index);
+}
+
+// Plans saving into a slot
+// What it does: Targets the region the slot's current snapshot is not in, so the old snapshot
+//               survives until the new index is written, then plans that index
+// Inputs: info - Slot number and summary
+//         snapshot - Snapshot bytes
+//         writes - Receives the data write and the index writes, in order
+// Outputs: bool - False if the slot is out of range or the snapshot does not fit a region
+bool SaveStore::planSave(const SlotInfo& info, const string& snapshot, vector<Write>& writes) {
+    if (info.slot < 0 || info.slot >= static_cast<int>(slotCount) || snapshot.size() > slotSize) {
+        return false;
+    }
+    SlotEntry& entry = entries[info.slot];
+    uint8_t half = entry.used ? static_cast<uint8_t>(1 - entry.half) : 0;
+    Write data = { regionOffset(info.slot, half), snapshot };
+    writes.push_back(data);
+
+    entry.used = true;
+    entry.half = half;
+    entry.day = info.day;
+    entry.hp = info.hp;
+    entry.money = info.money;
+    entry.difficulty = info.difficulty;
+    entry.timestamp = info.timestamp;
+    entry.size = static_cast<uint32_t>(snapshot.size());
+    planIndex(writes);
+    return true;
+}
+
+// Plans emptying a slot
+// What it does: Marks the slot unused and plans the new index; the region is left as it is
+// Inputs: slot - Slot number
+//         writes - Receives the index writes
+// Outputs: bool - False if the slot is out of range or already empty
+bool SaveStore::planDelete(int slot, vector<Write>& writes) {
+    if (slot < 0 || slot >= static_cast<int>(slotCount) || !entries[slot].used) return false;
+    entries[slot] = SlotEntry();
+    planIndex(writes);
+    return true;
+}
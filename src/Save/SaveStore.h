@@ -0,0 +1,158 @@
+#ifndef SAVESTORE_H
+#define SAVESTORE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Summary of one save slot, as listed in the store's index
+ */
+struct SlotInfo {
+    int slot;           // Slot number, 0-based
+    int day;
+    int hp;
+    int money;
+    int difficulty;
+    int64_t timestamp;  // Seconds since the epoch when the slot was written
+};
+
+/**
+ * @brief Layout of the multi-slot save store: an index page followed by fixed-size slot regions
+ * @details The file starts with a header page holding the geometry (slot count and region size),
+ *          written once, followed by two copies of the index (A and B), each padded to a page
+ *          multiple. An index holds a generation counter and one fixed-size entry per slot (used
+ *          flag, active half, day, HP, money, difficulty, timestamp, size), closed by a CRC32C.
+ *          Each slot owns two regions of slotSize bytes at fixed offsets after the index.
+ *          A save writes the slot's inactive region, then the index copy the current one does
+ *          not live in, with the next generation; the reader takes the valid copy with the
+ *          higher generation. A crash at any point therefore leaves the previous slot contents
+ *          and a valid index in place. Listing the slots reads only the index.
+ *          SaveStore does no writing itself: it returns (offset, bytes) writes for the caller
+ *          to queue in order.
+ */
+class SaveStore {
+public:
+    static const int DEFAULT_SLOT_COUNT = 256;
+    static const uint32_t DEFAULT_SLOT_SIZE = 64u << 10;
+
+    /**
+     * @brief An in-place write of the store file
+     */
+    struct Write {
+        uint64_t offset;
+        std::string bytes;
+    };
+
+private:
+    struct SlotEntry {
+        bool used;
+        uint8_t half;       // Region (0 or 1) holding the current snapshot
+        int32_t day;
+        int32_t hp;
+        int32_t money;
+        int32_t difficulty;
+        int64_t timestamp;
+        uint32_t size;      // Snapshot bytes in the active region
+    };
+
+    uint32_t slotCount;
+    uint32_t slotSize;
+    uint32_t generation;    // Generation of the index last read or planned
+    bool headerWritten;     // False until the header page is on disk (or planned)
+    std::vector<SlotEntry> entries;
+
+    /**
+     * @brief Bytes one index copy occupies, rounded up to whole pages
+     * @return uint64_t: Index copy size
+     */
+    uint64_t indexSize() const;
+
+    /**
+     * @brief Encode the index with the current generation
+     * @return std::string: One index copy, padded to indexSize()
+     */
+    std::string encodeIndex() const;
+
+    /**
+     * @brief Decode one index copy
+     * @param data Input: Bytes of the copy
+     * @param size Input: Number of bytes
+     * @param copyGeneration Output: Generation of the copy
+     * @param copyEntries Output: Slot entries of the copy
+     * @return bool: True if the copy is intact
+     */
+    bool decodeIndex(const char* data, size_t size, uint32_t& copyGeneration,
+                     std::vector<SlotEntry>& copyEntries) const;
+
+    /**
+     * @brief Byte offset of a slot region
+     * @param slot Input: Slot number
+     * @param half Input: Region of the slot, 0 or 1
+     * @return uint64_t: Offset in the file
+     */
+    uint64_t regionOffset(int slot, int half) const;
+
+    /**
+     * @brief Publish the current entries as the next generation
+     * @param writes Output: Receives the header page (first time only) and the index copy
+     * @return void
+     */
+    void planIndex(std::vector<Write>& writes);
+
+public:
+    /**
+     * @brief An empty store with the given geometry; geometry read from a file replaces it
+     * @param count Input: Number of slots
+     * @param size Input: Bytes per slot region
+     */
+    explicit SaveStore(int count = DEFAULT_SLOT_COUNT, uint32_t size = DEFAULT_SLOT_SIZE);
+
+    /**
+     * @brief Read the index of a store file
+     * @param path Input: Store file
+     * @return bool: True if an intact index was read; false leaves an empty store (missing file)
+     */
+    bool readIndex(const std::string& path);
+
+    /**
+     * @brief List the used slots, in slot order
+     * @return std::vector<SlotInfo>: One entry per used slot
+     */
+    std::vector<SlotInfo> listSlots() const;
+
+    /**
+     * @brief Number of slots in the store
+     * @return int: Slot count
+     */
+    int getSlotCount() const { return static_cast<int>(slotCount); }
+
+    /**
+     * @brief Find a slot's snapshot in the file
+     * @param slot Input: Slot number
+     * @param offset Output: Byte offset of the snapshot
+     * @param size Output: Snapshot size
+     * @return bool: False if the slot does not exist or is empty
+     */
+    bool locate(int slot, uint64_t& offset, uint32_t& size) const;
+
+    /**
+     * @brief Plan saving a snapshot into a slot and update the index in memory
+     * @param info Input: Slot number and summary to list
+     * @param snapshot Input: Snapshot bytes
+     * @param writes Output: Data write, then index write; queue them in this order
+     * @return bool: False if the slot does not exist or the snapshot is larger than a region
+     */
+    bool planSave(const SlotInfo& info, const std::string& snapshot, std::vector<Write>& writes);
+
+    /**
+     * @brief Plan emptying a slot and update the index in memory
+     * @param slot Input: Slot number
+     * @param writes Output: Index write
+     * @return bool: False if the slot does not exist or is already empty
+     */
+    bool planDelete(int slot, std::vector<Write>& writes);
+};
+
+#endif
@@ -1,24 +1,394 @@
 #include "SaveSystem.h"
+#include "../Core/UISystem.h"
+#include "../Core/GameSession.h"
+#include "SaveWriter.h"
+#include "SaveCodec.h"
+#include "SaveStore.h"
+#include "../Night/Market.h"
+#include "../Map/Map.h"
+#include "../Combat/CombatPlayer.h"
 #include <iostream>
 #include <fstream>
 #include <vector>
 #include <string>
 #include <map>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace std;
 
-string SaveSystem::saveFileName = "savegame.dat";
+// Creates the save state of a session
+// What it does: Points the session at the default save files with an empty journaled state; the
+//               writer thread is started by the first write
+// Inputs: None
+// Outputs: None (constructor)
+SaveSession::SaveSession()
+    : saveFileName("savegame.dat"), journalFileName("savegame.journal"), slotFileName("savegame.slots"),
+      compressSections(true), journalState{ false, 0, 0, 0, 0, map<string, int>(), 0, 0 } {
+}
+
+// Destroys the save state of a session
+// What it does: Lets the writer finish every queued write, then stops its thread
+// Inputs: None
+// Outputs: None (destructor)
+SaveSession::~SaveSession() {
+}
+
+// Returns the session's background writer
+// What it does: Starts the writer thread on first use
+// Inputs: None
+// Outputs: SaveWriter& - The writer
+SaveWriter& SaveSession::getWriter() {
+    if (!writer) {
+        writer.reset(new SaveWriter());
+    }
+    return *writer;
+}
+
+// Waits for the session's queued writes
+// What it does: Blocks until the writer has performed every write queued so far; returns at
+//               once if nothing was ever written
+// Inputs: None
+// Outputs: None
+void SaveSession::flushWrites() {
+    if (writer) {
+        writer->flush();
+    }
+}
+
+// Checks for a failed background write
+// What it does: Returns and clears the writer's failure flag
+// Inputs: None
+// Outputs: bool - True if a write failed since the last call
+bool SaveSession::takeWriteFailure() {
+    return writer && writer->takeFailure();
+}
+
+// Returns the save state of the current session
+// What it does: Looks up the session bound to this thread (see GameSession::current())
+// Inputs: None
+// Outputs: SaveSession& - Its save files, journaled state and writer
+SaveSession& SaveSystem::session() {
+    return GameSession::current().getSaveSession();
+}
+
+namespace {
+// Snapshot container: "SAVEGAME", version, section count, section table, table CRC, sections.
+// Versions 1 and 2 are the flat native-endian layout and are still read.
+const int SAVE_VERSION = 3;
+const int SAVE_FLAT_VERSION_MAX = 2;
+
+// Section ids. Unknown ids are skipped when loading, so later versions can add sections.
+enum SaveSection {
+    SECTION_STATE = 1,       // Day, HP, stamina, money; replaced by SECTION_GAME, still read
+    SECTION_INVENTORY = 2,   // Distinct item count, then (name, count) pairs; items without a prototype
+    SECTION_MARKET = 3,      // Market::serialize() output; absent without a market
+    SECTION_ITEM_RUNS = 4,   // Run count, then (prototype id, count) pairs
+    SECTION_GAME = 5,        // Tagged GameField values
+    SECTION_COMBAT = 6,      // Tagged CombatField values; absent without a combat player
+    SECTION_MAP = 7,         // Tagged MapField values; absent without a generated map
+    SECTION_WORN_ITEMS = 8   // Tagged ItemField values; items whose durability differs from the prototype
+};
+
+// Field tags of the tagged sections (SaveCodec::FieldWriter). Tags are never reused; unknown tags
+// are skipped, so fields can be added without changing SAVE_VERSION.
+enum GameField {
+    GAME_DAY = 1,
+    GAME_DIFFICULTY = 2,
+    GAME_HP = 3,
+    GAME_STAMINA = 4,
+    GAME_MONEY = 5
+};
+
+enum CombatField {
+    COMBAT_HEALTH = 1,
+    COMBAT_MAX_HEALTH = 2,
+    COMBAT_RESONANCE = 3,
+    COMBAT_DEFENSE = 4,
+    COMBAT_RUNE = 5,              // Repeated, in rune slot order
+    COMBAT_NOTE = 6,              // Repeated, in melody order
+    COMBAT_HARMONY = 7,
+    COMBAT_COMBO = 8,
+    COMBAT_EXTRA_TURNS = 9,
+    COMBAT_WEAPON_BONUS = 10,
+    COMBAT_WEAPON_NAME = 11,
+    COMBAT_WEAPON_NEEDS_AMMO = 12,
+    COMBAT_WEAPON_DURABILITY = 13
+};
+
+enum MapField {
+    MAP_DAY = 1,
+    MAP_LOCATION = 2,             // Repeated nested LocationField message, in menu order
+    LOCATION_PROTOTYPE = 1,
+    LOCATION_DANGER = 2,
+    LOCATION_COMPLETED = 3
+};
+
+enum ItemField {
+    ITEM_ENTRY = 1,               // Repeated nested message, one per item
+    ITEM_ID = 1,
+    ITEM_DURABILITY = 2
+};
+
+const uint8_t SECTION_COMPRESSED = 1;     // Section flag: stored with SaveCodec::compress()
+const size_t SECTION_COMPRESS_MIN = 64;   // Smaller sections are never worth compressing
+const uint32_t SECTION_MAX_COUNT = 64;
+const uint32_t SECTION_MAX_SIZE = 64u << 20;
+const size_t ITEM_NAME_MAX = 256;
+const size_t REPEATED_FIELD_MAX = 4096;   // Cap on repeated fields of one message when loading
+const int64_t INVENTORY_MAX_ITEMS = 100000;  // Cap on items a loaded inventory may hold; every item is allocated
+
+// A save file mapped read-only into memory; unmapped when it goes out of scope
+class MappedFile {
+private:
+    void* address;
+    size_t length;
+
+public:
+    MappedFile() : address(MAP_FAILED), length(0) {}
+    ~MappedFile() {
+        if (address != MAP_FAILED) munmap(address, length);
+    }
+
+    // Maps the whole file; false if it cannot be opened, is empty or cannot be mapped
+    bool open(const string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            length = static_cast<size_t>(info.st_size);
+            address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        return address != MAP_FAILED;
+    }
+
+    const char* data() const { return static_cast<const char*>(address); }
+    size_t size() const { return length; }
+};
+
+// Read-only istream over memory the caller keeps alive, for readers that take a stream
+class MemoryStreamBuf : public streambuf {
+public:
+    MemoryStreamBuf(const char* data, size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
 
-// Serializes player data to binary file
-// What it does: Writes player HP, stamina, and money to save file
-// Inputs: file - Output file stream
-//         player - Player object to serialize
+// A section's bytes: in place in the mapped file, or in a decompression buffer
+struct SectionView {
+    const char* data;
+    size_t size;
+};
+
+// Reads an int-valued tagged field
+// What it does: Accepts varint and fixed32 fields whose value fits in an int
+// Inputs: field - Field read by SaveCodec::FieldReader
+//         value - Receives the value
+// Outputs: bool - False if the field has the wrong wire type or is out of range
+bool fieldInt(const SaveCodec::Field& field, int& value) {
+    if (field.wire == SaveCodec::WIRE_BYTES || field.value < INT32_MIN || field.value > INT32_MAX) {
+        return false;
+    }
+    value = static_cast<int>(field.value);
+    return true;
+}
+
+// Parses SECTION_GAME
+// What it does: Reads the tagged game fields into the given variables; fields the section does not
+//               have keep their value
+// Inputs: view - Section bytes
+//         day, difficulty, hp, stamina, money - Receive the fields
+// Outputs: bool - False if the section is malformed
+bool parseGameSection(const SectionView& view, int& day, int& difficulty, int& hp, int& stamina, int& money) {
+    SaveCodec::FieldReader fields(view.data, view.size);
+    SaveCodec::Field field;
+    while (fields.next(field)) {
+        int* target = nullptr;
+        switch (field.tag) {
+            case GAME_DAY: target = &day; break;
+            case GAME_DIFFICULTY: target = &difficulty; break;
+            case GAME_HP: target = &hp; break;
+            case GAME_STAMINA: target = &stamina; break;
+            case GAME_MONEY: target = &money; break;
+            default: continue;  // Unknown field from a later version
+        }
+        if (!fieldInt(field, *target)) return false;
+    }
+    return fields.good();
+}
+
+// Parses SECTION_COMBAT
+// What it does: Reads the tagged combat fields into state; repeated rune and note fields are
+//               appended in order
+// Inputs: view - Section bytes
+//         state - Receives the fields
+// Outputs: bool - False if the section is malformed
+bool parseCombatSection(const SectionView& view, CombatPlayerState& state) {
+    SaveCodec::FieldReader fields(view.data, view.size);
+    SaveCodec::Field field;
+    while (fields.next(field)) {
+        int value = 0;
+        if (field.tag == COMBAT_WEAPON_NAME) {
+            if (field.wire != SaveCodec::WIRE_BYTES || field.size > ITEM_NAME_MAX) return false;
+            state.weaponName = field.text();
+            continue;
+        }
+        if (field.tag > COMBAT_WEAPON_DURABILITY) continue;  // Unknown field from a later version
+        if (!fieldInt(field, value)) return false;
+        switch (field.tag) {
+            case COMBAT_HEALTH: state.health = value; break;
+            case COMBAT_MAX_HEALTH: state.maxHealth = value; break;
+            case COMBAT_RESONANCE: state.resonance = value; break;
+            case COMBAT_DEFENSE: state.defense = value; break;
+            case COMBAT_RUNE:
+                if (state.runes.size() >= REPEATED_FIELD_MAX) return false;
+                state.runes.push_back(value);
+                break;
+            case COMBAT_NOTE:
+                if (state.melody.size() >= REPEATED_FIELD_MAX) return false;
+                state.melody.push_back(value);
+                break;
+            case COMBAT_HARMONY: state.harmony = value; break;
+            case COMBAT_COMBO: state.combo = value; break;
+            case COMBAT_EXTRA_TURNS: state.extraTurns = value; break;
+            case COMBAT_WEAPON_BONUS: state.weaponBonusDamage = value; break;
+            case COMBAT_WEAPON_NEEDS_AMMO: state.weaponNeedsAmmo = value != 0; break;
+            case COMBAT_WEAPON_DURABILITY: state.weaponDurability = value; break;
+            default: break;
+        }
+    }
+    return fields.good();
+}
+
+// Parses SECTION_MAP
+// What it does: Reads the map day and one nested message per daily location
+// Inputs: view - Section bytes
+//         state - Receives the map
+// Outputs: bool - False if the section is malformed
+bool parseMapSection(const SectionView& view, MapState& state) {
+    SaveCodec::FieldReader fields(view.data, view.size);
+    SaveCodec::Field field;
+    while (fields.next(field)) {
+        if (field.tag == MAP_DAY) {
+            if (!fieldInt(field, state.day)) return false;
+        } else if (field.tag == MAP_LOCATION) {
+            if (field.wire != SaveCodec::WIRE_BYTES || state.prototypes.size() >= REPEATED_FIELD_MAX) return false;
+            int prototype = -1, danger = 0, completed = 0;
+            SaveCodec::FieldReader location(field.data, field.size);
+            SaveCodec::Field locationField;
+            while (location.next(locationField)) {
+                int* target = nullptr;
+                switch (locationField.tag) {
+                    case LOCATION_PROTOTYPE: target = &prototype; break;
+                    case LOCATION_DANGER: target = &danger; break;
+                    case LOCATION_COMPLETED: target = &completed; break;
+                    default: continue;
+                }
+                if (!fieldInt(locationField, *target)) return false;
+            }
+            if (!location.good()) return false;
+            state.prototypes.push_back(prototype);
+            state.dangerLevels.push_back(danger);
+            state.completed.push_back(completed != 0);
+        }
+    }
+    return fields.good();
+}
+
+// Parses SECTION_WORN_ITEMS
+// What it does: Reads one (prototype id, durability) pair per item
+// Inputs: view - Section bytes
+//         items - Receives the pairs
+// Outputs: bool - False if the section is malformed or names an unknown prototype
+bool parseWornItemsSection(const SectionView& view, vector<pair<int, int> >& items) {
+    SaveCodec::FieldReader fields(view.data, view.size);
+    SaveCodec::Field field;
+    while (fields.next(field)) {
+        if (field.tag != ITEM_ENTRY) continue;
+        if (field.wire != SaveCodec::WIRE_BYTES || items.size() >= static_cast<size_t>(INVENTORY_MAX_ITEMS)) {
+            return false;
+        }
+        int id = -1, durability = 0;
+        SaveCodec::FieldReader entry(field.data, field.size);
+        SaveCodec::Field entryField;
+        while (entry.next(entryField)) {
+            if (entryField.tag == ITEM_ID) {
+                if (!fieldInt(entryField, id)) return false;
+            } else if (entryField.tag == ITEM_DURABILITY) {
+                if (!fieldInt(entryField, durability)) return false;
+            }
+        }
+        if (!entry.good() || getItemPrototype(id) == nullptr) return false;
+        items.push_back(make_pair(id, durability));
+    }
+    return fields.good();
+}
+
+// Journal record types. Each record is the type byte, its payload and a hash of both.
+enum JournalRecord {
+    JOURNAL_DAY = 1,      // int day delta
+    JOURNAL_HP = 2,       // int HP delta
+    JOURNAL_STAMINA = 3,  // int stamina delta
+    JOURNAL_MONEY = 4,    // int money delta
+    JOURNAL_ITEM = 5      // int name length, name, int count delta
+};
+
+const char JOURNAL_HEADER[] = "SAVEJRNL";
+const int JOURNAL_VERSION = 1;
+const int JOURNAL_HEADER_SIZE = 8 + sizeof(int) + sizeof(unsigned int);
+
+// Appends an int field to a record
+// What it does: Writes the raw bytes of value to the end of out
+// Inputs: out - Record being built
+//         value - Value to append
 // Outputs: None
-void SaveSystem::serializePlayer(ofstream& file, Player& player) {
-    // Simplified player serialization
-    file.write(reinterpret_cast<const char*>(&player.hp), sizeof(player.hp));
-    file.write(reinterpret_cast<const char*>(&player.stamina), sizeof(player.stamina));
-    file.write(reinterpret_cast<const char*>(&player.money), sizeof(player.money));
+void appendInt(string& out, int value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Reads an int field of a record
+// What it does: Copies sizeof(int) bytes at pos into value and moves pos past them
+// Inputs: in - Journal bytes
+//         pos - Read position, advanced on success
+//         value - Receives the value
+// Outputs: bool - False if the bytes run out
+bool takeInt(const string& in, size_t& pos, int& value) {
+    if (in.size() - pos < sizeof(value)) return false;
+    in.copy(reinterpret_cast<char*>(&value), sizeof(value), pos);
+    pos += sizeof(value);
+    return true;
+}
+
+// Converts planned store writes for the writer
+// What it does: Moves each write's bytes into an (offset, bytes) part, keeping the order
+// Inputs: writes - Writes planned by SaveStore, emptied
+// Outputs: vector<pair<uint64_t, string>> - Parts for SaveWriter::writeAt()
+vector<pair<uint64_t, string> > toPieces(vector<SaveStore::Write>& writes) {
+    vector<pair<uint64_t, string> > pieces;
+    for (SaveStore::Write& write : writes) {
+        pieces.push_back(make_pair(write.offset, string()));
+        pieces.back().second.swap(write.bytes);
+    }
+    return pieces;
+}
+
+// Makes a future that is already false
+// What it does: Used by saves that fail before anything is queued
+// Inputs: None
+// Outputs: future<bool> - Ready future holding false
+future<bool> failedSave() {
+    promise<bool> failed;
+    failed.set_value(false);
+    return failed.get_future();
+}
 }
 
 // Deserializes player data from binary file
@@ -26,7 +396,7 @@ void SaveSystem::serializePlayer(ofstream& file, Player& player) {
 // Inputs: file - Input file stream
 //         player - Player object to populate with loaded data
 // Outputs: bool - True if deserialization successful, false otherwise
-bool SaveSystem::deserializePlayer(ifstream& file, Player& player) {
+bool SaveSystem::deserializePlayer(istream& file, Player& player) {
     // Simplified player deserialization
     file.read(reinterpret_cast<char*>(&player.hp), sizeof(player.hp));
     file.read(reinterpret_cast<char*>(&player.stamina), sizeof(player.stamina));
@@ -35,44 +405,19 @@ bool SaveSystem::deserializePlayer(ifstream& file, Player& player) {
     return !file.fail();
 }
 
-// Serializes inventory data to binary file
-// What it does: Compresses inventory by counting items and writes to save file
-// Inputs: file - Output file stream
-//         inventory - Vector of item pointers to serialize
-// Outputs: None
-void SaveSystem::serializeInventory(ofstream& file, vector<Item*>& inventory) {
-    // Compress inventory: count of items with the same name
-    std::map<std::string, int> counts;
-    for (Item* item : inventory) {
-        if (!item) continue;
-        counts[item->name] += 1;
-    }
-
-    int distinct = static_cast<int>(counts.size());
-    file.write(reinterpret_cast<const char*>(&distinct), sizeof(distinct));
-
-    for (const auto& pair : counts) {
-        const std::string& name = pair.first;
-        int count = pair.second;
-        int nameLen = static_cast<int>(name.size());
-        file.write(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
-        file.write(name.c_str(), nameLen);
-        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
-    }
-}
-
 // Deserializes inventory data from binary file
-// What it does: Rebuilds inventory from compressed save data
+// What it does: Rebuilds inventory from the flat (version 1-2) name and count list
 // Inputs: file - Input file stream
 //         player - Player object to populate with loaded inventory
 // Outputs: bool - True if deserialization successful, false otherwise
-bool SaveSystem::deserializeInventory(ifstream& file, Player& player) {
-    // Clear existing inventory and rebuild items from name and count
-    player.clearInventory();
+bool SaveSystem::deserializeInventory(istream& file, Player& player) {
+    // Read every entry before touching the inventory, so a bad file leaves it as it was
+    vector<pair<string, int> > entries;
 
     int distinct = 0;
     file.read(reinterpret_cast<char*>(&distinct), sizeof(distinct));
     if (!file.good() || distinct < 0) return false;
+    int64_t total = 0;
 
     for (int i = 0; i < distinct; ++i) {
         int nameLen = 0;
@@ -85,126 +430,963 @@ bool SaveSystem::deserializeInventory(ifstream& file, Player& player) {
 
         int count = 0;
         file.read(reinterpret_cast<char*>(&count), sizeof(count));
-        if (!file.good() || count < 0) return false;
+        total += count;
+        if (!file.good() || count < 0 || total > INVENTORY_MAX_ITEMS) return false;
 
-        for (int j = 0; j < count; ++j) {
-            Item* item = createItem(name);
+        entries.push_back(make_pair(name, count));
+    }
+
+    // Rebuild items from name and count
+    player.clearInventory();
+    for (const auto& entry : entries) {
+        for (int j = 0; j < entry.second; ++j) {
+            Item* item = createItem(entry.first);
             if (item) {
                 player.addItem(item);
             }
         }
     }
+    return true;
+}
 
-    return !file.fail();
+// Deserializes the market section from binary file
+// What it does: Reads the presence flag and the market data; without a target market the data
+//               is read into a scratch Market so the rest of the file stays aligned
+// Inputs: file - Input file stream
+//         market - Market to populate, may be nullptr
+// Outputs: bool - True if deserialization successful, false otherwise
+bool SaveSystem::deserializeMarket(istream& file, Market* market) {
+    int hasMarket = 0;
+    file.read(reinterpret_cast<char*>(&hasMarket), sizeof(hasMarket));
+    if (!file.good()) return false;
+    if (!hasMarket) return true;
+
+    if (market) {
+        return market->deserialize(file);
+    }
+    Market scratch;
+    return scratch.deserialize(file);
+}
+
+// Counts the inventory by item name
+// What it does: Tallies how many items of each name the inventory holds. Items that match their
+//               prototype are counted by ID first, so the name map is only touched once per kind.
+// Inputs: inventory - Vector of item pointers to count
+// Outputs: map<string, int> - Number of items per name
+map<string, int> SaveSystem::countInventory(const vector<Item*>& inventory) {
+    map<string, int> counts;
+    map<int, int> byId;
+    const Item* lastPrototype = nullptr;
+    for (Item* item : inventory) {
+        if (!item) continue;
+        if (!lastPrototype || lastPrototype->id != item->id) {
+            lastPrototype = getItemPrototype(item->id);
+        }
+        if (lastPrototype && lastPrototype->name == item->name) {
+            byId[item->id] += 1;
+        } else {
+            counts[item->name] += 1;
+        }
+    }
+    for (const auto& pair : byId) {
+        counts[getItemPrototype(pair.first)->name] += pair.second;
+    }
+    return counts;
+}
+
+// Hashes a byte string
+// What it does: 32-bit FNV-1a over every byte; binds the journal to its snapshot and
+//               detects records torn by a crash
+// Inputs: bytes - Bytes to hash
+// Outputs: unsigned int - Hash value
+unsigned int SaveSystem::hashBytes(const string& bytes) {
+    return hashBytes(bytes.data(), bytes.size());
+}
+
+// Hashes a byte range
+// What it does: See hashBytes(const string&)
+// Inputs: data - Bytes to hash
+//         size - Number of bytes
+// Outputs: unsigned int - Hash value
+unsigned int SaveSystem::hashBytes(const char* data, size_t size) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Remembers the state the journal last recorded
+// What it does: Copies the player's stats, item counts and the day into journalState
+// Inputs: player - Player to remember
+//         day - Current day number
+//         snapshotHash - Hash of the snapshot on disk
+//         records - Journal records already applied to that snapshot
+// Outputs: None
+void SaveSystem::captureJournalState(const Player& player, int day, unsigned int snapshotHash, int records) {
+    SaveSession& saves = session();
+    saves.journalState.valid = true;
+    saves.journalState.day = day;
+    saves.journalState.hp = player.hp;
+    saves.journalState.stamina = player.stamina;
+    saves.journalState.money = player.money;
+    saves.journalState.items = countInventory(player.getInventory());
+    saves.journalState.snapshotHash = snapshotHash;
+    saves.journalState.records = records;
+}
+
+// Replaces the journal with one bound to a snapshot
+// What it does: Queues a new journal file: the header (with the snapshot hash) followed by the
+//               given records
+// Inputs: snapshotHash - Hash of the snapshot on disk
+//         records - Records to keep, empty for a fresh journal
+// Outputs: None
+void SaveSystem::resetJournal(unsigned int snapshotHash, const string& records) {
+    string journal(JOURNAL_HEADER, 8);
+    appendInt(journal, JOURNAL_VERSION);
+    journal.append(reinterpret_cast<const char*>(&snapshotHash), sizeof(snapshotHash));
+    journal += records;
+    SaveSession& saves = session();
+    saves.getWriter().replace(saves.journalFileName, move(journal));
+}
+
+// Encodes a snapshot
+// What it does: Builds each section, compresses it when that makes it smaller (and compress is
+//               set), then writes the header, the section table with each section's CRC32C, a
+//               CRC32C of header and table, and the sections. Game, combat, map and worn item
+//               sections are tagged fields; the others are fixed little-endian fields.
+// Inputs: player - Player object to save, with its combat player if it has one
+//         day - Current day number to save
+//         market - Market to save, may be nullptr
+//         dailyMap - Daily map to save, may be nullptr
+//         compress - Whether to try compressing sections
+// Outputs: string - Snapshot file content
+string SaveSystem::encodeSnapshot(const Player& player, int day, const Market* market, const Map* dailyMap, bool compress) {
+    vector<pair<uint32_t, string> > sections;
+
+    SaveCodec::FieldWriter game;
+    game.putInt(GAME_DAY, day);
+    game.putInt(GAME_DIFFICULTY, getGameDifficulty());
+    game.putInt(GAME_HP, player.hp);
+    game.putInt(GAME_STAMINA, player.stamina);
+    game.putInt(GAME_MONEY, player.money);
+    sections.push_back(make_pair(static_cast<uint32_t>(SECTION_GAME), game.data()));
+
+    // Compress inventory into (prototype id, count) runs; worn items keep their durability and
+    // items that do not match their prototype (none today) are kept by name
+    map<int, int> runs;
+    map<string, int> unmatched;
+    SaveCodec::FieldWriter worn;
+    for (Item* item : player.getInventory()) {
+        if (!item) continue;
+        const Item* prototype = getItemPrototype(item->id);
+        if (!prototype || prototype->name != item->name) {
+            unmatched[item->name] += 1;
+        } else if (item->durability == prototype->durability) {
+            runs[item->id] += 1;
+        } else {
+            SaveCodec::FieldWriter entry;
+            entry.putInt(ITEM_ID, item->id);
+            entry.putInt(ITEM_DURABILITY, item->durability);
+            worn.putMessage(ITEM_ENTRY, entry);
+        }
+    }
+    SaveCodec::ByteWriter itemRuns;
+    itemRuns.putU32(static_cast<uint32_t>(runs.size()));
+    for (const auto& run : runs) {
+        itemRuns.putU32(static_cast<uint32_t>(run.first));
+        itemRuns.putU32(static_cast<uint32_t>(run.second));
+    }
+    sections.push_back(make_pair(static_cast<uint32_t>(SECTION_ITEM_RUNS), itemRuns.data()));
+    if (!worn.data().empty()) {
+        sections.push_back(make_pair(static_cast<uint32_t>(SECTION_WORN_ITEMS), worn.data()));
+    }
+    if (!unmatched.empty()) {
+        SaveCodec::ByteWriter inventory;
+        inventory.putU32(static_cast<uint32_t>(unmatched.size()));
+        for (const auto& pair : unmatched) {
+            inventory.putString(pair.first);
+            inventory.putI32(pair.second);
+        }
+        sections.push_back(make_pair(static_cast<uint32_t>(SECTION_INVENTORY), inventory.data()));
+    }
+
+    if (market) {
+        ostringstream marketData(ios::binary);
+        market->serialize(marketData);
+        sections.push_back(make_pair(static_cast<uint32_t>(SECTION_MARKET), marketData.str()));
+    }
+
+    const CombatPlayer* combatPlayer = player.getCombatPlayer();
+    if (combatPlayer) {
+        CombatPlayerState state = combatPlayer->getState();
+        SaveCodec::FieldWriter combat;
+        combat.putInt(COMBAT_HEALTH, state.health);
+        combat.putInt(COMBAT_MAX_HEALTH, state.maxHealth);
+        combat.putInt(COMBAT_RESONANCE, state.resonance);
+        combat.putInt(COMBAT_DEFENSE, state.defense);
+        for (int rune : state.runes) {
+            combat.putInt(COMBAT_RUNE, rune);
+        }
+        for (int note : state.melody) {
+            combat.putInt(COMBAT_NOTE, note);
+        }
+        combat.putInt(COMBAT_HARMONY, state.harmony);
+        combat.putInt(COMBAT_COMBO, state.combo);
+        combat.putInt(COMBAT_EXTRA_TURNS, state.extraTurns);
+        combat.putInt(COMBAT_WEAPON_BONUS, state.weaponBonusDamage);
+        combat.putBytes(COMBAT_WEAPON_NAME, state.weaponName);
+        combat.putInt(COMBAT_WEAPON_NEEDS_AMMO, state.weaponNeedsAmmo ? 1 : 0);
+        combat.putInt(COMBAT_WEAPON_DURABILITY, state.weaponDurability);
+        sections.push_back(make_pair(static_cast<uint32_t>(SECTION_COMBAT), combat.data()));
+    }
+
+    if (dailyMap && dailyMap->getGeneratedDay() > 0) {
+        MapState state = dailyMap->getState();
+        SaveCodec::FieldWriter mapFields;
+        mapFields.putInt(MAP_DAY, state.day);
+        for (size_t i = 0; i < state.prototypes.size(); i++) {
+            SaveCodec::FieldWriter location;
+            location.putInt(LOCATION_PROTOTYPE, state.prototypes[i]);
+            location.putInt(LOCATION_DANGER, state.dangerLevels[i]);
+            location.putInt(LOCATION_COMPLETED, state.completed[i] ? 1 : 0);
+            mapFields.putMessage(MAP_LOCATION, location);
+        }
+        sections.push_back(make_pair(static_cast<uint32_t>(SECTION_MAP), mapFields.data()));
+    }
+
+    SaveCodec::ByteWriter file;
+    file.putBytes("SAVEGAME");
+    file.putI32(SAVE_VERSION);
+    file.putU32(static_cast<uint32_t>(sections.size()));
+    vector<string> stored(sections.size());
+    for (size_t i = 0; i < sections.size(); i++) {
+        const string& raw = sections[i].second;
+        uint8_t flags = 0;
+        stored[i] = raw;
+        if (compress && raw.size() >= SECTION_COMPRESS_MIN) {
+            string packed = SaveCodec::compress(raw);
+            if (packed.size() < raw.size()) {
+                stored[i].swap(packed);
+                flags = SECTION_COMPRESSED;
+            }
+        }
+        file.putU32(sections[i].first);
+        file.putU8(flags);
+        file.putU32(static_cast<uint32_t>(stored[i].size()));
+        file.putU32(static_cast<uint32_t>(raw.size()));
+        file.putU32(SaveCodec::crc32c(stored[i]));
+    }
+    file.putU32(SaveCodec::crc32c(file.data()));
+    for (const string& section : stored) {
+        file.putBytes(section);
+    }
+    return file.data();
+}
+
+// Decodes a version 3 snapshot
+// What it does: Checks the table CRC, then every section's bounds, CRC and decompressed size,
+//               and parses and checks the state, inventory, combat player and map, all before
+//               changing anything. Uncompressed sections are read where they lie in the mapped
+//               file. Only a fully valid file is applied; the inventory is rebuilt from
+//               (prototype id, count) runs.
+// Inputs: bytes - Snapshot file content
+//         size - Number of bytes
+//         player - Player object to populate
+//         day - Reference to store the day number
+//         market - Market to restore, may be nullptr
+//         dailyMap - Map to restore, may be nullptr
+// Outputs: bool - True if the snapshot was valid and applied
+bool SaveSystem::decodeSnapshot(const char* bytes, size_t size, Player& player, int& day, Market* market,
+                                Map* dailyMap) {
+    SaveCodec::ByteReader reader(bytes, size);
+    string magic;
+    int32_t version = 0;
+    uint32_t count = 0;
+    reader.getBytes(magic, 8);
+    reader.getI32(version);
+    reader.getU32(count);
+    if (!reader.good() || count > SECTION_MAX_COUNT) {
+        UISystem::out() << "Invalid save file format!" << endl;
+        return false;
+    }
+
+    struct SectionEntry {
+        uint32_t id;
+        uint8_t flags;
+        uint32_t storedSize;
+        uint32_t rawSize;
+        uint32_t crc;
+    };
+    vector<SectionEntry> table(count);
+    for (SectionEntry& entry : table) {
+        reader.getU32(entry.id);
+        reader.getU8(entry.flags);
+        reader.getU32(entry.storedSize);
+        reader.getU32(entry.rawSize);
+        reader.getU32(entry.crc);
+    }
+    size_t tableEnd = reader.position();
+    uint32_t tableCrc = 0;
+    if (!reader.getU32(tableCrc) || tableCrc != SaveCodec::crc32c(bytes, tableEnd)) {
+        UISystem::out() << "Save file is corrupted (bad section table)!" << endl;
+        return false;
+    }
+
+    map<uint32_t, SectionView> sections;
+    vector<string> decompressed;
+    decompressed.reserve(count);  // Views point into these buffers, so they must not move
+    size_t offset = reader.position();
+    uint64_t rawTotal = 0;  // Decompressed bytes of all sections together stay under one section's cap
+    for (const SectionEntry& entry : table) {
+        rawTotal += entry.rawSize;
+        if (entry.storedSize > size - offset || rawTotal > SECTION_MAX_SIZE ||
+            SaveCodec::crc32c(bytes + offset, entry.storedSize) != entry.crc) {
+            UISystem::out() << "Save file is corrupted (section " << entry.id << " checksum mismatch)!" << endl;
+            return false;
+        }
+        SectionView view = { bytes + offset, entry.storedSize };
+        if (entry.flags & SECTION_COMPRESSED) {
+            decompressed.push_back(string());
+            if (!SaveCodec::decompress(string(view.data, view.size), entry.rawSize, decompressed.back())) {
+                UISystem::out() << "Save file is corrupted (section " << entry.id << " does not decompress)!" << endl;
+                return false;
+            }
+            view.data = decompressed.back().data();
+            view.size = decompressed.back().size();
+        } else if (entry.storedSize != entry.rawSize) {
+            UISystem::out() << "Save file is corrupted (section " << entry.id << " size mismatch)!" << endl;
+            return false;
+        }
+        sections[entry.id] = view;
+        offset += entry.storedSize;
+    }
+    const SectionView empty = { bytes, 0 };
+    map<uint32_t, SectionView>::const_iterator found;
+
+    // Game state; version 3 files written before SECTION_GAME have SECTION_STATE instead
+    int loadedDay = 0, difficulty = getGameDifficulty(), hp = 0, stamina = 0, money = 0;
+    found = sections.find(SECTION_GAME);
+    if (found != sections.end()) {
+        if (!parseGameSection(found->second, loadedDay, difficulty, hp, stamina, money) ||
+            difficulty < DIFFICULTY_EASY || difficulty > DIFFICULTY_HARD) {
+            UISystem::out() << "Error loading player data!" << endl;
+            return false;
+        }
+    } else {
+        found = sections.find(SECTION_STATE);
+        const SectionView& stateView = found != sections.end() ? found->second : empty;
+        SaveCodec::ByteReader state(stateView.data, stateView.size);
+        int32_t fixed[4] = { 0, 0, 0, 0 };
+        for (int32_t& value : fixed) {
+            state.getI32(value);
+        }
+        if (!state.good()) {
+            UISystem::out() << "Error loading player data!" << endl;
+            return false;
+        }
+        loadedDay = fixed[0];
+        hp = fixed[1];
+        stamina = fixed[2];
+        money = fixed[3];
+    }
+
+    // Inventory: prototype runs, then items kept by name
+    vector<pair<int32_t, int32_t> > runs;
+    found = sections.find(SECTION_ITEM_RUNS);
+    const SectionView& runsView = found != sections.end() ? found->second : empty;
+    SaveCodec::ByteReader runReader(runsView.data, runsView.size);
+    uint32_t runCount = 0;
+    int64_t totalItems = 0;
+    bool inventoryValid = runsView.size == 0 || runReader.getU32(runCount);
+    for (uint32_t i = 0; inventoryValid && i < runCount; i++) {
+        uint32_t id = 0;
+        uint32_t itemCount = 0;
+        inventoryValid = runReader.getU32(id) && runReader.getU32(itemCount) &&
+                         (totalItems += itemCount) <= INVENTORY_MAX_ITEMS &&
+                         getItemPrototype(static_cast<int>(id)) != nullptr;
+        if (inventoryValid) {
+            runs.push_back(make_pair(static_cast<int32_t>(id), static_cast<int32_t>(itemCount)));
+        }
+    }
+
+    vector<pair<string, int32_t> > named;
+    found = sections.find(SECTION_INVENTORY);
+    const SectionView& namedView = found != sections.end() ? found->second : empty;
+    SaveCodec::ByteReader nameReader(namedView.data, namedView.size);
+    uint32_t distinct = 0;
+    inventoryValid = inventoryValid && (namedView.size == 0 || nameReader.getU32(distinct));
+    for (uint32_t i = 0; inventoryValid && i < distinct; i++) {
+        string name;
+        int32_t itemCount = 0;
+        inventoryValid = nameReader.getString(name, ITEM_NAME_MAX) && nameReader.getI32(itemCount) &&
+                         !name.empty() && itemCount >= 0 && (totalItems += itemCount) <= INVENTORY_MAX_ITEMS;
+        if (inventoryValid) {
+            named.push_back(make_pair(name, itemCount));
+        }
+    }
+    vector<pair<int, int> > worn;
+    found = sections.find(SECTION_WORN_ITEMS);
+    inventoryValid = inventoryValid && (found == sections.end() || parseWornItemsSection(found->second, worn)) &&
+                     totalItems + static_cast<int64_t>(worn.size()) <= INVENTORY_MAX_ITEMS;
+    if (!inventoryValid) {
+        UISystem::out() << "Error loading inventory data!" << endl;
+        return false;
+    }
+
+    // Combat player and map: checked here, applied with everything else below
+    CombatPlayerState combatState = CombatPlayerState();
+    found = sections.find(SECTION_COMBAT);
+    bool hasCombat = found != sections.end();
+    if (hasCombat && (!parseCombatSection(found->second, combatState) ||
+                      !CombatPlayer::isValidState(combatState))) {
+        UISystem::out() << "Error loading combat data!" << endl;
+        return false;
+    }
+    MapState mapState = MapState();
+    found = sections.find(SECTION_MAP);
+    bool hasMap = dailyMap && found != sections.end();
+    if (hasMap && (!parseMapSection(found->second, mapState) || !dailyMap->isValidState(mapState))) {
+        UISystem::out() << "Error loading map data!" << endl;
+        return false;
+    }
+
+    // Market: restore only when both the file and the caller have one
+    found = sections.find(SECTION_MARKET);
+    if (market && found != sections.end()) {
+        MemoryStreamBuf marketBuffer(found->second.data, found->second.size);
+        istream marketData(&marketBuffer);
+        if (!market->deserialize(marketData)) {
+            UISystem::out() << "Error loading market data!" << endl;
+            return false;
+        }
+    }
+
+    if (hasMap) {
+        dailyMap->restoreState(mapState);
+    }
+    if (hasCombat) {
+        if (!player.getCombatPlayer()) {
+            player.initializeCombatPlayer("Player");
+        }
+        player.getCombatPlayer()->restoreState(combatState);
+    }
+
+    setGameDifficulty(difficulty);
+    day = loadedDay;
+    player.hp = hp;
+    player.stamina = stamina;
+    player.money = money;
+    player.clearInventory();
+    for (const auto& run : runs) {
+        player.addItems(run.first, run.second);
+    }
+    for (const auto& entry : worn) {
+        Item* item = createItemFromPrototype(entry.first);
+        item->durability = entry.second;
+        player.addItem(item);
+    }
+    for (const auto& entry : named) {
+        for (int32_t j = 0; j < entry.second; ++j) {
+            Item* item = createItem(entry.first);
+            if (item) {
+                player.addItem(item);
+            }
+        }
+    }
+    return true;
+}
+
+// Loads a flat (version 1-2) snapshot
+// What it does: Reads day, player, inventory and (version 2) market in file order
+// Inputs: file - Stream positioned after the version field
+//         version - File version
+//         player - Player object to populate
+//         day - Reference to store the day number
+//         market - Market to restore, may be nullptr
+// Outputs: bool - True if load successful, false otherwise
+bool SaveSystem::loadFlatSnapshot(istream& file, int version, Player& player, int& day, Market* market) {
+    // Read day count
+    file.read(reinterpret_cast<char*>(&day), sizeof(day));
+
+    // Deserialize player
+    if (!deserializePlayer(file, player)) {
+        UISystem::out() << "Error loading player data!" << endl;
+        return false;
+    }
+
+    // Deserialize inventory
+    if (!deserializeInventory(file, player)) {
+        UISystem::out() << "Error loading inventory data!" << endl;
+        return false;
+    }
+
+    // Deserialize market
+    if (version >= 2 && !deserializeMarket(file, market)) {
+        UISystem::out() << "Error loading market data!" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Turns section compression on or off
+// What it does: Sets whether encodeSnapshot() tries to compress sections
+// Inputs: enabled - True to compress sections that shrink
+// Outputs: None
+void SaveSystem::setCompression(bool enabled) {
+    session().compressSections = enabled;
+}
+
+// Moves the save files
+// What it does: Lets queued writes finish, then points the save file, journal and slot store
+//               at basePath with their usual extensions
+// Inputs: basePath - Path without extension
+// Outputs: None
+void SaveSystem::setSavePath(const string& basePath) {
+    SaveSession& saves = session();
+    saves.flushWrites();
+    discardJournalState();
+    saves.saveFileName = basePath + ".dat";
+    saves.journalFileName = basePath + ".journal";
+    saves.slotFileName = basePath + ".slots";
+}
+
+// Writes a full snapshot
+// What it does: Encodes the snapshot (see encodeSnapshot()) on the game thread, then queues the file and an empty journal bound to the new
+//               snapshot's hash on the background writer. If the program dies between the two
+//               writes, the old journal no longer matches and is ignored.
+// Inputs: player - Player object to save
+//         day - Current day number to save
+//         market - Market to save, may be nullptr
+//         dailyMap - Daily map to save, may be nullptr
+// Outputs: future<bool> - True once the snapshot is on disk, false if writing it failed
+future<bool> SaveSystem::writeSnapshot(const Player& player, int day, const Market* market, const Map* dailyMap) {
+    SaveSession& saves = session();
+    string snapshot = encodeSnapshot(player, day, market, dailyMap, saves.compressSections);
+    unsigned int hash = hashBytes(snapshot);
+    future<bool> written = saves.getWriter().replace(saves.saveFileName, move(snapshot));
+    resetJournal(hash);
+    captureJournalState(player, day, hash, 0);
+    return written;
 }
 
 // Saves game state to file
-// What it does: Writes player data, inventory, and day to save file
+// What it does: Queues a full snapshot of player data, inventory, day and market state and
+//               empties the journal. Returns at once; the write happens in the background.
+// Inputs: player - Player object to save
+//         day - Current day number to save
+//         market - Market to save, may be nullptr
+//         dailyMap - Daily map to save, may be nullptr
+// Outputs: future<bool> - True once the save is on disk, false if it failed
+future<bool> SaveSystem::saveGame(const Player& player, int day, const Market* market, const Map* dailyMap) {
+    try {
+        return writeSnapshot(player, day, market, dailyMap);
+    } catch (const exception& e) {
+        UISystem::out() << "Error saving game: " << e.what() << endl;
+        return failedSave();
+    }
+}
+
+// Autosaves by appending to the journal
+// What it does: Compares the game with journalState and queues one append holding a record per
+//               changed value. Writes a full snapshot instead if there is none to append to, the
+//               journal has reached JOURNAL_COMPACT_RECORDS records or a background write failed.
 // Inputs: player - Player object to save
 //         day - Current day number to save
+//         market - Market to save with a snapshot, may be nullptr
+//         dailyMap - Daily map to save with a snapshot, may be nullptr
 // Outputs: None
-void SaveSystem::saveGame(Player& player, int day) {
-    ofstream file(saveFileName, ios::binary);
+void SaveSystem::journalGame(const Player& player, int day, const Market* market, const Map* dailyMap) {
+    SaveSession& saves = session();
+    try {
+        // A failed background write may have lost records; start over from a snapshot
+        if (saves.takeWriteFailure()) {
+            saves.journalState.valid = false;
+        }
+        if (!saves.journalState.valid || saves.journalState.records >= JOURNAL_COMPACT_RECORDS) {
+            writeSnapshot(player, day, market, dailyMap);
+            return;
+        }
+
+        string records;
+        int count = 0;
+        const int deltas[4][2] = {
+            { JOURNAL_DAY, day - saves.journalState.day },
+            { JOURNAL_HP, player.hp - saves.journalState.hp },
+            { JOURNAL_STAMINA, player.stamina - saves.journalState.stamina },
+            { JOURNAL_MONEY, player.money - saves.journalState.money }
+        };
+        for (const auto& delta : deltas) {
+            if (delta[1] == 0) continue;
+            string record(1, static_cast<char>(delta[0]));
+            appendInt(record, delta[1]);
+            appendInt(record, static_cast<int>(hashBytes(record)));
+            records += record;
+            count++;
+        }
 
-    if (!file.is_open()) {
-        cerr << "Error: Cannot open save file for writing!" << endl;
-        return;
+        // Items that changed count, including ones that are gone now
+        map<string, int> items = countInventory(player.getInventory());
+        map<string, int> changes;
+        for (const auto& pair : items) {
+            changes[pair.first] += pair.second;
+        }
+        for (const auto& pair : saves.journalState.items) {
+            changes[pair.first] -= pair.second;
+        }
+        for (const auto& pair : changes) {
+            if (pair.second == 0) continue;
+            string record(1, static_cast<char>(JOURNAL_ITEM));
+            appendInt(record, static_cast<int>(pair.first.size()));
+            record += pair.first;
+            appendInt(record, pair.second);
+            appendInt(record, static_cast<int>(hashBytes(record)));
+            records += record;
+            count++;
+        }
+        if (count == 0) return;
+
+        saves.getWriter().append(saves.journalFileName, move(records));
+
+        saves.journalState.day = day;
+        saves.journalState.hp = player.hp;
+        saves.journalState.stamina = player.stamina;
+        saves.journalState.money = player.money;
+        saves.journalState.items.swap(items);
+        saves.journalState.records += count;
+    } catch (const exception& e) {
+        UISystem::out() << "Error saving game: " << e.what() << endl;
     }
+}
 
-    try {
-        // Write file header identifier
-        const char* header = "SAVEGAME";
-        file.write(header, 8);
+// Forgets the journaled state
+// What it does: Marks journalState invalid so the next autosave writes a snapshot
+// Inputs: None
+// Outputs: None
+void SaveSystem::discardJournalState() {
+    SaveSession& saves = session();
+    saves.journalState.valid = false;
+    saves.journalState.items.clear();
+    saves.journalState.records = 0;
+}
 
-        // Write version number
-        int version = 1;
-        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+// Replays the journal onto a loaded snapshot
+// What it does: Applies records in order until the end of the journal or the first record that is
+//               cut short or fails its hash (the write a crash interrupted). A journal written for
+//               another snapshot is ignored. The journal is then rewritten to hold only the
+//               records that were applied, so later appends follow valid data.
+// Inputs: player - Player to apply the records to
+//         day - Day number to apply the records to
+//         snapshotHash - Hash of the loaded snapshot
+// Outputs: int - Number of records applied
+int SaveSystem::replayJournal(Player& player, int& day, unsigned int snapshotHash) {
+    session().flushWrites();
+    ifstream journal(session().journalFileName, ios::binary);
+    string bytes;
+    if (journal.is_open()) {
+        ostringstream content;
+        content << journal.rdbuf();
+        bytes = content.str();
+    }
 
-        // Write day count
-        file.write(reinterpret_cast<const char*>(&day), sizeof(day));
+    int version = 0;
+    unsigned int boundHash = 0;
+    size_t pos = 8;
+    if (bytes.size() < static_cast<size_t>(JOURNAL_HEADER_SIZE) || bytes.compare(0, 8, JOURNAL_HEADER) != 0 ||
+        !takeInt(bytes, pos, version) || version != JOURNAL_VERSION) {
+        resetJournal(snapshotHash);
+        return 0;
+    }
+    bytes.copy(reinterpret_cast<char*>(&boundHash), sizeof(boundHash), pos);
+    pos += sizeof(boundHash);
+    if (boundHash != snapshotHash) {
+        resetJournal(snapshotHash);
+        return 0;
+    }
 
-        // Serialize player
-        serializePlayer(file, player);
+    const size_t recordsStart = pos;
+    size_t validEnd = pos;
+    int applied = 0;
+    while (pos < bytes.size()) {
+        size_t recordStart = pos;
+        int type = static_cast<unsigned char>(bytes[pos++]);
+        int nameLen = 0;
+        string name;
+        int value = 0;
+        int hash = 0;
+        if (type == JOURNAL_ITEM) {
+            if (!takeInt(bytes, pos, nameLen) || nameLen <= 0 || nameLen > 256 ||
+                bytes.size() - pos < static_cast<size_t>(nameLen)) break;
+            name = bytes.substr(pos, nameLen);
+            pos += nameLen;
+        } else if (type < JOURNAL_DAY || type > JOURNAL_MONEY) {
+            break;
+        }
+        if (!takeInt(bytes, pos, value)) break;
+        size_t recordEnd = pos;
+        if (!takeInt(bytes, pos, hash) ||
+            static_cast<unsigned int>(hash) != hashBytes(bytes.substr(recordStart, recordEnd - recordStart))) break;
 
-        // Serialize inventory
-        serializeInventory(file, player.getInventory());
+        // A record that would overflow a counter or grow the inventory past the load cap is corrupt
+        int64_t before = type == JOURNAL_DAY ? day : type == JOURNAL_HP ? player.hp :
+                         type == JOURNAL_STAMINA ? player.stamina : type == JOURNAL_MONEY ? player.money :
+                         static_cast<int64_t>(player.getInventory().size());
+        int64_t after = before + value;
+        if (after < INT32_MIN || after > INT32_MAX ||
+            (type == JOURNAL_ITEM && (value == INT32_MIN || after > INVENTORY_MAX_ITEMS))) break;
 
-        file.close();
-        cout << "Game saved successfully!" << endl;
-    } catch (const exception& e) {
-        cerr << "Error saving game: " << e.what() << endl;
+        switch (type) {
+            case JOURNAL_DAY: day += value; break;
+            case JOURNAL_HP: player.hp += value; break;
+            case JOURNAL_STAMINA: player.stamina += value; break;
+            case JOURNAL_MONEY: player.money += value; break;
+            case JOURNAL_ITEM:
+                if (value > 0) {
+                    for (int i = 0; i < value; ++i) {
+                        Item* item = createItem(name);
+                        if (item) {
+                            player.addItem(item);
+                        }
+                    }
+                } else {
+                    player.removeItem(name, -value);
+                }
+                break;
+        }
+        applied++;
+        validEnd = pos;
     }
+
+    if (validEnd < bytes.size()) {
+        // Drop the torn tail
+        resetJournal(snapshotHash, bytes.substr(recordsStart, validEnd - recordsStart));
+    }
+    return applied;
 }
 
 // Loads game state from file
-// What it does: Reads player data, inventory, and day from save file
+// What it does: Maps the save file into memory and decodes the snapshot in place, then replays
+//               the journal written since. Version 1 files have no market section and leave the
+//               market untouched.
 // Inputs: player - Player object to populate with loaded data
 //         day - Reference to store loaded day number
+//         market - Market to restore, may be nullptr
+//         dailyMap - Map to restore, may be nullptr
 // Outputs: bool - True if load successful, false otherwise
-bool SaveSystem::loadGame(Player& player, int& day) {
-    ifstream file(saveFileName, ios::binary);
+bool SaveSystem::loadGame(Player& player, int& day, Market* market, Map* dailyMap) {
+    // Read what the queued saves wrote, not what was there before them
+    session().flushWrites();
+    MappedFile snapshot;
 
-    if (!file.is_open()) {
-        cout << "No save file found!" << endl;
+    if (!snapshot.open(session().saveFileName)) {
+        UISystem::out() << "No save file found!" << endl;
         return false;
     }
 
     try {
         // Verify file header
-        char header[9];
-        file.read(header, 8);
-        header[8] = '\0';
-
-        if (string(header) != "SAVEGAME") {
-            cout << "Invalid save file format!" << endl;
+        SaveCodec::ByteReader header(snapshot.data(), snapshot.size());
+        string magic;
+        int32_t version = 0;
+        if (!header.getBytes(magic, 8) || magic != "SAVEGAME") {
+            UISystem::out() << "Invalid save file format!" << endl;
             return false;
         }
 
         // Read version number
-        int version;
-        file.read(reinterpret_cast<char*>(&version), sizeof(version));
-
-        // Read day count
-        file.read(reinterpret_cast<char*>(&day), sizeof(day));
-
-        // Deserialize player
-        if (!deserializePlayer(file, player)) {
-            cout << "Error loading player data!" << endl;
+        if (!header.getI32(version) || version < 1 || version > SAVE_VERSION) {
+            UISystem::out() << "Unsupported save file version!" << endl;
             return false;
         }
 
-        // Deserialize inventory
-        if (!deserializeInventory(file, player)) {
-            cout << "Error loading inventory data!" << endl;
+        if (version <= SAVE_FLAT_VERSION_MAX) {
+            MemoryStreamBuf buffer(snapshot.data() + header.position(), header.remaining());
+            istream file(&buffer);
+            if (!loadFlatSnapshot(file, version, player, day, market)) return false;
+        } else if (!decodeSnapshot(snapshot.data(), snapshot.size(), player, day, market, dailyMap)) {
             return false;
         }
 
-        file.close();
-        cout << "Game loaded successfully!" << endl;
+        // Recover the autosaves made after the snapshot
+        unsigned int hash = hashBytes(snapshot.data(), snapshot.size());
+        int replayed = replayJournal(player, day, hash);
+        captureJournalState(player, day, hash, replayed);
+
+        UISystem::out() << "Game loaded successfully!" << endl;
+        if (replayed > 0) {
+            UISystem::out() << "Recovered " << replayed << " autosave record(s)." << endl;
+        }
+        return true;
+    } catch (const exception& e) {
+        UISystem::out() << "Error loading game: " << e.what() << endl;
+        return false;
+    }
+}
+
+// Captures the game state in memory
+// What it does: Encodes an uncompressed snapshot; no file or journal is touched
+// Inputs: player - Player to capture, with its combat player if it has one
+//         day - Current day number
+//         market - Market to capture, may be nullptr
+//         dailyMap - Daily map to capture, may be nullptr
+// Outputs: string - The snapshot
+string SaveSystem::captureSnapshot(const Player& player, int day, const Market* market, const Map* dailyMap) {
+    return encodeSnapshot(player, day, market, dailyMap, false);
+}
+
+// Restores a captured game state
+// What it does: Decodes a snapshot made by captureSnapshot() (or read from a version 3 save)
+// Inputs: snapshot - Snapshot to restore
+//         player - Player to restore
+//         day - Reference to store the day number
+//         market - Market to restore, may be nullptr
+//         dailyMap - Map to restore, may be nullptr
+// Outputs: bool - True if the snapshot was valid and applied, false (nothing changed) otherwise
+bool SaveSystem::restoreSnapshot(const string& snapshot, Player& player, int& day, Market* market, Map* dailyMap) {
+    SaveCodec::ByteReader header(snapshot);
+    string magic;
+    int32_t version = 0;
+    if (!header.getBytes(magic, 8) || magic != "SAVEGAME" || !header.getI32(version) || version != SAVE_VERSION) {
+        UISystem::out() << "Invalid snapshot!" << endl;
+        return false;
+    }
+    return decodeSnapshot(snapshot.data(), snapshot.size(), player, day, market, dailyMap);
+}
+
+// Saves into a slot
+// What it does: Reads the store index (after earlier queued writes), encodes a snapshot, and
+//               queues its write to the slot's spare region followed by the new index as one job,
+//               so the index is only written once the snapshot is on disk
+// Inputs: slot - Slot number
+//         player - Player object to save
+//         day - Current day number to save
+//         market - Market to save, may be nullptr
+//         dailyMap - Daily map to save, may be nullptr
+// Outputs: future<bool> - True once the slot is on disk, false if it failed
+future<bool> SaveSystem::saveToSlot(int slot, const Player& player, int day, const Market* market, const Map* dailyMap) {
+    SaveSession& saves = session();
+    try {
+        saves.flushWrites();
+        SaveStore& store = saves.slotStore;
+        store.readIndex(saves.slotFileName);
+        if (slot < 0 || slot >= store.getSlotCount()) {
+            UISystem::out() << "No such save slot!" << endl;
+            return failedSave();
+        }
+
+        string snapshot = encodeSnapshot(player, day, market, dailyMap, saves.compressSections);
+        SlotInfo info = { slot, day, player.hp, player.money, getGameDifficulty(),
+                          static_cast<int64_t>(time(nullptr)) };
+        vector<SaveStore::Write> writes;
+        if (!store.planSave(info, snapshot, writes)) {
+            UISystem::out() << "Save is too large for a slot!" << endl;
+            return failedSave();
+        }
+        return saves.getWriter().writeAt(saves.slotFileName, toPieces(writes));
+    } catch (const exception& e) {
+        UISystem::out() << "Error saving game: " << e.what() << endl;
+        return failedSave();
+    }
+}
+
+// Loads from a slot
+// What it does: Reads the store index, maps the store file and decodes the slot's snapshot in
+//               place. Slots have no journal; the next autosave writes a fresh save file.
+// Inputs: slot - Slot number
+//         player - Player object to populate
+//         day - Reference to store the day number
+//         market - Market to restore, may be nullptr
+//         dailyMap - Map to restore, may be nullptr
+// Outputs: bool - True if load successful, false otherwise
+bool SaveSystem::loadFromSlot(int slot, Player& player, int& day, Market* market, Map* dailyMap) {
+    SaveSession& saves = session();
+    saves.flushWrites();
+    SaveStore& store = saves.slotStore;
+    uint64_t offset = 0;
+    uint32_t size = 0;
+    MappedFile file;
+    if (!store.readIndex(saves.slotFileName) || !store.locate(slot, offset, size)) {
+        UISystem::out() << "Save slot is empty!" << endl;
+        return false;
+    }
+    if (!file.open(saves.slotFileName) || offset > file.size() || size > file.size() - offset) {
+        UISystem::out() << "Save slot is corrupted!" << endl;
+        return false;
+    }
+
+    try {
+        if (!decodeSnapshot(file.data() + offset, size, player, day, market, dailyMap)) {
+            return false;
+        }
+        // The journal belongs to the save file's game; the next autosave starts a snapshot
+        discardJournalState();
+        UISystem::out() << "Game loaded successfully!" << endl;
         return true;
     } catch (const exception& e) {
-        cerr << "Error loading game: " << e.what() << endl;
+        UISystem::out() << "Error loading game: " << e.what() << endl;
         return false;
     }
 }
 
+// Lists the used slots
+// What it does: Reads the header page and index of the store, not the slots
+// Inputs: None
+// Outputs: vector<SlotInfo> - Used slots in slot order
+vector<SlotInfo> SaveSystem::listSlots() {
+    SaveSession& saves = session();
+    saves.flushWrites();
+    saves.slotStore.readIndex(saves.slotFileName);
+    return saves.slotStore.listSlots();
+}
+
+// Gets the number of slots
+// What it does: Reads the store geometry (the default for a new store)
+// Inputs: None
+// Outputs: int - Slot count
+int SaveSystem::getSlotCount() {
+    SaveSession& saves = session();
+    saves.flushWrites();
+    saves.slotStore.readIndex(saves.slotFileName);
+    return saves.slotStore.getSlotCount();
+}
+
+// Empties a slot
+// What it does: Queues an index without the slot and waits for it
+// Inputs: slot - Slot number
+// Outputs: bool - True if the slot was emptied
+bool SaveSystem::deleteSlot(int slot) {
+    SaveSession& saves = session();
+    saves.flushWrites();
+    SaveStore& store = saves.slotStore;
+    store.readIndex(saves.slotFileName);
+    vector<SaveStore::Write> writes;
+    if (!store.planDelete(slot, writes)) return false;
+    return saves.getWriter().writeAt(saves.slotFileName, toPieces(writes)).get();
+}
+
 // Checks if save file exists
 // What it does: Verifies whether the save file exists on disk
 // Inputs: None
 // Outputs: bool - True if save file exists, false otherwise
 bool SaveSystem::saveExists() {
-    ifstream file(saveFileName);
+    session().flushWrites();
+    ifstream file(session().saveFileName);
     return file.good();
 }
 
 // Deletes save file from disk
-// What it does: Removes the save file if it exists
+// What it does: Removes the save file and its journal if they exist
 // Inputs: None
 // Outputs: None
 void SaveSystem::deleteSave() {
-    if (remove(saveFileName.c_str()) == 0) {
-        cout << "Save file deleted!" << endl;
+    SaveSession& saves = session();
+    saves.flushWrites();
+    remove(saves.journalFileName.c_str());
+    discardJournalState();
+    if (remove(saves.saveFileName.c_str()) == 0) {
+        UISystem::out() << "Save file deleted!" << endl;
     } else {
-        cout << "No save file to delete!" << endl;
+        UISystem::out() << "No save file to delete!" << endl;
     }
 }
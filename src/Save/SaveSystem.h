@@ -6,69 +6,347 @@
 #include "../Item/item.h"
 #include "../Item/itemdatabase.h"
 #include "../Core/Config.h"
+#include "SaveStore.h"
 #include <string>
 #include <fstream>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
 #include <vector>
 
-// MarketTrends struct - defined in Market.h
+class Market;      // Defined in Night/Market.h
+class Map;         // Defined in Map/Map.h
+class SaveWriter;  // Defined in SaveWriter.h
 
-class SaveSystem {
+/**
+ * @brief Save files, journaled state and background writer of one game session
+ * @details Every GameSession owns one, so games running on different threads save to their own
+ *          files and never share a journal or a writer. Only SaveSystem reads and changes it;
+ *          SaveSystem's functions work on the SaveSession of GameSession::current().
+ */
+class SaveSession {
 private:
-    static std::string saveFileName;  // Static save file name
+    friend class SaveSystem;
+
+    std::string saveFileName;     // Snapshot file
+    std::string journalFileName;  // Delta records appended since the last snapshot
+    std::string slotFileName;     // Multi-slot store (see SaveStore)
+    bool compressSections;        // Whether snapshots compress their sections
+
+    // What the journal last recorded; new records are the difference to this state
+    struct JournalState {
+        bool valid;                        // False until a snapshot was written or loaded
+        int day;
+        int hp;
+        int stamina;
+        int money;
+        std::map<std::string, int> items;  // Item count by name
+        unsigned int snapshotHash;         // Hash of the snapshot the journal applies to
+        int records;                       // Records appended since that snapshot
+    };
+    JournalState journalState;
+
+    SaveStore slotStore;                 // Slot store index; callers read it from disk first
+    std::unique_ptr<SaveWriter> writer;  // Started by the first write
+
+    /**
+     * @brief Background writer of this session, started on first use
+     * @return SaveWriter&: The writer
+     */
+    SaveWriter& getWriter();
 
-    // Internal serialization methods
     /**
-     * @brief Serialize player data to file
-     * @param file Input: Output file stream to write to
-     * @param player Input: Player object to serialize
+     * @brief Wait until every write queued so far is done
      * @return void
      */
-    static void serializePlayer(std::ofstream& file, Player& player);     
+    void flushWrites();
+
+    /**
+     * @brief Check for and clear a failed background write
+     * @return bool: True if a write failed since the last call
+     */
+    bool takeWriteFailure();
+
+public:
+    /**
+     * @brief Create a session saving to "savegame.dat", "savegame.journal" and "savegame.slots"
+     */
+    SaveSession();
 
+    /**
+     * @brief Finish every queued write of the session
+     */
+    ~SaveSession();
+
+    SaveSession(const SaveSession&) = delete;
+    SaveSession& operator=(const SaveSession&) = delete;
+};
+
+class SaveSystem {
+private:
+    /**
+     * @brief Save state of the current game session
+     * @return SaveSession&: GameSession::current()'s save state
+     */
+    static SaveSession& session();
+
+    // Readers for the flat version 1-2 format
     /**
      * @brief Deserialize player data from file
      * @param file Input: Input file stream to read from
      * @param player Output: Player object to populate with deserialized data
      * @return bool: True if deserialization succeeded, false otherwise
      */
-    static bool deserializePlayer(std::ifstream& file, Player& player);  
+    static bool deserializePlayer(std::istream& file, Player& player);  
     
-    // Inventory serialization
     /**
-     * @brief Serialize inventory data to file
-     * @param file Input: Output file stream to write to
-     * @param inventory Input: Inventory vector to serialize
-     * @return void
+     * @brief Deserialize inventory data from file
+     * @param file Input: Input file stream to read from
+     * @param player Output: Player object to populate with deserialized inventory
+     * @return bool: True if deserialization succeeded, false otherwise
      */
-    static void serializeInventory(std::ofstream& file, std::vector<Item*>& inventory);     
+    static bool deserializeInventory(std::istream& file, Player& player);                  
 
     /**
-     * @brief Deserialize inventory data from file
+     * @brief Deserialize the market section (presence flag, then trends and history)
      * @param file Input: Input file stream to read from
-     * @param player Output: Player object to populate with deserialized inventory
+     * @param market Output: Market to populate, nullptr to skip the section
      * @return bool: True if deserialization succeeded, false otherwise
      */
-    static bool deserializeInventory(std::ifstream& file, Player& player);                  
+    static bool deserializeMarket(std::istream& file, Market* market);
+
+    // Snapshot and journal
+    /**
+     * @brief Encode a version 3 snapshot: header, section table with CRC32C per section, sections
+     * @param player Input: Player object to save, with its combat state if it has one
+     * @param day Input: Current game day to save
+     * @param market Input: Market to save, nullptr to save none
+     * @param dailyMap Input: Daily map to save, nullptr to save none
+     * @param compress Input: True to compress sections when that makes them smaller
+     * @return std::string: Snapshot file content
+     */
+    static std::string encodeSnapshot(const Player& player, int day, const Market* market, const Map* dailyMap, bool compress);
+
+    /**
+     * @brief Validate and apply a version 3 snapshot; nothing is changed unless every check passes
+     * @param bytes Input: Snapshot file content, typically the mapped file
+     * @param size Input: Number of bytes
+     * @param player Output: Player object to populate
+     * @param day Output: Variable to store loaded game day
+     * @param market Output: Market to restore, nullptr to ignore it
+     * @param dailyMap Output: Daily map to restore, nullptr to ignore it
+     * @return bool: True if the snapshot was valid and applied
+     */
+    static bool decodeSnapshot(const char* bytes, size_t size, Player& player, int& day, Market* market, Map* dailyMap);
+
+    /**
+     * @brief Load a flat version 1-2 snapshot
+     * @param file Input: Stream positioned after the version field
+     * @param version Input: File version
+     * @param player Output: Player object to populate
+     * @param day Output: Variable to store loaded game day
+     * @param market Output: Market to restore, nullptr to ignore it
+     * @return bool: True if load succeeded, false otherwise
+     */
+    static bool loadFlatSnapshot(std::istream& file, int version, Player& player, int& day, Market* market);
+
+    /**
+     * @brief Serialize a full snapshot and queue it, followed by an empty journal for it
+     * @param player Input: Player object to save
+     * @param day Input: Current game day to save
+     * @param market Input: Market to save, nullptr to save none
+     * @param dailyMap Input: Daily map to save, nullptr to save none
+     * @return std::future<bool>: True once the snapshot is on disk, false if writing it failed
+     */
+    static std::future<bool> writeSnapshot(const Player& player, int day, const Market* market, const Map* dailyMap);
+
+    /**
+     * @brief Count the inventory by item name
+     * @param inventory Input: Inventory vector to count
+     * @return std::map<std::string, int>: Number of items per name
+     */
+    static std::map<std::string, int> countInventory(const std::vector<Item*>& inventory);
+
+    /**
+     * @brief Hash a byte string (32-bit FNV-1a)
+     * @param bytes Input: Bytes to hash
+     * @return unsigned int: Hash value
+     */
+    static unsigned int hashBytes(const std::string& bytes);
+
+    /**
+     * @brief Hash a byte range (32-bit FNV-1a)
+     * @param data Input: Bytes to hash
+     * @param size Input: Number of bytes
+     * @return unsigned int: Hash value
+     */
+    static unsigned int hashBytes(const char* data, size_t size);
+
+    /**
+     * @brief Remember the given state as the one the journal last recorded
+     * @param player Input: Player whose stats and inventory are remembered
+     * @param day Input: Current game day
+     * @param snapshotHash Input: Hash of the snapshot on disk
+     * @param records Input: Number of journal records already applied to that snapshot
+     * @return void
+     */
+    static void captureJournalState(const Player& player, int day, unsigned int snapshotHash, int records);
+
+    /**
+     * @brief Queue a journal bound to a snapshot, replacing the current one
+     * @param snapshotHash Input: Hash of the snapshot on disk
+     * @param records Input: Records to keep after the header, empty for a fresh journal
+     * @return void
+     */
+    static void resetJournal(unsigned int snapshotHash, const std::string& records = std::string());
 
-    // MarketTrends serialization - temporarily removed
+    /**
+     * @brief Apply the journal records that belong to the loaded snapshot
+     * @param player Output: Player to apply the records to
+     * @param day Output: Game day to apply the records to
+     * @param snapshotHash Input: Hash of the loaded snapshot
+     * @return int: Number of records applied
+     */
+    static int replayJournal(Player& player, int& day, unsigned int snapshotHash);
 
 public:
     /**
      * @brief Save current game state to file
+     * @details The state is serialized on the calling thread and written by a background thread
+     *          to a temp file that is fsync'd and renamed over the save, so a crash never leaves
+     *          a torn save. Wait on the result before exiting to report success.
      * @param player Input: Player object to save
      * @param day Input: Current game day to save
-     * @return void
+     * @param market Input: Market whose trends and history are saved, nullptr to save none
+     * @param dailyMap Input: Daily map whose locations are saved, nullptr to save none
+     * @return std::future<bool>: True once the save is on disk, false if writing it failed
      */
-    static void saveGame(Player& player, int day);
+    static std::future<bool> saveGame(const Player& player, int day, const Market* market = nullptr,
+                                      const Map* dailyMap = nullptr);
 
     /**
      * @brief Load game state from file
      * @param player Output: Player object to populate with loaded data
      * @param day Output: Variable to store loaded game day
+     * @param market Output: Market to restore trends and history into, nullptr to ignore them
+     * @param dailyMap Output: Map to restore the daily locations into, nullptr to ignore them
      * @return bool: True if load succeeded, false otherwise
      */
-    static bool loadGame(Player& player, int& day);
+    static bool loadGame(Player& player, int& day, Market* market = nullptr, Map* dailyMap = nullptr);
+
+    /**
+     * @brief Capture the whole game state in memory, for rollback and simulation checkpoints
+     * @details Same encoding as a save file but uncompressed; nothing is written to disk and the
+     *          journal is not touched, so this is cheap enough to call every turn.
+     * @param player Input: Player to capture, with its combat state if it has one
+     * @param day Input: Current game day
+     * @param market Input: Market to capture, nullptr to capture none
+     * @param dailyMap Input: Daily map to capture, nullptr to capture none
+     * @return std::string: The snapshot
+     */
+    static std::string captureSnapshot(const Player& player, int day, const Market* market = nullptr,
+                                       const Map* dailyMap = nullptr);
+
+    /**
+     * @brief Restore a state made by captureSnapshot(); nothing is changed unless it is valid
+     * @param snapshot Input: Snapshot to restore
+     * @param player Output: Player to restore
+     * @param day Output: Variable to store the game day
+     * @param market Output: Market to restore, nullptr to ignore it
+     * @param dailyMap Output: Map to restore, nullptr to ignore it
+     * @return bool: True if the snapshot was valid and applied
+     */
+    static bool restoreSnapshot(const std::string& snapshot, Player& player, int& day,
+                                Market* market = nullptr, Map* dailyMap = nullptr);
+
+    /// Journal records after which journalGame() writes a full snapshot instead
+    static const int JOURNAL_COMPACT_RECORDS = 256;
+
+    /**
+     * @brief Autosave by appending what changed since the last save to the journal
+     * @details Money, HP, stamina and day changes and per-item inventory changes are appended as
+     *          small checksummed records. A full snapshot is written instead when no snapshot
+     *          exists yet in this session or after JOURNAL_COMPACT_RECORDS records. The market, map
+     *          and combat state are only saved with snapshots.
+     * @param player Input: Player object to save
+     * @param day Input: Current game day to save
+     * @param market Input: Market to save with a snapshot, nullptr to save none
+     * @param dailyMap Input: Daily map to save with a snapshot, nullptr to save none
+     * @return void
+     */
+    static void journalGame(const Player& player, int day, const Market* market = nullptr, const Map* dailyMap = nullptr);
+
+    /**
+     * @brief Turn compression of snapshot sections on or off (on by default)
+     * @param enabled Input: True to compress sections when that makes them smaller
+     * @return void
+     */
+    static void setCompression(bool enabled);
+
+    /**
+     * @brief Move the current session's save files to "<basePath>.dat", "<basePath>.journal"
+     *        and "<basePath>.slots"
+     * @details Waits for queued writes to the old files and forgets the journaled state. Games
+     *          that run at the same time need different paths.
+     * @param basePath Input: Path without extension; "savegame" is the default
+     * @return void
+     */
+    static void setSavePath(const std::string& basePath);
+
+    /**
+     * @brief Forget the journaled state, so the next journalGame() writes a snapshot
+     * @return void
+     */
+    static void discardJournalState();
     
+    /**
+     * @brief Save the game into a slot of the slot store
+     * @details Slot saves are independent of the save file and its journal. The snapshot goes
+     *          into the slot's spare region and the index is rewritten after it, in the background,
+     *          so a crash keeps the slot's previous save.
+     * @param slot Input: Slot number, 0 to getSlotCount() - 1
+     * @param player Input: Player object to save
+     * @param day Input: Current game day to save
+     * @param market Input: Market to save, nullptr to save none
+     * @param dailyMap Input: Daily map to save, nullptr to save none
+     * @return std::future<bool>: True once the slot is on disk, false if the slot is invalid, the
+     *         save does not fit a slot or writing failed
+     */
+    static std::future<bool> saveToSlot(int slot, const Player& player, int day, const Market* market = nullptr,
+                                        const Map* dailyMap = nullptr);
+
+    /**
+     * @brief Load the game from a slot of the slot store
+     * @param slot Input: Slot number
+     * @param player Output: Player object to populate
+     * @param day Output: Variable to store loaded game day
+     * @param market Output: Market to restore, nullptr to ignore it
+     * @param dailyMap Output: Map to restore, nullptr to ignore it
+     * @return bool: True if load succeeded, false (nothing changed) otherwise
+     */
+    static bool loadFromSlot(int slot, Player& player, int& day, Market* market = nullptr,
+                             Map* dailyMap = nullptr);
+
+    /**
+     * @brief List the used slots by reading only the store's index
+     * @return std::vector<SlotInfo>: Day, HP, money, difficulty and time of each used slot
+     */
+    static std::vector<SlotInfo> listSlots();
+
+    /**
+     * @brief Number of slots in the slot store
+     * @return int: Slot count
+     */
+    static int getSlotCount();
+
+    /**
+     * @brief Empty a slot of the slot store
+     * @param slot Input: Slot number
+     * @return bool: False if the slot is invalid or already empty
+     */
+    static bool deleteSlot(int slot);
+
     /**
      * @brief Check if save file exists
      * @return bool: True if save file exists, false otherwise
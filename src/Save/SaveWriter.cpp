@@ -0,0 +1,223 @@
+#include "SaveWriter.h"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+// Writes a whole buffer to a file descriptor
+// What it does: Calls write() until every byte is written, retrying on EINTR
+// Inputs: fd - Open file descriptor
+//         bytes - Data to write
+// Outputs: bool - True if every byte was written
+bool writeAll(int fd, const string& bytes) {
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Flushes a directory entry to disk
+// What it does: fsyncs the directory holding path so a rename into it survives a crash
+// Inputs: path - File whose directory to sync
+// Outputs: None
+void syncDirectory(const string& path) {
+    size_t slash = path.find_last_of('/');
+    string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
+}
+
+// Starts the writer thread
+// What it does: Initializes the queue state, then starts run() on its own thread
+// Inputs: None
+// Outputs: None
+SaveWriter::SaveWriter() : stopping(false), failed(false), worker(&SaveWriter::run, this) {
+}
+
+// Stops the writer thread
+// What it does: Lets the thread finish every queued job, then joins it
+// Inputs: None
+// Outputs: None
+SaveWriter::~SaveWriter() {
+    {
+        lock_guard<mutex> lock(jobsMutex);
+        stopping = true;
+    }
+    jobsReady.notify_one();
+    worker.join();
+}
+
+// Queues a job
+// What it does: Appends the job to the queue and wakes the writer thread
+// Inputs: kind - What to do
+//         path - File to write
+//         bytes - Data to write
+// Outputs: future<bool> - Result of the job
+future<bool> SaveWriter::enqueue(JobKind kind, const string& path, string bytes) {
+    Job job;
+    job.kind = kind;
+    job.path = path;
+    job.bytes.swap(bytes);
+    return enqueue(move(job));
+}
+
+// Queues a prepared job
+// What it does: Appends the job to the queue and wakes the writer thread
+// Inputs: job - Job to run
+// Outputs: future<bool> - Result of the job
+future<bool> SaveWriter::enqueue(Job job) {
+    future<bool> result = job.done.get_future();
+    {
+        lock_guard<mutex> lock(jobsMutex);
+        jobs.push_back(move(job));
+    }
+    jobsReady.notify_one();
+    return result;
+}
+
+// Writer thread loop
+// What it does: Takes jobs in order and performs them; exits once stopping with an empty queue
+// Inputs: None
+// Outputs: None
+void SaveWriter::run() {
+    while (true) {
+        Job job;
+        {
+            unique_lock<mutex> lock(jobsMutex);
+            jobsReady.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return;
+            job = move(jobs.front());
+            jobs.pop_front();
+        }
+
+        bool ok = true;
+        if (job.kind == JOB_REPLACE) {
+            ok = replaceFile(job.path, job.bytes);
+        } else if (job.kind == JOB_APPEND) {
+            ok = appendFile(job.path, job.bytes);
+        } else if (job.kind == JOB_WRITE_AT) {
+            ok = writeFileAt(job.path, job.pieces);
+        }
+        if (!ok) failed = true;
+        job.done.set_value(ok);
+    }
+}
+
+// Replaces a file atomically
+// What it does: Writes "<path>.tmp", fsyncs it, renames it over path and fsyncs the directory.
+//               Readers see the old or the new content, never a mix.
+// Inputs: path - File to replace
+//         bytes - New file content
+// Outputs: bool - True on success
+bool SaveWriter::replaceFile(const string& path, const string& bytes) {
+    const string temp = path + ".tmp";
+    int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool ok = writeAll(fd, bytes) && ::fsync(fd) == 0;
+    ok = (::close(fd) == 0) && ok;
+    if (!ok || ::rename(temp.c_str(), path.c_str()) != 0) {
+        ::unlink(temp.c_str());
+        return false;
+    }
+    syncDirectory(path);
+    return true;
+}
+
+// Appends to a file
+// What it does: Opens path for appending (creating it if needed), writes and fdatasyncs
+// Inputs: path - File to append to
+//         bytes - Data to append
+// Outputs: bool - True on success
+bool SaveWriter::appendFile(const string& path, const string& bytes) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+    bool ok = writeAll(fd, bytes) && ::fdatasync(fd) == 0;
+    return (::close(fd) == 0) && ok;
+}
+
+// Overwrites parts of a file
+// What it does: Opens path (creating it if needed), then writes each part at its offset with
+//               pwrite() and fdatasyncs before the next; stops at the first failure. Writing past
+//               the end grows the file; the gap reads as zeros.
+// Inputs: path - File to write
+//         pieces - (offset, bytes) parts in order
+// Outputs: bool - True on success
+bool SaveWriter::writeFileAt(const string& path, const vector<pair<uint64_t, string> >& pieces) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fd < 0) return false;
+    bool ok = true;
+    for (size_t i = 0; ok && i < pieces.size(); i++) {
+        const string& bytes = pieces[i].second;
+        size_t written = 0;
+        while (ok && written < bytes.size()) {
+            ssize_t n = ::pwrite(fd, bytes.data() + written, bytes.size() - written,
+                                 static_cast<off_t>(pieces[i].first + written));
+            if (n < 0) {
+                ok = errno == EINTR;
+            } else {
+                written += static_cast<size_t>(n);
+            }
+        }
+        ok = ok && ::fdatasync(fd) == 0;
+    }
+    return (::close(fd) == 0) && ok;
+}
+
+// Queues a whole-file replacement
+// What it does: See replaceFile(); the write happens on the writer thread
+// Inputs: path - File to replace
+//         bytes - New file content
+// Outputs: future<bool> - True once written
+future<bool> SaveWriter::replace(const string& path, string bytes) {
+    return enqueue(JOB_REPLACE, path, move(bytes));
+}
+
+// Queues an append
+// What it does: See appendFile(); the write happens on the writer thread
+// Inputs: path - File to append to
+//         bytes - Data to append
+// Outputs: future<bool> - True once written
+future<bool> SaveWriter::append(const string& path, string bytes) {
+    return enqueue(JOB_APPEND, path, move(bytes));
+}
+
+// Queues in-place writes
+// What it does: See writeFileAt(); the writes happen on the writer thread
+// Inputs: path - File to write
+//         pieces - (offset, bytes) parts in order
+// Outputs: future<bool> - True once written
+future<bool> SaveWriter::writeAt(const string& path, vector<pair<uint64_t, string> > pieces) {
+    Job job;
+    job.kind = JOB_WRITE_AT;
+    job.path = path;
+    job.pieces.swap(pieces);
+    return enqueue(move(job));
+}
+
+// Waits for the queue to drain
+// What it does: Queues a barrier and waits for it, so every earlier write has finished
+// Inputs: None
+// Outputs: None
+void SaveWriter::flush() {
+    enqueue(JOB_BARRIER, string(), string()).wait();
+}
+
+// Reports and clears a write failure
+// What it does: Returns whether any write failed since the last call
+// Inputs: None
+// Outputs: bool - True if a write failed
+bool SaveWriter::takeFailure() {
+    return failed.exchange(false);
+}
@@ -0,0 +1,137 @@
+#ifndef SAVEWRITER_H
+#define SAVEWRITER_H
+
+#include <string>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+/**
+ * @brief Background thread that performs every save file write
+ * @details The game thread serializes into a buffer and queues it; the writer thread does the
+ *          disk I/O in queue order, so a journal reset queued after a snapshot never lands
+ *          before it. Whole-file writes go to "<path>.tmp", are fsync'd and then renamed over
+ *          the old file, so a crash leaves either the old or the new file, never a torn one.
+ *          The destructor finishes every queued write before returning, which covers exit().
+ */
+class SaveWriter {
+private:
+    enum JobKind {
+        JOB_REPLACE,   // Write bytes to a temp file, fsync, rename over path
+        JOB_APPEND,    // Append bytes to path and fsync
+        JOB_WRITE_AT,  // Write pieces at their offsets of path in order, fsync after each
+        JOB_BARRIER    // Nothing to write; completes once every earlier job has
+    };
+
+    struct Job {
+        JobKind kind;
+        std::string path;
+        std::string bytes;
+        std::vector<std::pair<uint64_t, std::string> > pieces;  // JOB_WRITE_AT: (offset, bytes)
+        std::promise<bool> done;
+    };
+
+    std::deque<Job> jobs;
+    std::mutex jobsMutex;
+    std::condition_variable jobsReady;
+    bool stopping;
+    std::atomic<bool> failed;
+    std::thread worker;  // Declared last so it starts after the other members exist
+
+    /**
+     * @brief Queue a job for the writer thread
+     * @param kind Input: What to do
+     * @param path Input: File to write
+     * @param bytes Input: Data to write, moved into the job
+     * @return std::future<bool>: Becomes true once the job succeeded, false if it failed
+     */
+    std::future<bool> enqueue(JobKind kind, const std::string& path, std::string bytes);
+
+    /**
+     * @brief Queue a prepared job for the writer thread
+     * @param job Input: Job to run, moved into the queue
+     * @return std::future<bool>: Becomes true once the job succeeded, false if it failed
+     */
+    std::future<bool> enqueue(Job job);
+
+    /**
+     * @brief Writer thread loop: runs jobs in order until stopping and the queue is empty
+     * @return void
+     */
+    void run();
+
+    /**
+     * @brief Replace a file atomically (temp file, fsync, rename, fsync directory)
+     * @param path Input: File to replace
+     * @param bytes Input: New file content
+     * @return bool: True if the new content is durably in place
+     */
+    static bool replaceFile(const std::string& path, const std::string& bytes);
+
+    /**
+     * @brief Append to a file and fsync it
+     * @param path Input: File to append to, created if missing
+     * @param bytes Input: Data to append
+     * @return bool: True if the data is durably appended
+     */
+    static bool appendFile(const std::string& path, const std::string& bytes);
+
+    /**
+     * @brief Overwrite parts of a file in place, fdatasync'ing after each part
+     * @param path Input: File to write, created if missing
+     * @param pieces Input: (offset, bytes) parts, written in order
+     * @return bool: True if every part is durably written; parts after a failed one are skipped
+     */
+    static bool writeFileAt(const std::string& path, const std::vector<std::pair<uint64_t, std::string> >& pieces);
+
+public:
+    SaveWriter();
+    ~SaveWriter();
+
+    /**
+     * @brief Queue a crash-safe replacement of a whole file
+     * @param path Input: File to replace
+     * @param bytes Input: New file content
+     * @return std::future<bool>: True once the file is written, false if writing failed
+     */
+    std::future<bool> replace(const std::string& path, std::string bytes);
+
+    /**
+     * @brief Queue an append to a file
+     * @param path Input: File to append to
+     * @param bytes Input: Data to append
+     * @return std::future<bool>: True once the data is written, false if writing failed
+     */
+    std::future<bool> append(const std::string& path, std::string bytes);
+
+    /**
+     * @brief Queue in-place writes of a file
+     * @details Each part is durable before the next one starts, and a failed part stops the rest,
+     *          so a part that commits earlier ones (such as an index) is only written after them.
+     *          The parts themselves are not atomic.
+     * @param path Input: File to write
+     * @param pieces Input: (offset, bytes) parts, moved into the job
+     * @return std::future<bool>: True once every part is written, false if writing failed
+     */
+    std::future<bool> writeAt(const std::string& path, std::vector<std::pair<uint64_t, std::string> > pieces);
+
+    /**
+     * @brief Wait until every write queued so far has finished
+     * @return void
+     */
+    void flush();
+
+    /**
+     * @brief Check whether a write failed since the last call, and clear the flag
+     * @return bool: True if some write failed
+     */
+    bool takeFailure();
+};
+
+#endif
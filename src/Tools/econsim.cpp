@@ -0,0 +1,245 @@
+// econsim.cpp - Headless multi-night economy simulator
+//
+// Plays the night economy without the game loop: every night a simulated survivor
+// scavenges a few items, sells them with the trade planner, pays the daily fee and
+// the market grows. Runs are spread over all cores and the report shows throughput,
+// bankruptcy days per difficulty and heap allocations per night.
+//
+// Usage: econsim [--runs N] [--nights N] [--threads N] [--fee N] [--growth R] [--seed N]
+#include "../Night/Customer.h"
+#include "../Night/Market.h"
+#include "../Night/TradePlanner.h"
+#include "../Item/itemdatabase.h"
+#include "../Core/Config.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef DAILY_FEE
+#define DAILY_FEE 10  // Default daily fee if not defined in Config.h
+#endif
+
+using namespace std;
+
+// Every heap allocation in the process goes through these, so the simulator can count
+// allocations per night. The counter is per thread to keep the threads independent.
+static thread_local unsigned long long allocationCount = 0;
+
+void *operator new(size_t size) {
+    allocationCount++;
+    void *memory = malloc(size ? size : 1);
+    if (!memory) throw bad_alloc();
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+namespace {
+struct SimSettings {
+    int runs;            // Runs per difficulty
+    int nights;          // Nights per run before it counts as survived
+    int threads;
+    int fee;             // Daily fee
+    float growth;        // Demand growth override, 0 uses the difficulty's rate
+    unsigned int seed;   // Base seed, run i uses seed + i
+};
+
+struct RunResult {
+    int difficulty;
+    int bankruptDay;     // Night the fee could not be paid, 0 if the run survived
+    int nights;          // Nights simulated
+    unsigned long long allocations;
+};
+
+// Gets the starting money of a difficulty
+// What it does: Returns STARTING_MONEY from the difficulty's config
+// Inputs: difficulty - One of the DIFFICULTY_* values
+// Outputs: int - Starting money
+int startingMoney(int difficulty) {
+    switch (difficulty) {
+        case DIFFICULTY_EASY: return EasyConfig::STARTING_MONEY;
+        case DIFFICULTY_HARD: return HardConfig::STARTING_MONEY;
+        default: return NormalConfig::STARTING_MONEY;
+    }
+}
+
+// Gets the display name of a difficulty
+// What it does: Maps a difficulty value to its name
+// Inputs: difficulty - One of the DIFFICULTY_* values
+// Outputs: const char* - Name of the difficulty
+const char *difficultyName(int difficulty) {
+    switch (difficulty) {
+        case DIFFICULTY_EASY: return "Easy";
+        case DIFFICULTY_HARD: return "Hard";
+        default: return "Normal";
+    }
+}
+
+// Simulates one survivor until bankruptcy or the night limit
+// What it does: Each night the survivor finds 1-4 items the customers may want, the night's
+//               customers are generated, the trade planner picks the best sales, the fee is paid
+//               and demand grows
+// Inputs: settings - Simulation settings
+//         difficulty - Difficulty of the run
+//         seed - Seed of the run's customer generator
+// Outputs: RunResult - Bankruptcy day, nights simulated and allocations made
+RunResult simulateRun(const SimSettings &settings, int difficulty, unsigned int seed) {
+    RunResult result;
+    result.difficulty = difficulty;
+    result.bankruptDay = 0;
+    result.nights = 0;
+    unsigned long long allocationsBefore = allocationCount;
+
+    Market market;
+    market.getCustomerRng() = CustomerRng(seed);
+    CustomerRng &rng = market.getCustomerRng();
+
+    int money = startingMoney(difficulty);
+    map<string, int> stock;
+    const int itemCount = getDesiredItemCount();
+
+    for (int night = 1; night <= settings.nights; night++) {
+        // Day: scavenge a few sellable items
+        int found = rng.range(1, 4);
+        for (int i = 0; i < found; i++) {
+            stock[getDesiredItemName(rng.range(0, itemCount - 1))]++;
+        }
+
+        // Night: serve the most profitable customers
+        vector<Customer> customers = generateCustomers(market.getTrends(), rng);
+        TradePlan plan = planTrades(customers, stock);
+        for (int index : plan.customers) {
+            stock[customers[index].desired_item] -= customers[index].desired_quantity;
+        }
+        money += plan.revenue;
+        market.recordTrade(plan.itemsSold, plan.revenue);
+
+        // End of night: fee and demand growth
+        result.nights = night;
+        if (money < settings.fee) {
+            result.bankruptDay = night;
+            break;
+        }
+        money -= settings.fee;
+        market.closeDay(night);
+        if (settings.growth > 0.0f) {
+            market.setTrends(market.getTrends().projected(settings.growth, 1));
+        } else {
+            market.updateTrends(difficulty);
+        }
+    }
+
+    result.allocations = allocationCount - allocationsBefore;
+    return result;
+}
+
+// Reads an integer option value
+// What it does: Parses argv[index + 1] if present
+// Inputs: argc, argv - Program arguments
+//         index - Index of the option name
+//         value - Receives the parsed value
+// Outputs: bool - True if a value was parsed
+bool readOption(int argc, char *argv[], int index, int &value) {
+    if (index + 1 >= argc) return false;
+    value = atoi(argv[index + 1]);
+    return true;
+}
+}
+
+int main(int argc, char *argv[]) {
+    SimSettings settings;
+    settings.runs = 2000;
+    settings.nights = 1000;
+    settings.threads = static_cast<int>(thread::hardware_concurrency());
+    settings.fee = DAILY_FEE;
+    settings.growth = 0.0f;
+    settings.seed = 12345;
+
+    for (int i = 1; i < argc; i++) {
+        int value = 0;
+        string option = argv[i];
+        if (option == "--runs" && readOption(argc, argv, i, value)) settings.runs = value;
+        else if (option == "--nights" && readOption(argc, argv, i, value)) settings.nights = value;
+        else if (option == "--threads" && readOption(argc, argv, i, value)) settings.threads = value;
+        else if (option == "--fee" && readOption(argc, argv, i, value)) settings.fee = value;
+        else if (option == "--seed" && readOption(argc, argv, i, value)) settings.seed = static_cast<unsigned int>(value);
+        else if (option == "--growth" && i + 1 < argc) settings.growth = static_cast<float>(atof(argv[i + 1]));
+        else {
+            cerr << "Usage: econsim [--runs N] [--nights N] [--threads N] [--fee N] [--growth R] [--seed N]" << endl;
+            return 1;
+        }
+        i++;
+    }
+    settings.threads = max(1, settings.threads);
+    settings.runs = max(1, settings.runs);
+    settings.nights = max(1, settings.nights);
+
+    // The prototype table is shared read-only by every thread
+    initItemDatabase();
+
+    const int totalRuns = settings.runs * DIFFICULTY_COUNT;
+    vector<RunResult> results(totalRuns);
+    atomic<int> nextRun(0);
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int t = 0; t < settings.threads; t++) {
+        workers.push_back(thread([&]() {
+            for (int run = nextRun++; run < totalRuns; run = nextRun++) {
+                int difficulty = run % DIFFICULTY_COUNT;
+                results[run] = simulateRun(settings, difficulty, settings.seed + static_cast<unsigned int>(run));
+            }
+        }));
+    }
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    unsigned long long totalNights = 0;
+    unsigned long long totalAllocations = 0;
+    for (const RunResult &result : results) {
+        totalNights += result.nights;
+        totalAllocations += result.allocations;
+    }
+
+    printf("Economy simulation: %d runs x %d difficulties, up to %d nights, %d threads\n",
+           settings.runs, DIFFICULTY_COUNT, settings.nights, settings.threads);
+    if (settings.growth > 0.0f) printf("Daily fee %d, growth %.3f per night\n", settings.fee, settings.growth);
+    else printf("Daily fee %d, growth per difficulty\n", settings.fee);
+    printf("%llu nights in %.3f s: %.0f nights/sec\n", totalNights, seconds,
+           seconds > 0.0 ? totalNights / seconds : 0.0);
+    printf("Allocations per night: %.1f\n\n",
+           totalNights > 0 ? static_cast<double>(totalAllocations) / totalNights : 0.0);
+
+    printf("%-8s %9s %9s %9s %9s %9s\n", "", "bankrupt", "p10 day", "median", "p90 day", "mean");
+    for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; difficulty++) {
+        vector<int> days;
+        for (const RunResult &result : results) {
+            if (result.difficulty == difficulty && result.bankruptDay > 0) {
+                days.push_back(result.bankruptDay);
+            }
+        }
+        sort(days.begin(), days.end());
+        double share = 100.0 * days.size() / settings.runs;
+        if (days.empty()) {
+            printf("%-8s %8.1f%% %9s %9s %9s %9s\n", difficultyName(difficulty), share, "-", "-", "-", "-");
+            continue;
+        }
+        double sum = 0.0;
+        for (int day : days) sum += day;
+        printf("%-8s %8.1f%% %9d %9d %9d %9.1f\n", difficultyName(difficulty), share,
+               days[days.size() / 10], days[days.size() / 2], days[days.size() * 9 / 10], sum / days.size());
+    }
+    return 0;
+}
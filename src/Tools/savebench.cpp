@@ -0,0 +1,266 @@
+// savebench.cpp - Save/load benchmark
+//
+// Builds synthetic games from an empty to a very large inventory, saves and loads each
+// one repeatedly through SaveSystem::saveGame()/loadGame() in a scratch directory, and
+// reports latency percentiles, throughput, bytes on disk and heap allocations per call.
+// A save is timed until its write is on disk, so it includes the fsync.
+//
+// Usage: savebench [--iterations N] [--history N] [--dir PATH] [--no-compress] [--seed N]
+#include "../Save/SaveSystem.h"
+#include "../Night/Market.h"
+#include "../Map/Map.h"
+#include "../Item/itemdatabase.h"
+#include "../Core/GameSession.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+// Every heap allocation in the process goes through these, so the benchmark can count
+// allocations per save and load. Saves also allocate on the writer thread, so the counter
+// is shared by all threads.
+static atomic<unsigned long long> allocationCount(0);
+
+void *operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    void *memory = malloc(size ? size : 1);
+    if (!memory) throw bad_alloc();
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+namespace {
+struct BenchSettings {
+    int iterations;      // Saves and loads per inventory size
+    int history;         // Nights of market history in every game
+    string directory;    // Where the scratch directory is created
+    bool compress;
+    unsigned int seed;
+};
+
+struct Workload {
+    const char *name;
+    int items;
+};
+
+// Inventory sizes, from a fresh game to the most a save may hold when loaded
+const Workload WORKLOADS[] = {
+    { "tiny", 0 },
+    { "small", 20 },
+    { "medium", 500 },
+    { "large", 10000 },
+    { "huge", 100000 },
+};
+
+struct Measurement {
+    vector<double> saveMs;
+    vector<double> loadMs;
+    unsigned long long saveAllocations;
+    unsigned long long loadAllocations;
+    long long fileBytes;
+};
+
+// Builds a synthetic game
+// What it does: Fills the player's inventory with random prototypes (every tenth item worn),
+//               gives it a combat player, plays the market for the given number of nights and
+//               generates the day's map
+// Inputs: items - Inventory size
+//         settings - Benchmark settings
+//         player, market, dailyMap - Receive the game
+// Outputs: None
+void buildGame(int items, const BenchSettings &settings, Player &player, Market &market, Map &dailyMap) {
+    mt19937 rng(settings.seed + static_cast<unsigned int>(items));
+    vector<int> prototypes;
+    for (int id = 0; getItemPrototype(id) != nullptr; id++) {
+        prototypes.push_back(id);
+    }
+
+    player.clearInventory();
+    player.hp = 80;
+    player.stamina = 40;
+    player.money = 1234;
+    player.initializeCombatPlayer("Bench");
+    for (int i = 0; i < items; i++) {
+        Item *item = createItemFromPrototype(prototypes[rng() % prototypes.size()]);
+        if (i % 10 == 9 && item->durability > 0) {
+            item->durability--;
+        }
+        player.addItem(item);
+    }
+
+    for (int night = 1; night <= settings.history; night++) {
+        market.recordTrade(static_cast<int>(rng() % 20), static_cast<int>(rng() % 500));
+        market.closeDay(night);
+        market.updateTrends(DIFFICULTY_NORMAL);
+    }
+    dailyMap.generateDailyMap(settings.history + 1);
+}
+
+// Gets a percentile of sorted samples
+// Inputs: sorted - Samples in ascending order, not empty
+//         percent - Percentile, 0-100
+// Outputs: double - The sample at that rank
+double percentile(const vector<double> &sorted, int percent) {
+    size_t rank = sorted.size() * percent / 100;
+    return sorted[min(rank, sorted.size() - 1)];
+}
+
+// Gets the mean of samples
+double mean(const vector<double> &samples) {
+    double sum = 0.0;
+    for (double sample : samples) sum += sample;
+    return samples.empty() ? 0.0 : sum / samples.size();
+}
+
+// Benchmarks one inventory size
+// What it does: Saves the game and loads it into a fresh player, market and map, the given
+//               number of times, timing each call and counting its allocations
+// Inputs: items - Inventory size
+//         settings - Benchmark settings
+//         savePath - Save file of the scratch directory
+// Outputs: Measurement - Latencies, allocations and file size
+Measurement runWorkload(int items, const BenchSettings &settings, const string &savePath) {
+    Player player;
+    Market market;
+    Map dailyMap;
+    buildGame(items, settings, player, market, dailyMap);
+    const int day = settings.history + 1;
+
+    Measurement result;
+    result.saveAllocations = 0;
+    result.loadAllocations = 0;
+    result.fileBytes = 0;
+    for (int i = 0; i < settings.iterations; i++) {
+        unsigned long long before = allocationCount.load();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        bool saved = SaveSystem::saveGame(player, day, &market, &dailyMap).get();
+        result.saveMs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        result.saveAllocations += allocationCount.load() - before;
+        if (!saved) {
+            cerr << "Save failed in " << savePath << endl;
+            exit(1);
+        }
+
+        Player loadedPlayer;
+        Market loadedMarket;
+        Map loadedMap;
+        int loadedDay = 0;
+        before = allocationCount.load();
+        start = chrono::steady_clock::now();
+        bool loaded = SaveSystem::loadGame(loadedPlayer, loadedDay, &loadedMarket, &loadedMap);
+        result.loadMs.push_back(chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        result.loadAllocations += allocationCount.load() - before;
+        if (!loaded || loadedDay != day ||
+            static_cast<const Player &>(loadedPlayer).getInventory().size() != static_cast<size_t>(items)) {
+            cerr << "Load did not return the saved game" << endl;
+            exit(1);
+        }
+    }
+
+    struct stat info;
+    if (stat(savePath.c_str(), &info) == 0) {
+        result.fileBytes = static_cast<long long>(info.st_size);
+    }
+    sort(result.saveMs.begin(), result.saveMs.end());
+    sort(result.loadMs.begin(), result.loadMs.end());
+    return result;
+}
+
+// Reads an integer option value
+// What it does: Parses argv[index + 1] if present
+// Inputs: argc, argv - Program arguments
+//         index - Index of the option name
+//         value - Receives the parsed value
+// Outputs: bool - True if a value was parsed
+bool readOption(int argc, char *argv[], int index, int &value) {
+    if (index + 1 >= argc) return false;
+    value = atoi(argv[index + 1]);
+    return true;
+}
+}
+
+int main(int argc, char *argv[]) {
+    BenchSettings settings;
+    settings.iterations = 30;
+    settings.history = 365;
+    settings.directory = "/tmp";
+    settings.compress = true;
+    settings.seed = 12345;
+
+    for (int i = 1; i < argc; i++) {
+        int value = 0;
+        string option = argv[i];
+        if (option == "--no-compress") { settings.compress = false; continue; }
+        if (option == "--iterations" && readOption(argc, argv, i, value)) settings.iterations = value;
+        else if (option == "--history" && readOption(argc, argv, i, value)) settings.history = value;
+        else if (option == "--seed" && readOption(argc, argv, i, value)) settings.seed = static_cast<unsigned int>(value);
+        else if (option == "--dir" && i + 1 < argc) settings.directory = argv[i + 1];
+        else {
+            cerr << "Usage: savebench [--iterations N] [--history N] [--dir PATH] [--no-compress] [--seed N]" << endl;
+            return 1;
+        }
+        i++;
+    }
+    settings.iterations = max(1, settings.iterations);
+    settings.history = max(0, settings.history);
+
+    // Never touch the player's own save: everything goes to a fresh directory
+    string scratch = settings.directory + "/savebench-XXXXXX";
+    if (!mkdtemp(&scratch[0])) {
+        cerr << "Cannot create a directory in " << settings.directory << endl;
+        return 1;
+    }
+    // Keep SaveSystem's messages out of the report
+    ScriptInputSource noKeys("");
+    NullFrontend quiet(noKeys);
+    GameSession session(&quiet);
+    GameSession::bind(&session);
+
+    const string basePath = scratch + "/bench";
+    SaveSystem::setSavePath(basePath);
+    SaveSystem::setCompression(settings.compress);
+    initItemDatabase();
+
+    printf("Save/load benchmark: %d iterations per size, %d nights of market history, compression %s\n",
+           settings.iterations, settings.history, settings.compress ? "on" : "off");
+    printf("Saves are timed until the file is synced to %s\n\n", scratch.c_str());
+    printf("%-7s %7s %10s | %8s %8s %8s %8s %9s %8s | %8s %8s %8s %8s %9s %8s\n", "", "items", "bytes",
+           "save p50", "p90", "p99", "max", "MB/s", "allocs", "load p50", "p90", "p99", "max", "MB/s", "allocs");
+
+    for (const Workload &workload : WORKLOADS) {
+        Measurement result = runWorkload(workload.items, settings, basePath + ".dat");
+
+        double megabytes = result.fileBytes / 1e6;
+        double saveMean = mean(result.saveMs);
+        double loadMean = mean(result.loadMs);
+        printf("%-7s %7d %10lld | %8.3f %8.3f %8.3f %8.3f %9.1f %8llu | %8.3f %8.3f %8.3f %8.3f %9.1f %8llu\n",
+               workload.name, workload.items, result.fileBytes,
+               percentile(result.saveMs, 50), percentile(result.saveMs, 90), percentile(result.saveMs, 99),
+               result.saveMs.back(), saveMean > 0.0 ? megabytes / (saveMean / 1000.0) : 0.0,
+               result.saveAllocations / settings.iterations,
+               percentile(result.loadMs, 50), percentile(result.loadMs, 90), percentile(result.loadMs, 99),
+               result.loadMs.back(), loadMean > 0.0 ? megabytes / (loadMean / 1000.0) : 0.0,
+               result.loadAllocations / settings.iterations);
+        fflush(stdout);
+    }
+    printf("\nLatencies in ms; allocations per call, all threads\n");
+
+    SaveSystem::deleteSave();
+    GameSession::bind(nullptr);
+    remove((basePath + ".slots").c_str());
+    rmdir(scratch.c_str());
+    return 0;
+}
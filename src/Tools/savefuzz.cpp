@@ -0,0 +1,409 @@
+// savefuzz.cpp - Fuzzing harness for the save file readers
+//
+// LLVMFuzzerTestOneInput() hands one input to the save readers. Its first byte picks the
+// reader and the rest is the data:
+//   0 - SaveSystem::restoreSnapshot() on a version 3 snapshot. Magic, version and every CRC32C
+//       are repaired first, so mutations reach the section parsers instead of the checksums.
+//       A snapshot that loads must also survive captureSnapshot() and load again.
+//   1 - SaveSystem::loadGame() with the data as the save file and no journal: flat version 1-2
+//       files and snapshots with their checksums as they are.
+//   2 - SaveSystem::loadGame() of a valid save with the data as its journal, bound to that save
+//       and with every record hash repaired.
+//
+// With libFuzzer (clang) the harness builds without its own main(), as one command:
+//   clang++ -std=c++11 -g -O1 -fsanitize=fuzzer,address,undefined -DSAVEFUZZ_LIBFUZZER -pthread
+//       -Isrc/Core -Isrc/Player -Isrc/Map -Isrc/Combat -Isrc/Night -Isrc/Item -Isrc/Save
+//       src/Tools/savefuzz.cpp <every game source but src/Core/main.cpp> -o savefuzz-libfuzzer
+//   ./savefuzz-libfuzzer corpus/   (seed corpus/ with: bin/savefuzz --write-seeds corpus)
+//
+// bin/savefuzz (g++) carries a simple mutating driver instead, and replays files given to it.
+//
+// Usage: savefuzz [--rounds N] [--seed N] [--write-seeds DIR] [FILE...]
+#include "../Save/SaveSystem.h"
+#include "../Save/SaveCodec.h"
+#include "../Night/Market.h"
+#include "../Map/Map.h"
+#include "../Item/itemdatabase.h"
+#include "../Core/GameSession.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+namespace {
+enum FuzzTarget {
+    TARGET_SNAPSHOT = 0,
+    TARGET_SAVE_FILE = 1,
+    TARGET_JOURNAL = 2,
+    TARGET_COUNT = 3
+};
+
+// Layout of the formats, as far as the checksum repair needs it (see SaveSystem.cpp)
+const size_t SNAPSHOT_HEADER_SIZE = 8 + 4 + 4;   // Magic, version, section count
+const size_t SECTION_ENTRY_SIZE = 4 + 1 + 4 + 4 + 4;  // Id, flags, stored size, raw size, CRC
+const uint32_t SNAPSHOT_MAX_SECTIONS = 64;
+const int32_t SNAPSHOT_VERSION = 3;
+const size_t JOURNAL_HEADER_SIZE = 8 + sizeof(int) + sizeof(unsigned int);
+const int JOURNAL_VERSION = 1;
+const int JOURNAL_ITEM = 5;
+
+struct Harness {
+    ScriptInputSource noKeys;
+    NullFrontend quiet;     // Keeps SaveSystem's messages out of the output
+    GameSession session;    // Plays on quiet; bound for good
+    string basePath;
+    string validSave;       // Save file every journal input is bound to
+    vector<string> seeds;   // Seed inputs, target byte included
+
+    Harness() : noKeys(""), quiet(noKeys), session(&quiet) {}
+};
+
+// Hashes bytes the way the journal does (32-bit FNV-1a)
+unsigned int fnv1a(const char* data, size_t size) {
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void putU32(string& bytes, size_t pos, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        bytes[pos + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+uint32_t getU32(const string& bytes, size_t pos) {
+    uint32_t value = 0;
+    for (int i = 3; i >= 0; i--) {
+        value = (value << 8) | static_cast<unsigned char>(bytes[pos + i]);
+    }
+    return value;
+}
+
+// Reads a whole file, empty if it cannot be read
+string readFile(const string& path) {
+    ifstream file(path, ios::binary);
+    ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+void writeFile(const string& path, const string& bytes) {
+    ofstream file(path, ios::binary | ios::trunc);
+    file.write(bytes.data(), static_cast<streamsize>(bytes.size()));
+}
+
+// Repairs a snapshot's header and checksums
+// What it does: Sets magic and version, recomputes the CRC of every section that lies inside
+//               the data, then the CRC of the section table
+// Inputs: snapshot - Snapshot bytes, changed in place
+// Outputs: None
+void repairSnapshot(string& snapshot) {
+    if (snapshot.size() < SNAPSHOT_HEADER_SIZE) return;
+    snapshot.replace(0, 8, "SAVEGAME");
+    putU32(snapshot, 8, static_cast<uint32_t>(SNAPSHOT_VERSION));
+    uint32_t count = getU32(snapshot, 12);
+    size_t tableEnd = SNAPSHOT_HEADER_SIZE + static_cast<size_t>(count) * SECTION_ENTRY_SIZE;
+    if (count > SNAPSHOT_MAX_SECTIONS || snapshot.size() < tableEnd + 4) return;
+
+    size_t offset = tableEnd + 4;
+    for (uint32_t i = 0; i < count; i++) {
+        size_t entry = SNAPSHOT_HEADER_SIZE + i * SECTION_ENTRY_SIZE;
+        uint32_t storedSize = getU32(snapshot, entry + 5);
+        if (storedSize > snapshot.size() - offset) break;
+        putU32(snapshot, entry + 13, SaveCodec::crc32c(snapshot.data() + offset, storedSize));
+        offset += storedSize;
+    }
+    putU32(snapshot, tableEnd, SaveCodec::crc32c(snapshot.data(), tableEnd));
+}
+
+// Binds a journal to a save and repairs its record hashes
+// What it does: Sets the header, then walks the records and rewrites each one's hash, up to the
+//               first record that is cut short or has an unknown type
+// Inputs: journal - Journal bytes, changed in place
+//         save - Save file the journal applies to
+// Outputs: None
+void repairJournal(string& journal, const string& save) {
+    if (journal.size() < JOURNAL_HEADER_SIZE) return;
+    int version = JOURNAL_VERSION;
+    unsigned int bound = fnv1a(save.data(), save.size());
+    journal.replace(0, 8, "SAVEJRNL");
+    journal.replace(8, sizeof(version), reinterpret_cast<const char*>(&version), sizeof(version));
+    journal.replace(8 + sizeof(version), sizeof(bound), reinterpret_cast<const char*>(&bound), sizeof(bound));
+
+    size_t pos = JOURNAL_HEADER_SIZE;
+    while (pos < journal.size()) {
+        size_t start = pos;
+        int type = static_cast<unsigned char>(journal[pos++]);
+        if (type < 1 || type > JOURNAL_ITEM) return;
+        if (type == JOURNAL_ITEM) {
+            int nameLen = 0;
+            if (journal.size() - pos < sizeof(nameLen)) return;
+            memcpy(&nameLen, journal.data() + pos, sizeof(nameLen));
+            pos += sizeof(nameLen);
+            if (nameLen <= 0 || nameLen > 256 || journal.size() - pos < static_cast<size_t>(nameLen)) return;
+            pos += nameLen;
+        }
+        if (journal.size() - pos < 2 * sizeof(int)) return;
+        pos += sizeof(int);
+        unsigned int hash = fnv1a(journal.data() + start, pos - start);
+        journal.replace(pos, sizeof(hash), reinterpret_cast<const char*>(&hash), sizeof(hash));
+        pos += sizeof(hash);
+    }
+}
+
+// Builds a flat version 2 save file
+// What it does: Writes day, stats, a two-item inventory and no market in the old native layout
+// Inputs: None
+// Outputs: string - File content
+string flatSave() {
+    string file("SAVEGAME", 8);
+    const int fields[] = { 2, 7, 90, 45, 300, 2 };  // Version, day, HP, stamina, money, distinct items
+    file.append(reinterpret_cast<const char*>(fields), sizeof(fields));
+    const char* names[] = { "Rag", "Bullet" };
+    for (const char* name : names) {
+        int nameLen = static_cast<int>(strlen(name));
+        int count = 3;
+        file.append(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
+        file.append(name, nameLen);
+        file.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    int hasMarket = 0;
+    file.append(reinterpret_cast<const char*>(&hasMarket), sizeof(hasMarket));
+    return file;
+}
+
+// Sets up the harness once
+// What it does: Loads the item database, moves the save files into a scratch directory, writes
+//               a small game with saveGame() and journalGame() and keeps its files as seeds
+// Inputs: None
+// Outputs: Harness& - Shared harness state
+Harness& harness() {
+    static Harness* state = nullptr;
+    if (state) return *state;
+    state = new Harness();
+
+    GameSession::bind(&state->session);
+    initItemDatabase();
+    char scratch[] = "/tmp/savefuzz-XXXXXX";
+    if (!mkdtemp(scratch)) {
+        cerr << "Cannot create a scratch directory in /tmp" << endl;
+        exit(1);
+    }
+    state->basePath = string(scratch) + "/fuzz";
+    SaveSystem::setSavePath(state->basePath);
+
+    Player player;
+    Market market;
+    Map dailyMap;
+    player.initializeCombatPlayer("Fuzz");
+    player.addItems(1, 3);
+    player.addItems(12, 1);
+    for (int night = 1; night <= 5; night++) {
+        market.recordTrade(night, night * 10);
+        market.closeDay(night);
+    }
+    dailyMap.generateDailyMap(6);
+    string snapshot = SaveSystem::captureSnapshot(player, 6, &market, &dailyMap);
+    SaveSystem::saveGame(player, 6, &market, &dailyMap).get();
+    state->validSave = readFile(state->basePath + ".dat");
+
+    player.hp -= 10;
+    player.money += 25;
+    player.addItems(13, 4);
+    SaveSystem::journalGame(player, 7, &market, &dailyMap);
+    SaveSystem::setSavePath(state->basePath);  // Waits for the journal write
+    string journal = readFile(state->basePath + ".journal");
+
+    state->seeds.push_back(string(1, TARGET_SNAPSHOT) + snapshot);
+    state->seeds.push_back(string(1, TARGET_SNAPSHOT) + state->validSave);
+    state->seeds.push_back(string(1, TARGET_SAVE_FILE) + state->validSave);
+    state->seeds.push_back(string(1, TARGET_SAVE_FILE) + flatSave());
+    state->seeds.push_back(string(1, TARGET_JOURNAL) + journal);
+    return *state;
+}
+
+// Runs one input
+// What it does: See the top of the file
+// Inputs: data, size - Fuzz input; the first byte picks the reader
+// Outputs: bool - True if the reader accepted the data
+bool runInput(const uint8_t* data, size_t size) {
+    Harness& state = harness();
+    if (size == 0) return false;
+    string bytes(reinterpret_cast<const char*>(data) + 1, size - 1);
+    Player player;
+    Market market;
+    Map dailyMap;
+    int day = 0;
+
+    switch (data[0] % TARGET_COUNT) {
+        case TARGET_SNAPSHOT: {
+            repairSnapshot(bytes);
+            if (!SaveSystem::restoreSnapshot(bytes, player, day, &market, &dailyMap)) return false;
+            // Whatever loads must save and load again
+            string again = SaveSystem::captureSnapshot(player, day, &market, &dailyMap);
+            Player reloaded;
+            Market reloadedMarket;
+            Map reloadedMap;
+            int reloadedDay = 0;
+            if (!SaveSystem::restoreSnapshot(again, reloaded, reloadedDay, &reloadedMarket, &reloadedMap) ||
+                reloadedDay != day) {
+                cerr << "Loaded snapshot does not survive a save" << endl;
+                abort();
+            }
+            return true;
+        }
+        case TARGET_SAVE_FILE:
+            SaveSystem::setSavePath(state.basePath);  // Lets the last load's journal rewrite land first
+            writeFile(state.basePath + ".dat", bytes);
+            remove((state.basePath + ".journal").c_str());
+            return SaveSystem::loadGame(player, day, &market, &dailyMap);
+        default:
+            SaveSystem::setSavePath(state.basePath);
+            repairJournal(bytes, state.validSave);
+            writeFile(state.basePath + ".dat", state.validSave);
+            writeFile(state.basePath + ".journal", bytes);
+            return SaveSystem::loadGame(player, day, &market, &dailyMap);
+    }
+}
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    runInput(data, size);
+    return 0;
+}
+
+#ifndef SAVEFUZZ_LIBFUZZER
+namespace {
+// Values that sit on the edges of the readers' checks
+const uint32_t INTERESTING[] = { 0, 1, 2, 15, 16, 64, 65, 255, 256, 257, 4096, 100000, 100001, 0xFFFF,
+                                 64u << 20, (64u << 20) + 1, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF };
+
+// Mutates an input
+// What it does: Applies one to eight random edits (bit flips, random bytes, edge values written
+//               over four bytes, inserted, erased or repeated ranges, truncation) after the target byte
+// Inputs: input - Input to mutate, changed in place
+//         rng - Random generator
+// Outputs: None
+void mutate(string& input, mt19937& rng) {
+    int edits = 1 + static_cast<int>(rng() % 8);
+    for (int e = 0; e < edits; e++) {
+        size_t size = input.size();
+        size_t pos = size > 1 ? 1 + rng() % (size - 1) : 1;
+        switch (rng() % 7) {
+            case 0:
+                if (pos < size) input[pos] = static_cast<char>(input[pos] ^ (1 << (rng() % 8)));
+                break;
+            case 1:
+                if (pos < size) input[pos] = static_cast<char>(rng());
+                break;
+            case 2:
+                if (pos + 4 <= size) {
+                    uint32_t value = INTERESTING[rng() % (sizeof(INTERESTING) / sizeof(INTERESTING[0]))];
+                    putU32(input, pos, value);
+                }
+                break;
+            case 3:
+                input.insert(pos, string(1 + rng() % 16, static_cast<char>(rng())));
+                break;
+            case 4:
+                if (pos < size) input.erase(pos, 1 + rng() % 16);
+                break;
+            case 5:
+                if (pos < size) {
+                    size_t length = min<size_t>(size - pos, 1 + rng() % 32);
+                    input.insert(pos, input.substr(pos, length));
+                }
+                break;
+            default:
+                if (pos < size) input.resize(pos);
+                break;
+        }
+    }
+}
+
+// Reads an integer option value
+// What it does: Parses argv[index + 1] if present
+// Inputs: argc, argv - Program arguments
+//         index - Index of the option name
+//         value - Receives the parsed value
+// Outputs: bool - True if a value was parsed
+bool readOption(int argc, char* argv[], int index, int& value) {
+    if (index + 1 >= argc) return false;
+    value = atoi(argv[index + 1]);
+    return true;
+}
+}
+
+int main(int argc, char* argv[]) {
+    int rounds = 20000;
+    unsigned int seed = 12345;
+    string seedDirectory;
+    vector<string> files;
+
+    for (int i = 1; i < argc; i++) {
+        int value = 0;
+        string option = argv[i];
+        if (option == "--rounds" && readOption(argc, argv, i, value)) rounds = value;
+        else if (option == "--seed" && readOption(argc, argv, i, value)) seed = static_cast<unsigned int>(value);
+        else if (option == "--write-seeds" && i + 1 < argc) seedDirectory = argv[i + 1];
+        else if (option.compare(0, 2, "--") != 0) { files.push_back(option); continue; }
+        else {
+            cerr << "Usage: savefuzz [--rounds N] [--seed N] [--write-seeds DIR] [FILE...]" << endl;
+            return 1;
+        }
+        i++;
+    }
+
+    Harness& state = harness();
+    if (!seedDirectory.empty()) {
+        for (size_t i = 0; i < state.seeds.size(); i++) {
+            writeFile(seedDirectory + "/seed-" + to_string(i), state.seeds[i]);
+        }
+        printf("Wrote %zu seeds to %s\n", state.seeds.size(), seedDirectory.c_str());
+        return 0;
+    }
+
+    // Replay given inputs, e.g. a crash libFuzzer found
+    if (!files.empty()) {
+        for (const string& path : files) {
+            string input = readFile(path);
+            bool loaded = runInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+            printf("%s: %s\n", path.c_str(), loaded ? "loaded" : "rejected");
+        }
+        return 0;
+    }
+
+    mt19937 rng(seed);
+    int tried[TARGET_COUNT] = { 0, 0, 0 };
+    int loaded[TARGET_COUNT] = { 0, 0, 0 };
+    for (int round = 0; round < rounds; round++) {
+        string input = state.seeds[rng() % state.seeds.size()];
+        mutate(input, rng);
+        int target = static_cast<unsigned char>(input[0]) % TARGET_COUNT;
+        tried[target]++;
+        if (runInput(reinterpret_cast<const uint8_t*>(input.data()), input.size())) loaded[target]++;
+    }
+
+    const char* names[TARGET_COUNT] = { "snapshot", "save file", "journal" };
+    printf("Save fuzzing: %d rounds, seed %u\n", rounds, seed);
+    for (int target = 0; target < TARGET_COUNT; target++) {
+        printf("%-10s %7d inputs, %7d loaded\n", names[target], tried[target], loaded[target]);
+    }
+    SaveSystem::deleteSave();
+    remove((state.basePath + ".slots").c_str());
+    rmdir(state.basePath.substr(0, state.basePath.find_last_of('/')).c_str());
+    return 0;
+}
+#endif